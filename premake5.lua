@@ -66,6 +66,7 @@ project "Stride"
         buildoptions { "/MP","/DEBUG:FULL","/utf-8" }
         buildoptions { "/MP","/DEBUG:FULL","/utf-8" }
         defines {"GL_DEBUG", "IMGUI_ENABLE_TEST_ENGINE", "IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL"}
+        defines {"STRIDE_COUNT_ALLOCATIONS"}
 
     filter {"configurations:Release"}
         runtime "Release"
@@ -5,6 +5,7 @@
 #include "Log.h"
 #include "managers/DragDropManager.h"
 #include "managers/BoardManager.h"
+#include "storage/PersistenceWorker.h"
 #include "Application.h"
 #include <csignal>
 #include <filesystem>
@@ -25,6 +26,8 @@
 #include "imgui_test_engine/imgui_te_engine.h"
 #include "imgui_test_engine/imgui_te_ui.h"
 #include "tests/Tests.h"
+#include "utilities/AllocationCounter.h"
+#include "utilities/FrameArena.h"
 
 
 #include "resources/JetBrainsMonoNLRegular.embed"
@@ -301,7 +304,14 @@ void Application::Render()
 {
     ImGui::ShowDemoWindow();
     // ImGuiTestEngine_ShowTestEngineWindows(Get().mTestEngine, nullptr);
+#ifdef STRIDE_COUNT_ALLOCATIONS
+    // Steady-state board rendering must not touch the heap
+    Stride::AllocationCounter::Scope allocations;
     BoardManager::Get().Render();
+    Stride::AllocationCounter::RecordFrame(allocations.Count());
+#else
+    BoardManager::Get().Render();
+#endif
 }
 
 void Application::PreRender()
@@ -309,6 +319,9 @@ void Application::PreRender()
     GLFWwindow* glfwWindowPtr = Application::GetGLFWwindow();
     bool tIsWindowFocused = glfwGetWindowAttrib(glfwWindowPtr, GLFW_FOCUSED) != 0;
 
+    // Transient UI data (drop zones, list bounds) of the previous frame is discarded here
+    Stride::FrameArena::Get().Reset();
+
     MultiThreading::ImageLoader::LoadImages();
     DebuggerWindow::EventListener(tIsWindowFocused);
 }
@@ -398,6 +411,11 @@ void Application::Draw()
 
 void Application::Destroy()
 {
+    // Queue any unsaved edits, then block until every queued write has been committed
+    BoardManager::Get().SaveActiveBoard();
+    BoardManager::Get().GetRepository().SaveSnapshot();
+    PersistenceWorker::Shutdown();
+
 #ifdef GL_BUILD_OPENGL2
     ImGui_ImplOpenGL2_Shutdown();
 #else
@@ -1,20 +1,20 @@
 #include "pch.h"
 #include "Card.h"
-#include "Utils.h"
+#include "utilities/MemoryUsage.h"
 #include <algorithm>
 
 namespace Stride
 {
     // ChecklistItem constructor
     ChecklistItem::ChecklistItem(std::string aText, bool checked)
-        : id(genUID()), text(std::move(aText)), isChecked(checked)
+        : id(ChecklistItemId::NewTransient()), text(std::move(aText)), isChecked(checked)
     {}
 
     // Card constructors
-    Card::Card() : id(genUID()) {}
+    Card::Card() : id(CardId::NewTransient()) {}
 
     Card::Card(std::string aTitle, std::string aDescription, std::vector<std::string> aBadges)
-        : id(genUID()),
+        : id(CardId::NewTransient()),
           title(std::move(aTitle)),
           description(std::move(aDescription)),
           badges(std::move(aBadges))
@@ -38,9 +38,13 @@ namespace Stride
     }
 
     // Checklist operations
-    void Card::AddChecklistItem(const std::string& text) { checklist.emplace_back(text, false); }
+    void Card::AddChecklistItem(const std::string& text)
+    {
+        checklist.emplace_back(text, false);
+        changes.Touch();
+    }
 
-    void Card::RemoveChecklistItem(const std::string& itemId)
+    void Card::RemoveChecklistItem(ChecklistItemId itemId)
     {
         checklist.erase(
             std::remove_if(
@@ -50,17 +54,20 @@ namespace Stride
             ),
             checklist.end()
         );
+        changes.Touch();
     }
 
-    void Card::ToggleChecklistItem(const std::string& itemId)
+    void Card::ToggleChecklistItem(ChecklistItemId itemId)
     {
         if(auto* item = FindChecklistItem(itemId))
         {
             item->isChecked = !item->isChecked;
+            item->changes.Touch();
+            changes.Touch();
         }
     }
 
-    ChecklistItem* Card::FindChecklistItem(const std::string& itemId)
+    ChecklistItem* Card::FindChecklistItem(ChecklistItemId itemId)
     {
         auto it = std::find_if(checklist.begin(), checklist.end(), [&](const ChecklistItem& item) {
             return item.id == itemId;
@@ -68,22 +75,58 @@ namespace Stride
         return it != checklist.end() ? &(*it) : nullptr;
     }
 
+    void Card::SetChecklist(std::vector<ChecklistItem> items)
+    {
+        for(auto& item : items)
+        {
+            const ChecklistItem* previous = FindChecklistItem(item.id);
+            if(!previous || previous->text != item.text || previous->isChecked != item.isChecked)
+            {
+                item.changes.Touch();
+            }
+        }
+        checklist = std::move(items);
+        changes.Touch();
+    }
+
     // Badge operations
     void Card::AddBadge(const std::string& badge)
     {
         if(!HasBadge(badge))
         {
             badges.push_back(badge);
+            changes.Touch();
         }
     }
 
     void Card::RemoveBadge(const std::string& badge)
     {
         badges.erase(std::remove(badges.begin(), badges.end(), badge), badges.end());
+        changes.Touch();
     }
 
     bool Card::HasBadge(const std::string& badge) const
     {
         return std::find(badges.begin(), badges.end(), badge) != badges.end();
     }
+
+    size_t Card::HeapBytes() const
+    {
+        size_t bytes = MemoryUsage::HeapBytes(title) + MemoryUsage::HeapBytes(description)
+                       + MemoryUsage::HeapBytes(coverImage) + MemoryUsage::HeapBytes(badges)
+                       + MemoryUsage::HeapBytes(checklist);
+        for(const auto& item : checklist)
+        {
+            bytes += MemoryUsage::HeapBytes(item.text);
+        }
+        return bytes;
+    }
+
+    bool Card::HasUnsavedChanges() const
+    {
+        return changes.IsDirty()
+               || std::any_of(checklist.begin(), checklist.end(), [](const ChecklistItem& item) {
+                      return item.changes.IsDirty();
+                  });
+    }
 }
@@ -1,14 +1,54 @@
 #pragma once
+#include "EntityId.h"
 #include <string>
 #include <vector>
+#include <cstdint>
 
 namespace Stride
 {
+    /**
+     * @brief Per-entity change counter used for incremental persistence.
+     *
+     * Mutations call Touch(); the storage adapter queues a write of every entity whose
+     * revision moved past the last queued one and calls MarkQueued(). The entity only stops
+     * being dirty once that write has committed (MarkCommitted); a dropped write makes the
+     * next save queue it again (MarkDropped). Freshly constructed entities start dirty so
+     * they get inserted.
+     */
+    struct ChangeTracker
+    {
+        uint32_t revision = 1;
+        uint32_t queuedRevision = 0; // Handed to the persistence worker
+        uint32_t savedRevision = 0;  // Committed to the database
+
+        void Touch() { ++revision; }
+        bool IsDirty() const { return revision != savedRevision; }
+        bool NeedsWrite() const { return revision != queuedRevision; }
+        void MarkQueued() { queuedRevision = revision; }
+        void MarkClean() { queuedRevision = savedRevision = revision; } // Matches the stored row
+
+        void MarkCommitted(uint32_t written)
+        {
+            // Results arrive in order; one from before a reload is older than the row itself
+            if(static_cast<int32_t>(written - savedRevision) > 0
+               && static_cast<int32_t>(revision - written) >= 0)
+                savedRevision = written;
+        }
+
+        void MarkDropped(uint32_t written)
+        {
+            // A newer write still in flight supersedes the dropped one
+            if(queuedRevision == written)
+                queuedRevision = savedRevision;
+        }
+    };
+
     struct ChecklistItem
     {
-        std::string id;
+        ChecklistItemId id;
         std::string text;
         bool isChecked = false;
+        ChangeTracker changes;
 
         ChecklistItem() = default;
         ChecklistItem(std::string aText, bool checked = false);
@@ -17,13 +57,13 @@ namespace Stride
     struct Card
     {
         // Identity
-        std::string id;
+        CardId id;
 
         // Content
         std::string title;
         std::string description;
 
-        int position;
+        double position = 0.0; // Fractional rank within the list
         std::string coverImage;
         time_t dueDate;
         bool isCompleted;
@@ -31,6 +71,7 @@ namespace Stride
         // Metadata
         std::vector<std::string> badges;
         std::vector<ChecklistItem> checklist;
+        ChangeTracker changes;
 
         // Constructors
         Card();
@@ -50,13 +91,20 @@ namespace Stride
 
         // Checklist operations
         void AddChecklistItem(const std::string& text);
-        void RemoveChecklistItem(const std::string& itemId);
-        void ToggleChecklistItem(const std::string& itemId);
-        ChecklistItem* FindChecklistItem(const std::string& itemId);
+        void RemoveChecklistItem(ChecklistItemId itemId);
+        void ToggleChecklistItem(ChecklistItemId itemId);
+        ChecklistItem* FindChecklistItem(ChecklistItemId itemId);
+        void SetChecklist(std::vector<ChecklistItem> items); // Touches items that changed
 
         // Badge operations
         void AddBadge(const std::string& badge);
         void RemoveBadge(const std::string& badge);
         bool HasBadge(const std::string& badge) const;
+
+        // Heap memory owned by the card (strings, badges, checklist); excludes sizeof(Card)
+        size_t HeapBytes() const;
+
+        // Unsaved edits on the card or any of its checklist items
+        bool HasUnsavedChanges() const;
     };
 }
@@ -1,41 +1,162 @@
 #include "pch.h"
 #include "CardList.h"
-#include "Utils.h"
+#include "utilities/FractionalRank.h"
+#include "utilities/MemoryUsage.h"
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 
 namespace Stride
 {
+    namespace
+    {
+        // Lists are built on the persistence thread while loading
+        std::atomic<uint32_t> sLayoutClock{ 0 };
+
+        uint32_t NextLayoutVersion() { return ++sLayoutClock; }
+    }
+
     // CardList constructors
-    CardList::CardList() : id(genUID()) {}
+    CardList::CardList() : id(ListId::NewTransient()), mLayoutVersion(NextLayoutVersion()) {}
 
     CardList::CardList(std::string aTitle, std::vector<Card> aCards)
-        : id(genUID()), title(std::move(aTitle)), cards(std::move(aCards))
-    {}
+        : id(ListId::NewTransient())
+        , title(std::move(aTitle))
+        , cards(std::move(aCards))
+        , mLayoutVersion(NextLayoutVersion())
+    {
+        FractionalRank::Rebalance(cards);
+        RebuildIndex();
+    }
 
     // Card operations
-    void CardList::AddCard(Card card) { cards.push_back(std::move(card)); }
+    void CardList::AddCard(Card card)
+    {
+        card.changes.Touch(); // Parent list is part of the card row
+        cards.push_back(std::move(card));
+        IndexCards(cards.size() - 1, cards.size());
+        RankCard(cards.size() - 1);
+    }
 
     void CardList::InsertCard(Card card, size_t insert_index)
     {
+        card.changes.Touch();
         if(insert_index >= cards.size()) {
+            insert_index = cards.size();
             cards.push_back(std::move(card));
         }
         else
         {
             cards.insert(cards.begin() + insert_index, std::move(card));
         }
+        IndexCards(insert_index, cards.size());
+        RankCard(insert_index);
     }
 
-    void CardList::RemoveCard(const std::string& cardId)
+    void CardList::RemoveCard(CardId cardId)
     {
-        cards.erase(
-            std::remove_if(
-                cards.begin(),
-                cards.end(),
-                [&](const Card& c) { return c.id == cardId; }
-            ),
-            cards.end()
+        if(TakeCard(cardId))
+        {
+            removedCardIds.push_back(cardId);
+        }
+    }
+
+    std::optional<Card> CardList::TakeCard(CardId cardId)
+    {
+        auto index = FindSlot(cardId);
+        if(!index)
+            return std::nullopt;
+
+        Card card = std::move(cards[*index]);
+        cards.erase(cards.begin() + *index);
+        mCardSlots.erase(cardId);
+        IndexCards(*index, cards.size());
+        return card;
+    }
+
+    size_t CardList::TakeCards(const std::unordered_set<CardId>& cardIds, std::vector<Card>& out)
+    {
+        const size_t taken = out.size();
+        size_t first = cards.size();
+        auto keep = cards.begin();
+        for(auto it = cards.begin(); it != cards.end(); ++it)
+        {
+            if(cardIds.count(it->id))
+            {
+                first = std::min(first, static_cast<size_t>(it - cards.begin()));
+                mCardSlots.erase(it->id);
+                out.push_back(std::move(*it));
+            }
+            else
+            {
+                if(keep != it)
+                    *keep = std::move(*it);
+                ++keep;
+            }
+        }
+        cards.erase(keep, cards.end());
+
+        // Only the cards behind the first gap changed slots
+        if(out.size() > taken)
+            IndexCards(first, cards.size());
+        return out.size() - taken;
+    }
+
+    void CardList::InsertCards(std::vector<Card> newCards, size_t index)
+    {
+        if(newCards.empty())
+            return;
+
+        index = std::min(index, cards.size());
+        for(auto& card : newCards)
+        {
+            card.changes.Touch(); // Parent list is part of the card row
+        }
+        cards.insert(
+            cards.begin() + index,
+            std::make_move_iterator(newCards.begin()),
+            std::make_move_iterator(newCards.end())
         );
+        IndexCards(index, cards.size());
+        FractionalRank::AssignRange(cards, index, newCards.size());
+    }
+
+    void CardList::PlaceCards(std::vector<Card> placedCards)
+    {
+        if(placedCards.empty())
+            return;
+
+        auto byPosition = [](const Card& a, const Card& b) { return a.position < b.position; };
+        if(!std::is_sorted(placedCards.begin(), placedCards.end(), byPosition))
+            std::stable_sort(placedCards.begin(), placedCards.end(), byPosition);
+
+        // One merge of two ranked sequences; equal ranks keep the resident card first
+        std::vector<Card> merged;
+        merged.reserve(cards.size() + placedCards.size());
+        std::vector<size_t> placedSlots;
+        placedSlots.reserve(placedCards.size());
+        auto resident = cards.begin();
+        for(Card& card : placedCards)
+        {
+            while(resident != cards.end() && resident->position <= card.position)
+                merged.push_back(std::move(*resident++));
+
+            card.changes.Touch(); // Parent list is part of the card row
+            placedSlots.push_back(merged.size());
+            merged.push_back(std::move(card));
+        }
+        std::move(resident, cards.end(), std::back_inserter(merged));
+        cards = std::move(merged);
+        IndexCards(placedSlots.front(), cards.size());
+
+        for(size_t slot : placedSlots)
+        {
+            const bool tiesPrev = slot > 0 && cards[slot - 1].position == cards[slot].position;
+            const bool tiesNext
+                = slot + 1 < cards.size() && cards[slot + 1].position == cards[slot].position;
+            if(tiesPrev || tiesNext)
+                RankCard(slot);
+        }
     }
 
     void CardList::MoveCard(size_t fromIndex, size_t toIndex)
@@ -66,41 +187,80 @@ namespace Stride
                 cards.begin() + fromIndex + 1
             );
         }
+        IndexCards(std::min(fromIndex, toIndex), std::max(fromIndex, toIndex) + 1);
+        RankCard(toIndex);
     }
 
-    Card* CardList::FindCard(const std::string& cardId)
+    Card* CardList::FindCard(CardId cardId)
     {
-        auto it = std::find_if(cards.begin(), cards.end(), [&](const Card& c) {
-            return c.id == cardId;
-        });
-        return it != cards.end() ? &(*it) : nullptr;
+        auto index = FindSlot(cardId);
+        return index ? &cards[*index] : nullptr;
     }
 
-    const Card* CardList::FindCard(const std::string& cardId) const
+    const Card* CardList::FindCard(CardId cardId) const
     {
-        auto it = std::find_if(cards.begin(), cards.end(), [&](const Card& c) {
-            return c.id == cardId;
-        });
-        return it != cards.end() ? &(*it) : nullptr;
+        auto index = FindSlot(cardId);
+        return index ? &cards[*index] : nullptr;
     }
 
-    std::optional<size_t> CardList::GetCardIndex(const std::string& cardId) const
+    std::optional<size_t> CardList::GetCardIndex(CardId cardId) const { return FindSlot(cardId); }
+
+    void CardList::RankCard(size_t index) { FractionalRank::Assign(cards, index); }
+
+    size_t CardList::HeapBytes() const
     {
-        auto it = std::find_if(cards.begin(), cards.end(), [&](const Card& c) {
-            return c.id == cardId;
-        });
-        if(it != cards.end())
+        size_t bytes = MemoryUsage::HeapBytes(title) + MemoryUsage::HeapBytes(cards)
+                       + MemoryUsage::HeapBytes(removedCardIds)
+                       + MemoryUsage::HeapBytes(mCardSlots);
+        for(const auto& card : cards)
         {
-            return std::distance(cards.begin(), it);
+            bytes += card.HeapBytes();
         }
-        return std::nullopt;
+        return bytes;
     }
 
-    void CardList::UpdateCardPositions()
+    bool CardList::HasUnsavedChanges() const
     {
-        for(size_t i = 0; i < cards.size(); ++i)
+        return changes.IsDirty() || !removedCardIds.empty()
+               || std::any_of(cards.begin(), cards.end(), [](const Card& card) {
+                      return card.HasUnsavedChanges();
+                  });
+    }
+
+    void CardList::RebuildIndex() const
+    {
+        mCardSlots.clear();
+        mCardSlots.reserve(cards.size());
+        IndexCards(0, cards.size());
+    }
+
+    void CardList::TouchLayout() const { mLayoutVersion = NextLayoutVersion(); }
+
+    void CardList::IndexCards(size_t first, size_t last) const
+    {
+        TouchLayout();
+        for(size_t i = first; i < last && i < cards.size(); ++i)
         {
-            cards[i].position = static_cast<int>(i);
+            mCardSlots[cards[i].id] = i;
         }
     }
+
+    std::optional<size_t> CardList::FindSlot(CardId cardId) const
+    {
+        // A size mismatch means cards were added or removed behind the index
+        if(mCardSlots.size() != cards.size())
+            RebuildIndex();
+
+        auto it = mCardSlots.find(cardId);
+        if(it == mCardSlots.end())
+            return std::nullopt;
+
+        if(it->second < cards.size() && cards[it->second].id == cardId)
+            return it->second;
+
+        // Stale slot: the vector was reordered directly
+        RebuildIndex();
+        it = mCardSlots.find(cardId);
+        return it != mCardSlots.end() ? std::optional<size_t>(it->second) : std::nullopt;
+    }
 }
\ No newline at end of file
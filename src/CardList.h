@@ -3,18 +3,24 @@
 #include "Card.h"
 #include "imgui.h"
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Stride
 {
     struct CardList
     {
         // Identity
-        std::string id;
+        ListId id;
 
         // Data
         std::string title;
         std::vector<Card> cards;
-        int position;
+        double position = 0.0; // Fractional rank within the board
+        ChangeTracker changes;
+
+        // Cards deleted since the last save (moves are not recorded)
+        std::vector<CardId> removedCardIds;
 
         // Constructors
         CardList();
@@ -23,16 +29,46 @@ namespace Stride
         // Card operations
         void AddCard(Card card);
         void InsertCard(Card card, size_t index);
-        void RemoveCard(const std::string& cardId);
+        void RemoveCard(CardId cardId); // Deletes the card
+        std::optional<Card> TakeCard(CardId cardId); // Detaches it for a move
+        // Batch moves: detach every listed card in one pass, appending them to out in list
+        // order, and splice cards in at an index ranked between their new neighbours
+        size_t TakeCards(const std::unordered_set<CardId>& cardIds, std::vector<Card>& out);
+        void InsertCards(std::vector<Card> newCards, size_t index);
+        // Merge cards back in by the rank they carry (undo); only ties with a neighbour re-rank
+        void PlaceCards(std::vector<Card> placedCards);
         void MoveCard(size_t fromIndex, size_t toIndex);
-        void UpdateCardPositions(); // Update position field of all cards to match array index
+        void RankCard(size_t index); // Rank between neighbours, touching only that card
 
         // Query
-        Card* FindCard(const std::string& cardId);
-        const Card* FindCard(const std::string& cardId) const;
-        std::optional<size_t> GetCardIndex(const std::string& cardId) const;
+        Card* FindCard(CardId cardId);
+        const Card* FindCard(CardId cardId) const;
+        std::optional<size_t> GetCardIndex(CardId cardId) const;
 
         bool IsEmpty() const { return cards.empty(); }
         size_t CardCount() const { return cards.size(); }
+
+        // Re-index after card IDs were reassigned in place (first save)
+        void RebuildIndex() const;
+
+        // Bumped whenever cards are added, removed, reordered or edited in place. Versions come
+        // from one process-wide counter, so a reloaded list never repeats an earlier value.
+        uint32_t LayoutVersion() const { return mLayoutVersion; }
+        void TouchLayout() const; // Call after editing a card's content in place
+
+        // Heap memory owned by the list and its cards; excludes sizeof(CardList)
+        size_t HeapBytes() const;
+
+        // Unsaved edits on the list or any of its cards, including deletions
+        bool HasUnsavedChanges() const;
+
+      private:
+        // CardId -> index into cards. The operations above keep it in step; lookups verify the
+        // slot they get and rebuild it if `cards` was modified directly (e.g. while loading).
+        mutable std::unordered_map<CardId, size_t> mCardSlots;
+        mutable uint32_t mLayoutVersion;
+
+        void IndexCards(size_t first, size_t last) const;
+        std::optional<size_t> FindSlot(CardId cardId) const;
     };
 }
@@ -11,6 +11,7 @@
 // Include your project's managers to access the data
 #include "imgui.h"
 #include "managers/FontManager.h"
+#include "managers/BoardManager.h"
 #include "MultiThreading.h"
 #include "utils.h"
 
@@ -93,6 +94,12 @@ void DebuggerWindow::Render()
             ImGui::EndTabItem();
         }
 
+        if(ImGui::BeginTabItem(ICON_FA_MEMORY " Memory"))
+        {
+            RenderMemoryTab();
+            ImGui::EndTabItem();
+        }
+
         ImGui::EndTabBar();
     }
 
@@ -294,4 +301,84 @@ void DebuggerWindow::RenderFontsTab()
     }
 }
 
+void DebuggerWindow::RenderMemoryTab()
+{
+    Stride::BoardRepository& repository = BoardManager::Get().GetRepository();
+
+    // Accounting walks every loaded card, so it is refreshed once a second rather than per frame
+    static double lastRecount = -1.0;
+    if(Get().m_AutoRefresh && ImGui::GetTime() - lastRecount > 1.0)
+    {
+        repository.EnforceMemoryBudget();
+        lastRecount = ImGui::GetTime();
+    }
+
+    const Stride::BoardMemoryStats& stats = repository.GetMemoryStats();
+
+    ImGui::Text(ICON_FA_MEMORY " Board Memory");
+    ImGui::Separator();
+
+    int budgetMb = static_cast<int>(repository.GetMemoryBudget() >> 20);
+    if(ImGui::SliderInt("Budget (MB)", &budgetMb, 1, 4096))
+    {
+        repository.SetMemoryBudget(static_cast<size_t>(budgetMb) << 20);
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("Recount"))
+    {
+        repository.EnforceMemoryBudget();
+    }
+
+    const float fraction = stats.budget > 0 ? static_cast<float>(stats.residentBytes)
+                                                  / static_cast<float>(stats.budget)
+                                            : 0.0f;
+    std::string overlay = FormatBytes(stats.residentBytes) + " / " + FormatBytes(stats.budget);
+    ImGui::ProgressBar(std::min(fraction, 1.0f), ImVec2(-FLT_MIN, 0), overlay.c_str());
+
+    ImGui::Text(
+        "Loaded: %zu   Summaries: %zu   Evictions: %zu",
+        stats.loadedBoards,
+        stats.summaryBoards,
+        stats.evictions
+    );
+    ImGui::Spacing();
 
+    if(ImGui::BeginTable(
+           "BoardMemory",
+           4,
+           ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY
+       ))
+    {
+        ImGui::TableSetupColumn("Board", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("State", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Cards", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableHeadersRow();
+
+        for(const auto& board : repository.GetAll())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", board.title.c_str());
+
+            ImGui::TableSetColumnIndex(1);
+            switch(board.loadState)
+            {
+                case Stride::BoardLoadState::Summary: ImGui::TextDisabled("summary"); break;
+                case Stride::BoardLoadState::Loading: ImGui::Text("loading"); break;
+                case Stride::BoardLoadState::Loaded: ImGui::Text("loaded"); break;
+            }
+
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%zu", board.GetTotalCardCount());
+
+            ImGui::TableSetColumnIndex(3);
+            auto bytes = stats.boardBytes.find(board.id);
+            ImGui::Text(
+                "%s",
+                bytes != stats.boardBytes.end() ? FormatBytes(bytes->second).c_str() : "-"
+            );
+        }
+        ImGui::EndTable();
+    }
+}
@@ -9,6 +9,7 @@ class DebuggerWindow
     DebuggerWindow() = default;
 
     static void RenderFontsTab();
+    static void RenderMemoryTab();
 
 
 
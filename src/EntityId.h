@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace Stride
+{
+    enum class EntityKind : uint8_t
+    {
+        Board = 1,
+        List = 2,
+        Card = 3,
+        ChecklistItem = 4
+    };
+
+    /**
+     * @brief Typed 64-bit handle identifying a board, list, card or checklist item.
+     *
+     * Bit layout: [8-bit kind][1-bit transient][55-bit value]. Persisted entities carry their
+     * database row ID as the value. Entities created in memory and not saved yet get a
+     * process-unique transient value, which the storage adapter replaces with a row ID on the
+     * first save.
+     *
+     * The kind is part of both the C++ type and the bits: a ListId cannot be passed where a
+     * CardId is expected, and Raw() is unique across kinds. Comparing and hashing are single
+     * integer operations. ToString() is meant only for ImGui labels, logs and export.
+     *
+     * Usage:
+     * @code
+     * CardId id = CardId::FromRow(42);   // Loaded from the database
+     * CardId draft = CardId::NewTransient(); // Created in the UI, not saved yet
+     * int row = draft.RowId();           // 0 until the card has been persisted
+     * @endcode
+     */
+    template<EntityKind Kind>
+    class EntityId
+    {
+      public:
+        constexpr EntityId() = default;
+
+        // Handle for a database row; row IDs below 1 give an invalid handle
+        static constexpr EntityId FromRow(int rowId)
+        {
+            return rowId > 0 ? EntityId(kTag | static_cast<uint64_t>(rowId)) : EntityId();
+        }
+
+        // Handle for an entity that only exists in memory so far
+        static EntityId NewTransient()
+        {
+            static std::atomic<uint64_t> sLastTransient{ 0 };
+            return EntityId(kTag | kTransientBit | (++sLastTransient & kValueMask));
+        }
+
+        constexpr bool IsValid() const { return mValue != 0; }
+        constexpr bool IsPersisted() const { return IsValid() && (mValue & kTransientBit) == 0; }
+
+        // Database row ID, or 0 if the entity has never been persisted
+        constexpr int RowId() const
+        {
+            return IsPersisted() ? static_cast<int>(mValue & kValueMask) : 0;
+        }
+
+        constexpr uint64_t Raw() const { return mValue; }
+
+        // "card_42" when persisted, "card~7" while transient
+        std::string ToString() const
+        {
+            if(!IsValid())
+                return std::string(Prefix()) + "_none";
+            const char separator = IsPersisted() ? '_' : '~';
+            return Prefix() + std::string(1, separator) + std::to_string(mValue & kValueMask);
+        }
+
+        constexpr bool operator==(EntityId other) const { return mValue == other.mValue; }
+        constexpr bool operator!=(EntityId other) const { return mValue != other.mValue; }
+        constexpr bool operator<(EntityId other) const { return mValue < other.mValue; }
+
+      private:
+        static constexpr uint64_t kTag = static_cast<uint64_t>(Kind) << 56;
+        static constexpr uint64_t kTransientBit = uint64_t(1) << 55;
+        static constexpr uint64_t kValueMask = kTransientBit - 1;
+
+        uint64_t mValue = 0;
+
+        constexpr explicit EntityId(uint64_t value) : mValue(value) {}
+
+        static constexpr const char* Prefix()
+        {
+            switch(Kind)
+            {
+                case EntityKind::Board: return "board";
+                case EntityKind::List: return "list";
+                case EntityKind::Card: return "card";
+                case EntityKind::ChecklistItem: return "item";
+            }
+            return "entity";
+        }
+    };
+
+    using BoardId = EntityId<EntityKind::Board>;
+    using ListId = EntityId<EntityKind::List>;
+    using CardId = EntityId<EntityKind::Card>;
+    using ChecklistItemId = EntityId<EntityKind::ChecklistItem>;
+
+    // Row IDs handed out by a save, keyed by the Raw() of the transient ID they replace
+    using AssignedIds = std::unordered_map<uint64_t, int>;
+}
+
+namespace std
+{
+    template<Stride::EntityKind Kind>
+    struct hash<Stride::EntityId<Kind>>
+    {
+        size_t operator()(Stride::EntityId<Kind> id) const noexcept
+        {
+            return std::hash<uint64_t>{}(id.Raw());
+        }
+    };
+}
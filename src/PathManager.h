@@ -43,6 +43,7 @@ namespace Stride
         fs::path GetSettingsFile() const { return GetConfigDir() / "settings.json"; }
         fs::path GetFontDataFile() const { return GetConfigDir() / "fontData.json"; }
         fs::path GetDatabaseFile() const { return GetDataDir() / "stride.db"; }
+        fs::path GetSnapshotFile() const { return GetDataDir() / "stride.snapshot"; }
         fs::path GetLogFile() const;
 
         /// Custom paths
@@ -10,7 +10,6 @@
 #include "userenv.h"
 #include <commdlg.h>
 #include "Types.h"
-#include <random>
 
 inline ImColor darkerShade(ImVec4 color, float multiplier = 0.1428)
 {
@@ -30,21 +29,6 @@ inline ImColor lighterShade(ImVec4 color, float factor = 0.1428)
     return color;
 }
 
-inline std::string genUID(int length = 16)
-{
-    static std::string str(
-        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
-    );
-    std::random_device rd;
-    std::mt19937 generator(rd());
-    std::shuffle(str.begin(), str.end(), generator);
-    return str.substr(
-        0,
-        length
-    ); // assumes 32 < number of characters in str
-}
-
-
 inline void SetStyleColorDarkness()
 {
     ImVec4* colors = ImGui::GetStyle().Colors;
@@ -1,8 +1,10 @@
 #include "pch.h"
 #include "BoardData.h"
-#include "Utils.h"
+#include "utilities/FractionalRank.h"
+#include "utilities/MemoryUsage.h"
 #include <algorithm>
 #include <chrono>
+#include <unordered_set>
 
 namespace Stride
 {
@@ -15,20 +17,20 @@ namespace Stride
     }
     
     BoardData::BoardData()
-        : id(genUID())
+        : id(BoardId::NewTransient())
         , createdAt(GetCurrentTimestamp())
         , updatedAt(createdAt)
     {}
     
     BoardData::BoardData(std::string title)
-        : id(genUID())
+        : id(BoardId::NewTransient())
         , title(std::move(title))
         , createdAt(GetCurrentTimestamp())
         , updatedAt(createdAt)
     {}
     
-    BoardData::BoardData(std::string id, std::string title)
-        : id(std::move(id))
+    BoardData::BoardData(BoardId id, std::string title)
+        : id(id)
         , title(std::move(title))
         , createdAt(GetCurrentTimestamp())
         , updatedAt(createdAt)
@@ -37,6 +39,8 @@ namespace Stride
     CardList& BoardData::AddList(const std::string& listTitle)
     {
         lists.emplace_back(listTitle);
+        IndexLists(lists.size() - 1, lists.size());
+        RankList(lists.size() - 1);
         updatedAt = GetCurrentTimestamp();
         return lists.back();
     }
@@ -49,23 +53,33 @@ namespace Stride
         }
         
         auto it = lists.emplace(lists.begin() + index, listTitle);
+        IndexLists(index, lists.size());
+        RankList(index);
         updatedAt = GetCurrentTimestamp();
         return *it;
     }
     
-    void BoardData::RemoveList(const std::string& listId)
+    void BoardData::RemoveList(ListId listId)
     {
-        lists.erase(
-            std::remove_if(lists.begin(), lists.end(),
-                [&](const CardList& list) { return list.id == listId; }),
-            lists.end()
-        );
+        auto index = FindListSlot(listId);
+        if (!index)
+            return;
+
+        removedListIds.push_back(listId);
+        for (const auto& card : lists[*index].cards)
+        {
+            mCardOwners.erase(card.id);
+        }
+
+        lists.erase(lists.begin() + *index);
+        mListSlots.erase(listId);
+        IndexLists(*index, lists.size());
         updatedAt = GetCurrentTimestamp();
     }
     
     void BoardData::MoveList(size_t fromIndex, size_t toIndex)
     {
-        if (fromIndex >= lists.size() || toIndex >= lists.size())
+        if (fromIndex >= lists.size() || toIndex >= lists.size() || fromIndex == toIndex)
             return;
         
         if (fromIndex < toIndex)
@@ -84,73 +98,68 @@ namespace Stride
                 lists.begin() + fromIndex + 1
             );
         }
+        IndexLists(std::min(fromIndex, toIndex), std::max(fromIndex, toIndex) + 1);
+        RankList(toIndex);
         updatedAt = GetCurrentTimestamp();
     }
     
-    CardList* BoardData::FindList(const std::string& listId)
+    CardList* BoardData::FindList(ListId listId)
     {
-        auto it = std::find_if(lists.begin(), lists.end(),
-            [&](const CardList& list) { return list.id == listId; });
-        return it != lists.end() ? &(*it) : nullptr;
+        auto index = FindListSlot(listId);
+        return index ? &lists[*index] : nullptr;
     }
     
-    const CardList* BoardData::FindList(const std::string& listId) const
+    const CardList* BoardData::FindList(ListId listId) const
     {
-        auto it = std::find_if(lists.begin(), lists.end(),
-            [&](const CardList& list) { return list.id == listId; });
-        return it != lists.end() ? &(*it) : nullptr;
+        auto index = FindListSlot(listId);
+        return index ? &lists[*index] : nullptr;
     }
     
-    std::optional<size_t> BoardData::GetListIndex(const std::string& listId) const
+    std::optional<size_t> BoardData::GetListIndex(ListId listId) const
     {
-        auto it = std::find_if(lists.begin(), lists.end(),
-            [&](const CardList& list) { return list.id == listId; });
-        if (it != lists.end())
-        {
-            return std::distance(lists.begin(), it);
-        }
-        return std::nullopt;
+        return FindListSlot(listId);
     }
     
-    Card* BoardData::FindCard(const std::string& cardId)
+    Card* BoardData::FindCard(CardId cardId)
     {
-        for (auto& list : lists)
-        {
-            if (auto* card = list.FindCard(cardId))
-            {
-                return card;
-            }
-        }
-        return nullptr;
+        return FindCardWithList(cardId).second;
     }
     
-    const Card* BoardData::FindCard(const std::string& cardId) const
+    const Card* BoardData::FindCard(CardId cardId) const
     {
-        for (const auto& list : lists)
-        {
-            if (auto* card = const_cast<CardList&>(list).FindCard(cardId))
-            {
-                return card;
-            }
-        }
-        return nullptr;
+        return const_cast<BoardData*>(this)->FindCardWithList(cardId).second;
     }
     
-    std::pair<CardList*, Card*> BoardData::FindCardWithList(const std::string& cardId)
+    std::pair<CardList*, Card*> BoardData::FindCardWithList(CardId cardId)
     {
-        for (auto& list : lists)
+        auto owner = mCardOwners.find(cardId);
+        if (owner != mCardOwners.end())
         {
-            if (auto* card = list.FindCard(cardId))
+            CardList* list = FindList(owner->second);
+            if (Card* card = list ? list->FindCard(cardId) : nullptr)
             {
-                return {&list, card};
+                return {list, card};
             }
         }
-        return {nullptr, nullptr};
+        else if (mIndexedCardLayout == CardLayout())
+        {
+            return {nullptr, nullptr}; // Index is current: the card is not on this board
+        }
+
+        // Cards were added or moved through CardList directly since the last rebuild
+        RebuildCardOwners();
+        owner = mCardOwners.find(cardId);
+        if (owner == mCardOwners.end())
+            return {nullptr, nullptr};
+
+        CardList* list = FindList(owner->second);
+        Card* card = list ? list->FindCard(cardId) : nullptr;
+        return {card ? list : nullptr, card};
     }
     
     void BoardData::MoveCard(
-        const std::string& cardId,
-        const std::string& targetListId,
+        CardId cardId,
+        ListId targetListId,
         size_t targetIndex)
     {
         auto [sourceList, card] = FindCardWithList(cardId);
@@ -159,20 +168,132 @@ namespace Stride
         CardList* targetList = FindList(targetListId);
         if (!targetList) return;
         
-        // Copy card data
-        Card movedCard = std::move(*card);
-        
-        // Remove from source
-        sourceList->RemoveCard(cardId);
+        // Detach from source (a move, not a delete)
+        std::optional<Card> movedCard = sourceList->TakeCard(cardId);
         
         // Insert into target
-        targetList->InsertCard(std::move(movedCard), targetIndex);
+        targetList->InsertCard(std::move(*movedCard), targetIndex);
+        mCardOwners[cardId] = targetListId;
         
         updatedAt = GetCurrentTimestamp();
     }
     
+    size_t BoardData::MoveCards(
+        const std::vector<CardId>& cardIds,
+        ListId targetListId,
+        size_t targetIndex)
+    {
+        CardList* targetList = FindList(targetListId);
+        if (!targetList) return 0;
+
+        // Cards not on this board are skipped; lists holding none of the rest are left alone
+        std::unordered_set<CardId> moving;
+        std::vector<bool> involved(lists.size(), false);
+        moving.reserve(cardIds.size());
+        for (CardId cardId : cardIds)
+        {
+            auto [list, card] = FindCardWithList(cardId);
+            if (!card) continue;
+            moving.insert(cardId);
+            involved[static_cast<size_t>(list - lists.data())] = true;
+        }
+        if (moving.empty()) return 0;
+
+        // The drop index counts the moving cards still in the target list; those in front of
+        // it leave a gap the insertion point closes over
+        size_t insertAt = std::min(targetIndex, targetList->cards.size());
+        insertAt -= static_cast<size_t>(std::count_if(
+            targetList->cards.begin(),
+            targetList->cards.begin() + insertAt,
+            [&](const Card& card) { return moving.count(card.id) > 0; }));
+
+        // One compaction pass per involved list, collecting the moving cards in board order
+        std::vector<Card> moved;
+        moved.reserve(moving.size());
+        for (size_t l = 0; l < lists.size(); ++l)
+        {
+            if (involved[l])
+                lists[l].TakeCards(moving, moved);
+        }
+
+        for (const Card& card : moved)
+        {
+            mCardOwners[card.id] = targetListId;
+        }
+        const size_t count = moved.size();
+        targetList->InsertCards(std::move(moved), insertAt);
+
+        updatedAt = GetCurrentTimestamp();
+        return count;
+    }
+
+    std::vector<CardPlacement> BoardData::CapturePlacements(
+        const std::vector<CardId>& cardIds) const
+    {
+        std::vector<CardPlacement> placements;
+        placements.reserve(cardIds.size());
+        for (CardId cardId : cardIds)
+        {
+            auto [list, card] = const_cast<BoardData*>(this)->FindCardWithList(cardId);
+            if (card)
+                placements.push_back({cardId, list->id, card->position});
+        }
+        return placements;
+    }
+
+    size_t BoardData::PlaceCards(const std::vector<CardPlacement>& placements)
+    {
+        // Cards or target lists no longer on the board are skipped
+        std::unordered_map<CardId, const CardPlacement*> placing;
+        std::vector<bool> involved(lists.size(), false);
+        placing.reserve(placements.size());
+        for (const CardPlacement& placement : placements)
+        {
+            auto [list, card] = FindCardWithList(placement.cardId);
+            if (!card || !FindList(placement.listId)) continue;
+            placing[placement.cardId] = &placement;
+            involved[static_cast<size_t>(list - lists.data())] = true;
+        }
+        if (placing.empty()) return 0;
+
+        std::unordered_set<CardId> taking;
+        taking.reserve(placing.size());
+        for (const auto& [cardId, placement] : placing)
+        {
+            taking.insert(cardId);
+        }
+
+        std::vector<Card> taken;
+        taken.reserve(taking.size());
+        for (size_t l = 0; l < lists.size(); ++l)
+        {
+            if (involved[l])
+                lists[l].TakeCards(taking, taken);
+        }
+
+        // Group by destination, then merge each group into its list by rank
+        std::unordered_map<ListId, std::vector<Card>> arriving;
+        for (Card& card : taken)
+        {
+            const CardPlacement& placement = *placing[card.id];
+            card.position = placement.position;
+            mCardOwners[card.id] = placement.listId;
+            arriving[placement.listId].push_back(std::move(card));
+        }
+        for (auto& [listId, cards] : arriving)
+        {
+            FindList(listId)->PlaceCards(std::move(cards));
+        }
+
+        updatedAt = GetCurrentTimestamp();
+        return taken.size();
+    }
+
     size_t BoardData::GetTotalCardCount() const
     {
+        if (!IsLoaded())
+            return summaryCardCount;
+
         size_t count = 0;
         for (const auto& list : lists)
         {
@@ -181,11 +302,111 @@ namespace Stride
         return count;
     }
 
-    void BoardData::UpdateListPositions()
+    void BoardData::RankList(size_t index) { FractionalRank::Assign(lists, index); }
+
+    void BoardData::RebuildIndex() const
+    {
+        mListSlots.clear();
+        mListSlots.reserve(lists.size());
+        IndexLists(0, lists.size());
+        for (const auto& list : lists)
+        {
+            list.RebuildIndex();
+        }
+        RebuildCardOwners();
+    }
+
+    size_t BoardData::ResidentBytes() const
+    {
+        size_t bytes = sizeof(BoardData) + MemoryUsage::HeapBytes(title)
+                       + MemoryUsage::HeapBytes(description)
+                       + MemoryUsage::HeapBytes(backgroundColor)
+                       + MemoryUsage::HeapBytes(backgroundImage) + MemoryUsage::HeapBytes(lists)
+                       + MemoryUsage::HeapBytes(removedListIds)
+                       + MemoryUsage::HeapBytes(mListSlots) + MemoryUsage::HeapBytes(mCardOwners);
+        for (const auto& list : lists)
+        {
+            bytes += list.HeapBytes();
+        }
+        return bytes;
+    }
+
+    bool BoardData::HasUnsavedChanges() const
+    {
+        return changes.IsDirty() || !removedListIds.empty() || deletesInFlight > 0
+               || std::any_of(lists.begin(), lists.end(), [](const CardList& list) {
+                      return list.HasUnsavedChanges();
+                  });
+    }
+
+    void BoardData::Unload()
     {
-        for (size_t i = 0; i < lists.size(); ++i)
+        summaryListCount = GetListCount();
+        summaryCardCount = GetTotalCardCount();
+        loadState = BoardLoadState::Summary;
+
+        // Swapped with empty containers so the memory is actually released
+        std::vector<CardList>().swap(lists);
+        std::vector<ListId>().swap(removedListIds);
+        std::unordered_map<ListId, size_t>().swap(mListSlots);
+        std::unordered_map<CardId, ListId>().swap(mCardOwners);
+        mIndexedCardLayout = 0;
+    }
+
+    void BoardData::IndexLists(size_t first, size_t last) const
+    {
+        for (size_t i = first; i < last && i < lists.size(); ++i)
+        {
+            mListSlots[lists[i].id] = i;
+        }
+    }
+
+    void BoardData::RebuildCardOwners() const
+    {
+        mCardOwners.clear();
+        mCardOwners.reserve(GetTotalCardCount());
+        for (const auto& list : lists)
+        {
+            for (const auto& card : list.cards)
+            {
+                mCardOwners[card.id] = list.id;
+            }
+        }
+        mIndexedCardLayout = CardLayout();
+    }
+
+    uint64_t BoardData::CardLayout() const
+    {
+        // Every card-adding operation grows a list or bumps its layout version, so an
+        // unchanged sum means no card can have appeared since the owners were indexed
+        uint64_t layout = lists.size();
+        for (const auto& list : lists)
         {
-            lists[i].position = static_cast<int>(i);
+            layout += list.cards.size() + list.LayoutVersion();
         }
+        return layout;
+    }
+
+    std::optional<size_t> BoardData::FindListSlot(ListId listId) const
+    {
+        // A size mismatch means lists were added or removed behind the index
+        if (mListSlots.size() != lists.size())
+        {
+            mListSlots.clear();
+            IndexLists(0, lists.size());
+        }
+
+        auto it = mListSlots.find(listId);
+        if (it == mListSlots.end())
+            return std::nullopt;
+
+        if (it->second < lists.size() && lists[it->second].id == listId)
+            return it->second;
+
+        // Stale slot: the vector was reordered directly
+        mListSlots.clear();
+        IndexLists(0, lists.size());
+        it = mListSlots.find(listId);
+        return it != mListSlots.end() ? std::optional<size_t>(it->second) : std::nullopt;
     }
 }
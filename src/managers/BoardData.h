@@ -3,10 +3,28 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <unordered_map>
 #include <cstdint>
 
 namespace Stride
 {
+    // How much of a board is in memory. Boards start as summaries (metadata and counts) and are
+    // hydrated with their lists and cards when opened.
+    enum class BoardLoadState
+    {
+        Summary,
+        Loading,
+        Loaded
+    };
+
+    // Where a card sits on a board. Undo captures these before an edit and restores them.
+    struct CardPlacement
+    {
+        CardId cardId;
+        ListId listId;
+        double position = 0.0;
+    };
+
     /**
      * @brief Represents a Kanban-style board containing multiple card lists.
      *
@@ -19,13 +37,16 @@ namespace Stride
      * This is a pure data structure with business logic for managing its content.
      * The BoardRepository handles persistence, while BoardViewController manages UI state.
      *
-     * @note Each board has a unique string ID generated at creation time.
+     * List and card lookups by ID go through hash indexes (ListId -> slot, CardId -> owning
+     * list), so FindList/FindCard are O(1) rather than scans over every card on the board.
+     *
+     * @note Each board has a typed BoardId; it is transient until the board is first saved.
      * @see CardList, Card, BoardRepository, BoardViewController
      */
     struct BoardData
     {
         // Identity
-        std::string id;
+        BoardId id;
         std::string title;
         std::string description;
 
@@ -41,37 +62,85 @@ namespace Stride
         int64_t updatedAt = 0;
         bool archived = false;
 
+        // Persistence bookkeeping: metadata changes and lists deleted since the last save
+        ChangeTracker changes;
+        std::vector<ListId> removedListIds;
+        size_t deletesInFlight = 0; // List and card deletes queued but not committed yet
+
+        // Lazy loading: lists stay empty until the board is Loaded; the counts stand in for them
+        BoardLoadState loadState = BoardLoadState::Loaded;
+        size_t summaryListCount = 0;
+        size_t summaryCardCount = 0;
+
         // Constructors
         BoardData();
         BoardData(std::string title);
-        BoardData(std::string id, std::string title);
+        BoardData(BoardId id, std::string title);
 
         // List operations
         CardList& AddList(const std::string& title);
         CardList& InsertList(const std::string& title, size_t index);
-        void RemoveList(const std::string& listId);
+        void RemoveList(ListId listId);
         void MoveList(size_t fromIndex, size_t toIndex);
-        void UpdateListPositions(); 
+        void RankList(size_t index); // Rank between neighbours, touching only that list
 
         // Query
-        CardList* FindList(const std::string& listId);
-        const CardList* FindList(const std::string& listId) const;
-        std::optional<size_t> GetListIndex(const std::string& listId) const;
+        CardList* FindList(ListId listId);
+        const CardList* FindList(ListId listId) const;
+        std::optional<size_t> GetListIndex(ListId listId) const;
 
         // Card operations (cross-list)
-        Card* FindCard(const std::string& cardId);
-        const Card* FindCard(const std::string& cardId) const;
-        std::pair<CardList*, Card*> FindCardWithList(const std::string& cardId);
+        Card* FindCard(CardId cardId);
+        const Card* FindCard(CardId cardId) const;
+        std::pair<CardList*, Card*> FindCardWithList(CardId cardId);
 
-        void
-        MoveCard(const std::string& cardId, const std::string& targetListId, size_t targetIndex);
+        void MoveCard(CardId cardId, ListId targetListId, size_t targetIndex);
 
-        // Statistics
+        // Move several cards (from any lists) to targetIndex of one list, keeping their board
+        // order. One pass over each list involved; only the moved cards are re-ranked.
+        size_t MoveCards(
+            const std::vector<CardId>& cardIds,
+            ListId targetListId,
+            size_t targetIndex
+        );
+
+        // Current placement of each card found on the board, in the order given
+        std::vector<CardPlacement> CapturePlacements(const std::vector<CardId>& cardIds) const;
+
+        // Put cards back at captured placements: one pass over each list they leave or join,
+        // so restoring a bulk move is linear in the cards involved
+        size_t PlaceCards(const std::vector<CardPlacement>& placements);
+
+        // Statistics (from the summary counts until the board is loaded)
         size_t GetTotalCardCount() const;
-        size_t GetListCount() const { return lists.size(); }
+        size_t GetListCount() const { return IsLoaded() ? lists.size() : summaryListCount; }
         bool IsEmpty() const { return lists.empty(); }
+        bool IsLoaded() const { return loadState == BoardLoadState::Loaded; }
 
         // Validation
-        bool IsValid() const { return !id.empty() && !title.empty(); }
+        bool IsValid() const { return id.IsValid() && !title.empty(); }
+
+        // Re-index after list or card IDs were reassigned in place (first save)
+        void RebuildIndex() const;
+
+        // Memory accounting: everything the board owns, including the BoardData itself
+        size_t ResidentBytes() const;
+        bool HasUnsavedChanges() const;
+
+        // Drop lists and cards, keeping metadata and counts (BoardLoadState::Summary)
+        void Unload();
+
+      private:
+        // The operations above keep these in step. Lookups verify every hit and fall back to a
+        // rebuild when the vectors were changed behind the board's back (loading, direct edits
+        // of CardList::cards), so the indexes are a cache, never a second source of truth.
+        mutable std::unordered_map<ListId, size_t> mListSlots;
+        mutable std::unordered_map<CardId, ListId> mCardOwners;
+        mutable uint64_t mIndexedCardLayout = 0;
+
+        void IndexLists(size_t first, size_t last) const;
+        void RebuildCardOwners() const;
+        uint64_t CardLayout() const;
+        std::optional<size_t> FindListSlot(ListId listId) const;
     };
 }
@@ -11,14 +11,18 @@ using Stride::Card;
 BoardManager::BoardManager()
     : mRepository(std::make_unique<BoardRepository>())
     , mViewController(std::make_unique<BoardViewController>(*mRepository))
-{}
+    , mSearchIndex(std::make_unique<Stride::CardSearchIndex>())
+{
+    // Saves follow edits, so a saved board may hold cards whose contents changed in place
+    mRepository->OnBoardModified([this](Stride::BoardId id) { mSearchIndex->MarkDirty(id); });
+}
 
-Stride::CardListUIState& BoardManager::GetListUIState(const std::string& listId)
+Stride::CardListUIState& BoardManager::GetListUIState(Stride::ListId listId)
 {
     return mViewController->GetListUIState(listId);
 }
 
-Stride::CardEditorState& BoardManager::GetEditorState(const std::string& listId)
+Stride::CardEditorState& BoardManager::GetEditorState(Stride::ListId listId)
 {
     return mViewController->GetEditorState(listId);
 }
@@ -91,7 +95,7 @@ BoardData& BoardManager::CreateBoard(const std::string& title)
     return mRepository->Create(title);
 }
 
-void BoardManager::SetActiveBoard(const std::string& id)
+void BoardManager::SetActiveBoard(Stride::BoardId id)
 {
     mViewController->SetActiveBoard(id);
 }
@@ -101,21 +105,31 @@ BoardData* BoardManager::GetActiveBoard()
     return mViewController->GetActiveBoard();
 }
 
+bool BoardManager::SaveActiveBoard()
+{
+    return mViewController->SaveActiveBoard();
+}
+
 std::vector<BoardData>& BoardManager::GetBoards()
 {
     return mRepository->GetAll();
 }
 
-BoardData* BoardManager::GetBoard(const std::string& id)
+BoardData* BoardManager::GetBoard(Stride::BoardId id)
 {
     return mRepository->GetById(id);
 }
 
-bool BoardManager::DeleteBoard(const std::string& id)
+bool BoardManager::DeleteBoard(Stride::BoardId id)
 {
     return mRepository->Delete(id);
 }
 
+std::vector<Stride::CardSearchHit> BoardManager::SearchCards(const Stride::CardSearchQuery& query)
+{
+    return mSearchIndex->Search(mRepository->GetAll(), query);
+}
+
 void BoardManager::AddList(const std::string& title)
 {
     BoardData* board = GetActiveBoard();
@@ -127,5 +141,7 @@ void BoardManager::AddList(const std::string& title)
 
 void BoardManager::Render()
 {
+    // Boards opened since the last frame become visible once their load is merged
+    mRepository->PollLoads();
     mViewController->Render();
 }
@@ -6,6 +6,7 @@
 #include "BoardData.h"
 #include "BoardRepository.h"
 #include "BoardViewController.h"
+#include "CardSearchIndex.h"
 
 
 /**
@@ -15,6 +16,7 @@
  * entry point for board-related functionality in the application. It coordinates between:
  * - BoardRepository: Handles data storage and CRUD operations
  * - BoardViewController: Manages UI rendering and user interactions
+ * - CardSearchIndex: Answers search-as-you-type queries over the loaded boards
  *
  * Key Responsibilities:
  * - Application initialization and setup
@@ -40,22 +42,27 @@ class BoardManager
 
     // Board operations (delegates to repository)
     Stride::BoardData& CreateBoard(const std::string& title);
-    void SetActiveBoard(const std::string& id);
+    void SetActiveBoard(Stride::BoardId id);
     Stride::BoardData* GetActiveBoard();
+    bool SaveActiveBoard();
     std::vector<Stride::BoardData>& GetBoards();
-    Stride::BoardData* GetBoard(const std::string& id);
-    bool DeleteBoard(const std::string& id);
+    Stride::BoardData* GetBoard(Stride::BoardId id);
+    bool DeleteBoard(Stride::BoardId id);
 
     // List operations (on active board)
     void AddList(const std::string& title);
 
+    // Search across loaded boards without touching the database
+    std::vector<Stride::CardSearchHit> SearchCards(const Stride::CardSearchQuery& query);
+
     // Get UI state for a card list (delegates to view controller)
-    Stride::CardListUIState& GetListUIState(const std::string& listId);
-    Stride::CardEditorState& GetEditorState(const std::string& listId);
+    Stride::CardListUIState& GetListUIState(Stride::ListId listId);
+    Stride::CardEditorState& GetEditorState(Stride::ListId listId);
 
     // Access to internals (for advanced use)
     Stride::BoardRepository& GetRepository() { return *mRepository; }
     Stride::BoardViewController& GetViewController() { return *mViewController; }
+    Stride::CardSearchIndex& GetSearchIndex() { return *mSearchIndex; }
 
   private:
     BoardManager();
@@ -64,4 +71,5 @@ class BoardManager
 
     std::unique_ptr<Stride::BoardRepository> mRepository;
     std::unique_ptr<Stride::BoardViewController> mViewController;
+    std::unique_ptr<Stride::CardSearchIndex> mSearchIndex;
 };
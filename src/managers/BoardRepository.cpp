@@ -1,8 +1,11 @@
 #include "pch.h"
 #include "BoardRepository.h"
-#include "Utils.h"
 #include <algorithm>
+#include "storage/BoardSnapshot.h"
 #include "storage/BoardStorageAdapter.h"
+#include "storage/PersistenceWorker.h"
+#include "managers/UndoJournal.h"
+#include "utilities/WorkerThread.h"
 #include "Log.h"
 
 namespace Stride
@@ -10,48 +13,72 @@ namespace Stride
     BoardData& BoardRepository::Create(const std::string& title)
     {
         BoardData tBoardData = BoardStorageAdapter::CreateBoard(title);
-        const std::string id = tBoardData.id;
+        const BoardId id = tBoardData.id;
         mBoards.emplace_back(std::move(tBoardData));
+        mBoardSlots[id] = mBoards.size() - 1;
         NotifyCreated(id);
         return mBoards.back();
     }
     
-    BoardData* BoardRepository::GetById(const std::string& id)
+    BoardData* BoardRepository::GetById(BoardId id)
     {
-        auto it = std::find_if(mBoards.begin(), mBoards.end(),
-            [&](const BoardData& b) { return b.id == id; });
-        return it != mBoards.end() ? &(*it) : nullptr;
+        auto index = FindSlot(id);
+        return index ? &mBoards[*index] : nullptr;
     }
     
-    const BoardData* BoardRepository::GetById(const std::string& id) const
+    const BoardData* BoardRepository::GetById(BoardId id) const
     {
-        auto it = std::find_if(mBoards.begin(), mBoards.end(),
-            [&](const BoardData& b) { return b.id == id; });
-        return it != mBoards.end() ? &(*it) : nullptr;
+        auto index = FindSlot(id);
+        return index ? &mBoards[*index] : nullptr;
     }
     
-    bool BoardRepository::Delete(const std::string& id)
+    bool BoardRepository::Delete(BoardId id)
     {
-        auto it = std::find_if(mBoards.begin(), mBoards.end(),
-            [&](const BoardData& b) { return b.id == id; });
-        
-        if (it != mBoards.end())
+        auto index = FindSlot(id);
+        if (!index)
+            return false;
+
+        mBoards.erase(mBoards.begin() + *index);
+        mPendingLoads.erase(id);
+        mPendingJournals.erase(id);
+        mLastOpened.erase(id);
+        UndoJournal::Get().Forget(id);
+        ReindexBoards();
+        NotifyDeleted(id);
+        return true;
+    }
+
+    void BoardRepository::ReindexBoards() const
+    {
+        mBoardSlots.clear();
+        mBoardSlots.reserve(mBoards.size());
+        for (size_t i = 0; i < mBoards.size(); ++i)
         {
-            mBoards.erase(it);
-            NotifyDeleted(id);
-            return true;
+            mBoardSlots[mBoards[i].id] = i;
         }
-        return false;
     }
-    
-    bool BoardRepository::Exists(const std::string& id) const
+
+    std::optional<size_t> BoardRepository::FindSlot(BoardId id) const
     {
-        return GetById(id) != nullptr;
+        // GetAll() hands out the vector, so it can change without the index noticing
+        if (mBoardSlots.size() != mBoards.size())
+            ReindexBoards();
+
+        auto it = mBoardSlots.find(id);
+        if (it != mBoardSlots.end() && it->second < mBoards.size() && mBoards[it->second].id == id)
+            return it->second;
+
+        if (it == mBoardSlots.end())
+            return std::nullopt;
+
+        ReindexBoards();
+        it = mBoardSlots.find(id);
+        return it != mBoardSlots.end() ? std::optional<size_t>(it->second) : std::nullopt;
     }
     
-    std::string BoardRepository::GenerateId()
+    bool BoardRepository::Exists(BoardId id) const
     {
-        return "board_" + genUID(12);
+        return GetById(id) != nullptr;
     }
     
     void BoardRepository::OnBoardCreated(BoardChangedCallback cb)
@@ -69,7 +96,7 @@ namespace Stride
         mOnModified.push_back(std::move(cb));
     }
     
-    void BoardRepository::NotifyCreated(const std::string& id)
+    void BoardRepository::NotifyCreated(BoardId id)
     {
         for (const auto& cb : mOnCreated)
         {
@@ -77,7 +104,7 @@ namespace Stride
         }
     }
     
-    void BoardRepository::NotifyDeleted(const std::string& id)
+    void BoardRepository::NotifyDeleted(BoardId id)
     {
         for (const auto& cb : mOnDeleted)
         {
@@ -85,7 +112,7 @@ namespace Stride
         }
     }
     
-    void BoardRepository::NotifyModified(const std::string& id)
+    void BoardRepository::NotifyModified(BoardId id)
     {
         for (const auto& cb : mOnModified)
         {
@@ -93,29 +120,272 @@ namespace Stride
         }
     }
     
-    void BoardRepository::LoadAll()
+    bool BoardRepository::Save(BoardId id)
     {
-        GL_INFO("Loading all boards from database...");
-        
+        BoardData* board = GetById(id);
+        if(!board)
+            return false;
+
         try
         {
-            // Load all boards from storage
-            std::vector<BoardData> loadedBoards = BoardStorageAdapter::LoadAllBoards();
-            
-            // Clear existing boards and replace with loaded ones
-            mBoards = std::move(loadedBoards);
-            
-            GL_INFO("Successfully loaded {} boards into repository", mBoards.size());
-            
-            // Notify observers for each loaded board
-            for(const auto& board : mBoards)
+            // Steps recorded before the save may still name the transient IDs it replaced
+            AssignedIds assigned;
+            BoardStorageAdapter::SaveFullBoard(*board, &assigned);
+            UndoJournal::Get().Persist(*board, assigned);
+        }
+        catch(const std::exception& e)
+        {
+            GL_ERROR("Failed to save board '{}': {}", id.ToString(), e.what());
+            return false;
+        }
+
+        // The first save swaps a transient board ID for its row ID
+        if (board->id != id)
+        {
+            ReindexBoards();
+            auto opened = mLastOpened.find(id);
+            if (opened != mLastOpened.end())
             {
-                NotifyCreated(board.id);
+                mLastOpened[board->id] = opened->second;
+                mLastOpened.erase(id);
             }
         }
+
+        NotifyModified(board->id);
+        return true;
+    }
+
+    void BoardRepository::LoadAll(LoadMode mode)
+    {
+        GL_INFO("Loading boards from database...");
+        
+        // Summaries are only metadata and counts: lists and cards are read when a board is
+        // opened. A full load hydrates the boards in parallel; they are merged here, on the
+        // main thread, before any observer hears of them. The snapshot from the last clean
+        // exit stands in for the summaries while the database is unchanged.
+        std::vector<BoardData> loadedBoards;
+        if (mode == LoadMode::Full)
+            loadedBoards = BoardStorageAdapter::LoadAllBoards();
+        else if (auto snapshot = BoardSnapshot::Load())
+            loadedBoards = std::move(*snapshot);
+        else
+            loadedBoards = BoardStorageAdapter::LoadBoardSummaries();
+
+        // Loads still in flight belong to the boards being replaced
+        mPendingLoads.clear();
+        mPendingJournals.clear();
+        mLastOpened.clear();
+        mBoards = std::move(loadedBoards);
+        ReindexBoards();
+        
+        GL_INFO("Successfully loaded {} boards into repository", mBoards.size());
+        EnforceMemoryBudget();
+        
+        // Notify observers for each loaded board
+        for(const auto& board : mBoards)
+        {
+            NotifyCreated(board.id);
+        }
+    }
+
+    bool BoardRepository::SaveSnapshot()
+    {
+        // Boards only count as saved once their writes are known to have committed
+        PersistenceWorker::Flush();
+        BoardStorageAdapter::ApplyWriteResults(mBoards);
+        return BoardSnapshot::Save(mBoards);
+    }
+
+    void BoardRepository::RequestLoad(BoardId id)
+    {
+        BoardData* board = GetById(id);
+        if (!board)
+            return;
+
+        mLastOpened[id] = ++mOpenClock;
+
+        // The undo history is read once per session, whether or not the board is loaded
+        const int rowId = id.RowId();
+        if (rowId != 0 && !UndoJournal::Get().IsLoaded(id) && !mPendingJournals.count(id))
+        {
+            mPendingJournals[id] = WorkerThread::Enqueue([rowId] {
+                return BoardStorageAdapter::LoadJournalEntries(rowId);
+            });
+        }
+
+        if (board->loadState != BoardLoadState::Summary)
+            return;
+
+        board->loadState = BoardLoadState::Loading;
+        mPendingLoads[id] = WorkerThread::Enqueue([rowId] {
+            return BoardStorageAdapter::LoadFullBoard(rowId);
+        });
+    }
+
+    bool BoardRepository::LoadNow(BoardId id)
+    {
+        RequestLoad(id);
+
+        auto it = mPendingLoads.find(id);
+        if (it != mPendingLoads.end())
+        {
+            MergeLoad(id, it->second);
+            mPendingLoads.erase(it);
+            EnforceMemoryBudget();
+        }
+
+        const BoardData* board = GetById(id);
+        return board && board->IsLoaded();
+    }
+
+    bool BoardRepository::PollLoads()
+    {
+        // Committed writes mark their entities saved; dropped ones leave them dirty
+        BoardStorageAdapter::ApplyWriteResults(mBoards);
+
+        bool merged = false;
+        for (auto it = mPendingLoads.begin(); it != mPendingLoads.end();)
+        {
+            if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            MergeLoad(it->first, it->second);
+            it = mPendingLoads.erase(it);
+            merged = true;
+        }
+
+        for (auto it = mPendingJournals.begin(); it != mPendingJournals.end();)
+        {
+            if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            MergeJournal(it->first, it->second);
+            it = mPendingJournals.erase(it);
+        }
+
+        if (merged)
+            EnforceMemoryBudget();
+        return merged;
+    }
+
+    void BoardRepository::MergeLoad(BoardId id, std::future<BoardData>& load)
+    {
+        try
+        {
+            BoardData loaded = load.get();
+            BoardData* board = GetById(id);
+            if (!board)
+                return;
+
+            // Only the content is taken; the summary's metadata is as current as the rows
+            board->lists = std::move(loaded.lists);
+            board->loadState = BoardLoadState::Loaded;
+            board->summaryListCount = board->lists.size();
+            board->summaryCardCount = board->GetTotalCardCount();
+            board->RebuildIndex();
+        }
+        catch(const std::exception& e)
+        {
+            GL_ERROR("Failed to load board '{}': {}", id.ToString(), e.what());
+
+            // Back to a summary, so opening the board again retries
+            if (BoardData* board = GetById(id))
+                board->loadState = BoardLoadState::Summary;
+        }
+    }
+
+    void BoardRepository::MergeJournal(
+        BoardId id,
+        std::future<std::vector<Storage::JournalEntryData>>& load
+    )
+    {
+        try
+        {
+            // Decoded here, on the main thread that owns the journal
+            std::vector<Storage::JournalEntryData> rows = load.get();
+            if (GetById(id))
+                UndoJournal::Get().Load(id, rows);
+        }
         catch(const std::exception& e)
         {
-            GL_ERROR("Failed to load boards: {}", e.what());
+            // Not marked loaded, so opening the board again retries
+            GL_ERROR("Failed to load undo history of '{}': {}", id.ToString(), e.what());
+        }
+    }
+
+    void BoardRepository::SetMemoryBudget(size_t bytes)
+    {
+        mMemoryBudget = bytes;
+        EnforceMemoryBudget();
+    }
+
+    void BoardRepository::EnforceMemoryBudget()
+    {
+        struct Candidate
+        {
+            uint64_t lastOpened;
+            size_t slot;
+        };
+
+        BoardMemoryStats stats;
+        stats.budget = mMemoryBudget;
+        stats.evictions = mMemoryStats.evictions;
+        stats.boardBytes.reserve(mBoards.size());
+
+        std::vector<Candidate> candidates;
+        for (size_t i = 0; i < mBoards.size(); ++i)
+        {
+            const BoardData& board = mBoards[i];
+            const size_t bytes = board.ResidentBytes();
+            stats.residentBytes += bytes;
+            stats.boardBytes[board.id] = bytes;
+
+            if (!board.IsLoaded())
+            {
+                ++stats.summaryBoards;
+                continue;
+            }
+            ++stats.loadedBoards;
+
+            auto it = mLastOpened.find(board.id);
+            const uint64_t lastOpened = it != mLastOpened.end() ? it->second : 0;
+            if (mOpenClock == 0 || lastOpened != mOpenClock)
+                candidates.push_back({ lastOpened, i });
         }
+
+        // Least recently opened first; boards never opened (0) go before all others
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.lastOpened < b.lastOpened;
+        });
+
+        for (const Candidate& candidate : candidates)
+        {
+            if (stats.residentBytes <= mMemoryBudget)
+                break;
+
+            // Unsaved edits exist only in memory, so those boards have to stay
+            BoardData& board = mBoards[candidate.slot];
+            if (board.HasUnsavedChanges())
+                continue;
+
+            const size_t before = stats.boardBytes[board.id];
+            board.Unload();
+            const size_t after = board.ResidentBytes();
+
+            stats.residentBytes -= before - after;
+            stats.boardBytes[board.id] = after;
+            --stats.loadedBoards;
+            ++stats.summaryBoards;
+            ++stats.evictions;
+            GL_INFO("Evicted board '{}' ({} KB) to stay within budget", board.title, before >> 10);
+        }
+
+        mMemoryStats = std::move(stats);
     }
 }
@@ -1,12 +1,27 @@
 #pragma once
 #include "BoardData.h"
+#include "storage/Storage.h"
 #include <vector>
 #include <string>
 #include <optional>
 #include <functional>
+#include <future>
+#include <unordered_map>
+#include <cstdint>
 
 namespace Stride
 {
+    // Resident board memory as of the last accounting pass (BoardRepository::EnforceMemoryBudget)
+    struct BoardMemoryStats
+    {
+        size_t budget = 0;
+        size_t residentBytes = 0;
+        size_t loadedBoards = 0;
+        size_t summaryBoards = 0;
+        size_t evictions = 0; // Since startup
+        std::unordered_map<BoardId, size_t> boardBytes;
+    };
+
     /**
      * @brief Data access layer for managing BoardData persistence and lifecycle.
      *
@@ -24,6 +39,28 @@ namespace Stride
      * The repository maintains an in-memory collection of boards and notifies
      * registered observers when boards are created, modified, or deleted.
      *
+     * Boards are loaded in two tiers. LoadAll() only reads summaries (metadata plus list and
+     * card counts), which is all the home view needs; RequestLoad() hydrates one board's lists
+     * and cards on the WorkerThread pool, and PollLoads() merges finished loads on the main
+     * thread. Until then the board reports BoardLoadState::Summary or Loading. Hydration reads
+     * through per-thread read-only connections, so several boards load at once;
+     * LoadAll(LoadMode::Full) uses the same path to hydrate every board up front. The first
+     * RequestLoad() of a board in a session also reads its stored undo steps there, which
+     * PollLoads() hands to the UndoJournal.
+     *
+     * A summary LoadAll() first tries the BoardSnapshot written by SaveSnapshot() on the last
+     * clean exit. While it still matches the database it restores every board, including the
+     * contents of those that were loaded, without a single query.
+     *
+     * Loaded boards count against a memory budget. When a load pushes resident memory past it,
+     * the least recently opened boards without unsaved changes are unloaded back to summaries;
+     * the board opened last is always kept. An evicted board is simply loaded again the next
+     * time it is opened.
+     *
+     * Save() only queues writes on the PersistenceWorker. A board keeps reporting unsaved
+     * changes until PollLoads() hears that they committed, so neither eviction nor the snapshot
+     * can lose an edit whose write failed; the next save queues it again.
+     *
      *
      * @note Thread safety is not currently implemented - all operations should
      *       be performed on the main thread.
@@ -34,36 +71,74 @@ namespace Stride
       public:
         // CRUD operations
         BoardData& Create(const std::string& title);
-        BoardData* GetById(const std::string& id);
-        const BoardData* GetById(const std::string& id) const;
+        BoardData* GetById(BoardId id);
+        const BoardData* GetById(BoardId id) const;
         std::vector<BoardData>& GetAll() { return mBoards; }
         const std::vector<BoardData>& GetAll() const { return mBoards; }
-        bool Delete(const std::string& id);
+        bool Delete(BoardId id);
 
         // Query
-        bool Exists(const std::string& id) const;
+        bool Exists(BoardId id) const;
         size_t Count() const { return mBoards.size(); }
         bool IsEmpty() const { return mBoards.empty(); }
 
         // Events
-        using BoardChangedCallback = std::function<void(const std::string& boardId)>;
+        using BoardChangedCallback = std::function<void(BoardId boardId)>;
         void OnBoardCreated(BoardChangedCallback cb);
         void OnBoardDeleted(BoardChangedCallback cb);
         void OnBoardModified(BoardChangedCallback cb);
 
         // Persistence
-        void LoadAll(); // Load all boards from database
+        enum class LoadMode
+        {
+            Summaries, // Metadata and counts only; boards are hydrated when opened
+            Full       // Every board with its lists and cards, read in parallel
+        };
+        void LoadAll(LoadMode mode = LoadMode::Summaries); // Replace all boards from database
+        bool Save(BoardId id); // Persist changes made since the last save
+        bool SaveSnapshot(); // On exit, once saved: lets the next LoadAll() skip SQLite
+
+        // Hydration of summary boards
+        void RequestLoad(BoardId id); // Mark as opened; start loading if only a summary
+        bool LoadNow(BoardId id);     // Load (or finish loading) before returning
+        bool PollLoads();             // Main thread: merge finished saves and loads
+        bool HasPendingLoads() const { return !mPendingLoads.empty() || !mPendingJournals.empty(); }
+
+        // Memory budget
+        static constexpr size_t kDefaultMemoryBudget = size_t(256) << 20;
+        void SetMemoryBudget(size_t bytes); // Applied immediately
+        size_t GetMemoryBudget() const { return mMemoryBudget; }
+        void EnforceMemoryBudget(); // Recount resident memory and evict down to the budget
+        const BoardMemoryStats& GetMemoryStats() const { return mMemoryStats; }
 
       private:
         std::vector<BoardData> mBoards;
 
+        // BoardId -> index into mBoards; verified on every hit and rebuilt when stale
+        mutable std::unordered_map<BoardId, size_t> mBoardSlots;
+
         std::vector<BoardChangedCallback> mOnCreated;
         std::vector<BoardChangedCallback> mOnDeleted;
         std::vector<BoardChangedCallback> mOnModified;
 
-        std::string GenerateId();
-        void NotifyCreated(const std::string& id);
-        void NotifyDeleted(const std::string& id);
-        void NotifyModified(const std::string& id);
+        // Loads in flight, by board; a board deleted meanwhile just drops its result
+        std::unordered_map<BoardId, std::future<BoardData>> mPendingLoads;
+        std::unordered_map<BoardId, std::future<std::vector<Storage::JournalEntryData>>>
+            mPendingJournals;
+
+        // Eviction order: tick of the last RequestLoad() per board, the highest is on screen
+        std::unordered_map<BoardId, uint64_t> mLastOpened;
+        uint64_t mOpenClock = 0;
+        size_t mMemoryBudget = kDefaultMemoryBudget;
+        BoardMemoryStats mMemoryStats;
+
+        void ReindexBoards() const;
+        void MergeLoad(BoardId id, std::future<BoardData>& load);
+        void MergeJournal(BoardId id, std::future<std::vector<Storage::JournalEntryData>>& load);
+        std::optional<size_t> FindSlot(BoardId id) const;
+
+        void NotifyCreated(BoardId id);
+        void NotifyDeleted(BoardId id);
+        void NotifyModified(BoardId id);
     };
 }
@@ -2,9 +2,12 @@
 #include "BoardViewController.h"
 #include "renderers/CardListRenderer.h"
 #include "managers/DragDropManager.h"
+#include "managers/CardSelection.h"
+#include "managers/UndoJournal.h"
 #include "managers/FontManager.h"
 #include "utilities/ColorPalette.h"
 #include "storage/BoardStorageAdapter.h"
+#include "utilities/FractionalRank.h"
 #include "FontAwesome6.h"
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -14,11 +17,16 @@ namespace Stride
     BoardViewController::BoardViewController(BoardRepository& repository) : mRepository(repository)
     {}
 
-    void BoardViewController::SetActiveBoard(const std::string& id)
+    void BoardViewController::SetActiveBoard(BoardId id)
     {
         mActiveBoardId = id;
         mUIState.Reset();
         mCurrentViewMode = ViewMode::Board;
+        CardSelection::Clear();
+
+        // Summary boards are hydrated in the background; the view shows a placeholder until then.
+        // The board's undo history is read there too, the first time it is opened.
+        mRepository.RequestLoad(id);
     }
 
     BoardData* BoardViewController::GetActiveBoard() { return mRepository.GetById(mActiveBoardId); }
@@ -28,12 +36,14 @@ namespace Stride
         return mRepository.GetById(mActiveBoardId);
     }
 
-    CardListUIState& BoardViewController::GetListUIState(const std::string& listId)
+    bool BoardViewController::SaveActiveBoard() { return mRepository.Save(mActiveBoardId); }
+
+    CardListUIState& BoardViewController::GetListUIState(ListId listId)
     {
         return mListUIStates[listId];
     }
 
-    CardEditorState& BoardViewController::GetEditorState(const std::string& listId)
+    CardEditorState& BoardViewController::GetEditorState(ListId listId)
     {
         return mEditorStates[listId];
     }
@@ -97,6 +107,12 @@ namespace Stride
         }
 
         RenderNavBar();
+        if(!activeBoard->IsLoaded())
+        {
+            RenderLoadingPlaceholder();
+            return;
+        }
+
         RenderBoardContent();
         RenderCreateBoardPopup();
 
@@ -109,6 +125,7 @@ namespace Stride
         if(op.IsPending())
         {
             DragDropManager::PerformDropOperation(activeBoard);
+            SaveActiveBoard();
         }
         FontManager::Pop();
     }
@@ -239,6 +256,33 @@ namespace Stride
         ImGui::PopStyleVar(3);
     }
 
+    void BoardViewController::RenderLoadingPlaceholder()
+    {
+        const BoardData* activeBoard = GetActiveBoard();
+        const float dpiScale = FontManager::GetDpiScale();
+        const ImVec2 available = ImGui::GetContentRegionAvail();
+        const ImVec2 origin = ImGui::GetCursorPos();
+
+        FontManager::Push(FontFamily::Regular, FontSize::Regular);
+        char status[128];
+        snprintf(
+            status,
+            sizeof(status),
+            "Loading %zu lists, %zu cards...",
+            activeBoard->GetListCount(),
+            activeBoard->GetTotalCardCount()
+        );
+        const ImVec2 textSize = ImGui::CalcTextSize(status);
+        ImGui::SetCursorPos(ImVec2(
+            origin.x + (available.x - textSize.x) * 0.5f,
+            origin.y + (available.y - textSize.y) * 0.5f - 20.0f * dpiScale
+        ));
+        ImGui::PushStyleColor(ImGuiCol_Text, ColorPalette::Slate::Shade400);
+        ImGui::Text("%s", status);
+        ImGui::PopStyleColor();
+        FontManager::Pop();
+    }
+
     void BoardViewController::RenderStarterPage()
     {
         const float dpiScale = FontManager::GetDpiScale();
@@ -485,7 +529,7 @@ namespace Stride
             ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 8.0f * dpiScale);
             ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(0, 0));
             
-            if(ImGui::Button(("##board_" + board.id).c_str(), ImVec2(cardWidth, cardHeight)))
+            if(ImGui::Button(("##" + board.id.ToString()).c_str(), ImVec2(cardWidth, cardHeight)))
             {
                 SetActiveBoard(board.id);
             }
@@ -512,7 +556,7 @@ namespace Stride
             // Board stats
             FontManager::Push(FontFamily::Regular, FontSize::Small);
             ImGui::PushStyleColor(ImGuiCol_Text, ColorPalette::Slate::Shade400);
-            ImGui::Text("%zu lists, %zu cards", board.lists.size(), board.GetTotalCardCount());
+            ImGui::Text("%zu lists, %zu cards", board.GetListCount(), board.GetTotalCardCount());
             ImGui::PopStyleColor();
             FontManager::Pop();
             
@@ -585,20 +629,81 @@ namespace Stride
 
         std::vector<CardList>& cardLists = activeBoard->lists;
 
-        // Clear list dropzones at the start
-        if(!cardLists.empty())
+        // Dropzones and list bounds start out empty every frame (FrameArena reset in PreRender)
+
+        if(ImGui::IsKeyPressed(ImGuiKey_Escape) && !ImGui::IsAnyItemActive()
+           && !ImGui::IsPopupOpen(nullptr, ImGuiPopupFlags_AnyPopupId))
+        {
+            CardSelection::Clear();
+        }
+
+        // Undo/redo while nothing is being typed into or dragged
+        if(!ImGui::IsAnyItemActive() && !ImGui::IsPopupOpen(nullptr, ImGuiPopupFlags_AnyPopupId)
+           && !ImGui::GetDragDropPayload() && ImGui::GetIO().KeyCtrl)
         {
-            DragDropManager::GetListDropZones().clear();
+            const bool shift = ImGui::GetIO().KeyShift;
+            bool changed = false;
+            if(ImGui::IsKeyPressed(ImGuiKey_Z) && !shift)
+                changed = UndoJournal::Get().Undo(*activeBoard);
+            else if(ImGui::IsKeyPressed(ImGuiKey_Y) || (ImGui::IsKeyPressed(ImGuiKey_Z) && shift))
+                changed = UndoJournal::Get().Redo(*activeBoard);
+
+            if(changed)
+            {
+                CardSelection::Clear();
+                SaveActiveBoard();
+            }
         }
 
-        // Check if we're dragging a list
+        // Check if we're dragging a list or a card
         const ImGuiPayload* payload = ImGui::GetDragDropPayload();
         int draggingListIndex = -1;
+        ListId cardSourceListId;
         if(payload && payload->IsDataType("LIST_PAYLOAD"))
         {
             const ListDragDropPayload* dragPayload = (const ListDragDropPayload*)payload->Data;
             draggingListIndex = dragPayload->list_index;
         }
+        else if(payload && payload->IsDataType("CARD_PAYLOAD"))
+        {
+            cardSourceListId = ((const DragDropPayload*)payload->Data)->source_list_id;
+        }
+
+        // Edge auto-scroll while dragging. The lists move next frame, so the card drop preview
+        // is hit tested where the cursor will be on the board by then
+        const ImGuiIO& io = ImGui::GetIO();
+        const ImRect boardRect(
+            ImGui::GetWindowPos(),
+            ImGui::GetWindowPos() + ImGui::GetWindowSize()
+        );
+        if(payload && boardRect.Contains(io.MousePos))
+        {
+            const float delta = mUIState.autoScroll.Update(
+                io.MousePos.x,
+                boardRect.Min.x,
+                boardRect.Max.x,
+                io.DeltaTime,
+                dpiScale
+            );
+            const float scrollX = ImGui::GetScrollX();
+            const float target = ImClamp(scrollX + delta, 0.0f, ImGui::GetScrollMaxX());
+            if(target != scrollX)
+            {
+                ImGui::SetScrollX(target);
+                DragDropManager::LeadDropZone(ImVec2(target - scrollX, 0.0f));
+            }
+        }
+        else
+        {
+            mUIState.autoScroll.Reset();
+        }
+
+        // Horizontal culling: only lists overlapping the visible part of the board (plus one
+        // list of margin on each side) are rendered in full
+        const float listStride = cardListWidth + spacingX;
+        const float visibleMinX = ImGui::GetScrollX() - listStride;
+        const float visibleMaxX = ImGui::GetScrollX() + ImGui::GetWindowWidth() + listStride;
+        const ImVec2 listSize(cardListWidth, fullHeight - 20.0f * dpiScale);
 
         // Render all lists (dragged one shows as ghost at current preview position)
         for(int i = 0; i < (int)cardLists.size(); ++i)
@@ -624,17 +729,23 @@ namespace Stride
             bool isBeingDragged
                 = draggingListIndex != -1 && cardLists[i].id == cardLists[draggingListIndex].id;
 
+            // Drag sources, open popups and title edits must keep being submitted while the
+            // list is scrolled away, or ImGui drops their state
+            float listX = startX + (i * listStride);
+            bool isVisible = listX + cardListWidth >= visibleMinX && listX <= visibleMaxX;
+            bool isPinned = isBeingDragged || cardLists[i].id == cardSourceListId
+                            || editorState.isOpen || uiState.isEditingTitle;
+            if(!isVisible && !isPinned)
+            {
+                CardListRenderer::RenderPlaceholder(cardLists[i], listSize);
+                continue;
+            }
+
             if(isBeingDragged)
             {
                 ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.7f);
             }
-            CardListRenderer::Render(
-                cardLists[i],
-                uiState,
-                editorState,
-                i,
-                ImVec2(cardListWidth, fullHeight - 20.0f * dpiScale)
-            );
+            CardListRenderer::Render(cardLists[i], uiState, editorState, i, listSize);
             if(isBeingDragged)
             {
                 ImGui::PopStyleVar();
@@ -659,7 +770,11 @@ namespace Stride
 
         // Perform list drop operation first (before checking if drag ended)
         // This will finalize the position if drop was successful
-        DragDropManager::PerformListDropOperation(activeBoard);
+        if(DragDropManager::GetListDragOperation().IsPending())
+        {
+            DragDropManager::PerformListDropOperation(activeBoard);
+            SaveActiveBoard();
+        }
 
         // Check if drag ended without a drop (cancelled/escaped)
         // Only reset if no pending operation and no payload
@@ -844,8 +959,10 @@ namespace Stride
     {
         if(auto* board = GetActiveBoard())
         {
-            // Get the position for the new list (append to end)
-            int position = static_cast<int>(board->lists.size());
+            // Rank the new list after the current last one
+            double position = board->lists.empty()
+                                  ? FractionalRank::kSpacing
+                                  : board->lists.back().position + FractionalRank::kSpacing;
             
             // Create the list in the database and get back a list with DB-generated ID
             CardList newList = BoardStorageAdapter::CreateList(board->id, title, position);
@@ -861,7 +978,7 @@ namespace Stride
         SetActiveBoard(board.id);
     }
 
-    void BoardViewController::DeleteBoard(const std::string& id)
+    void BoardViewController::DeleteBoard(BoardId id)
     {
         if(mRepository.Delete(id))
         {
@@ -1,6 +1,7 @@
 #pragma once
 #include "BoardRepository.h"
 #include "renderers/CardListRenderer.h"
+#include "utilities/EdgeAutoScroll.h"
 #include <string>
 #include <unordered_map>
 
@@ -31,7 +32,10 @@ namespace Stride
 
         // Delete confirmation
         bool showDeleteConfirm = false;
-        std::string boardToDelete;
+        BoardId boardToDelete;
+
+        // Scrolls the board sideways while a card or list is dragged near its left or right edge
+        EdgeAutoScroll autoScroll;
 
         void Reset()
         {
@@ -40,7 +44,8 @@ namespace Stride
             isCreatingBoard = false;
             memset(newBoardTitleBuffer, 0, sizeof(newBoardTitleBuffer));
             showDeleteConfirm = false;
-            boardToDelete.clear();
+            boardToDelete = {};
+            autoScroll.Reset();
         }
     };
 
@@ -88,10 +93,11 @@ namespace Stride
         ViewMode GetViewMode() const { return mCurrentViewMode; }
 
         // Active board management
-        void SetActiveBoard(const std::string& id);
-        std::string GetActiveBoardId() const { return mActiveBoardId; }
+        void SetActiveBoard(BoardId id);
+        BoardId GetActiveBoardId() const { return mActiveBoardId; }
         BoardData* GetActiveBoard();
         const BoardData* GetActiveBoard() const;
+        bool SaveActiveBoard();
 
         // Render
         void Render();
@@ -100,18 +106,18 @@ namespace Stride
         BoardViewUIState& GetUIState() { return mUIState; }
 
         // Get UI state for a card list
-        CardListUIState& GetListUIState(const std::string& listId);
-        CardEditorState& GetEditorState(const std::string& listId);
+        CardListUIState& GetListUIState(ListId listId);
+        CardEditorState& GetEditorState(ListId listId);
 
       private:
         BoardRepository& mRepository;
-        std::string mActiveBoardId;
+        BoardId mActiveBoardId;
         BoardViewUIState mUIState;
         ViewMode mCurrentViewMode = ViewMode::Home;
 
         // UI state storage for card lists
-        std::unordered_map<std::string, CardListUIState> mListUIStates;
-        std::unordered_map<std::string, CardEditorState> mEditorStates;
+        std::unordered_map<ListId, CardListUIState> mListUIStates;
+        std::unordered_map<ListId, CardEditorState> mEditorStates;
 
         // Render components
         void RenderHomePage();
@@ -120,12 +126,13 @@ namespace Stride
         void RenderBoardContent();
         void RenderBoardSwitcher();
         void RenderStarterPage();
+        void RenderLoadingPlaceholder();
         void RenderCreateBoardPopup();
         void RenderDeleteConfirmPopup();
 
         // Actions
         void CreateList(const std::string& title);
         void CreateBoard(const std::string& title);
-        void DeleteBoard(const std::string& id);
+        void DeleteBoard(BoardId id);
     };
 }
@@ -0,0 +1,499 @@
+#include "pch.h"
+#include "CardSearchIndex.h"
+#include <algorithm>
+
+namespace Stride
+{
+    namespace
+    {
+        constexpr size_t kMaxTokenLength = 64;
+        constexpr size_t kMinFuzzyLength = 4;
+        constexpr float kTitleWeight = 2.0f;
+        constexpr float kExactQuality = 1.0f;
+        constexpr float kPrefixQuality = 0.75f;
+        constexpr float kFuzzyQuality = 0.5f;
+
+        char FoldCase(char c)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        // UTF-8 sequences count as word characters, so non-ASCII words stay whole
+        bool IsWordByte(char c)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            return byte >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')
+                || (c >= 'A' && c <= 'Z');
+        }
+
+        template<typename Fn>
+        void ForEachToken(const std::string& text, Fn&& emit)
+        {
+            std::string token;
+            for(size_t i = 0; i <= text.size(); ++i)
+            {
+                if(i < text.size() && IsWordByte(text[i]))
+                {
+                    if(token.size() < kMaxTokenLength)
+                        token.push_back(FoldCase(text[i]));
+                    continue;
+                }
+                if(!token.empty())
+                {
+                    emit(token);
+                    token.clear();
+                }
+            }
+        }
+
+        std::string FoldBadge(const std::string& badge)
+        {
+            std::string folded(badge);
+            std::transform(folded.begin(), folded.end(), folded.begin(), FoldCase);
+            return folded;
+        }
+
+        // Trigrams of the token padded with '$', so short tokens and word edges get some too
+        template<typename Fn>
+        void ForEachTrigram(const std::string& token, Fn&& emit)
+        {
+            const std::string padded = "$" + token + "$";
+            for(size_t i = 0; i + 3 <= padded.size(); ++i)
+            {
+                emit(
+                    (static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16)
+                    | (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8)
+                    | static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2]))
+                );
+            }
+        }
+
+        // Edit distance counting adjacent transpositions as one edit (optimal string alignment),
+        // or maxEdits + 1 as soon as it is known to exceed maxEdits
+        size_t BoundedEditDistance(const std::string& a, const std::string& b, size_t maxEdits)
+        {
+            const size_t longer = std::max(a.size(), b.size());
+            if(longer - std::min(a.size(), b.size()) > maxEdits)
+                return maxEdits + 1;
+
+            std::vector<size_t> beforePrevious(b.size() + 1), previous(b.size() + 1),
+                current(b.size() + 1);
+            for(size_t j = 0; j <= b.size(); ++j)
+            {
+                previous[j] = j;
+            }
+            for(size_t i = 1; i <= a.size(); ++i)
+            {
+                current[0] = i;
+                size_t rowMin = current[0];
+                for(size_t j = 1; j <= b.size(); ++j)
+                {
+                    const size_t substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+                    current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, substitution });
+                    if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                        current[j] = std::min(current[j], beforePrevious[j - 2] + 1);
+                    rowMin = std::min(rowMin, current[j]);
+                }
+                if(rowMin > maxEdits)
+                    return maxEdits + 1;
+                std::swap(beforePrevious, previous);
+                std::swap(previous, current);
+            }
+            return previous[b.size()];
+        }
+
+        // Cheap fingerprint of which cards a board holds and in what order
+        uint64_t BoardLayout(const BoardData& board)
+        {
+            uint64_t layout = board.lists.size();
+            for(const auto& list : board.lists)
+            {
+                layout = layout * 1099511628211ull ^ list.id.Raw();
+                layout = layout * 1099511628211ull ^ list.LayoutVersion();
+                layout = layout * 1099511628211ull ^ list.cards.size();
+            }
+            return layout;
+        }
+
+        void RemovePosting(std::vector<uint32_t>& postings, uint32_t slot, uint32_t slotMask)
+        {
+            auto it = std::find_if(postings.begin(), postings.end(), [&](uint32_t entry) {
+                return (entry & slotMask) == slot;
+            });
+            if(it == postings.end())
+                return;
+            *it = postings.back();
+            postings.pop_back();
+        }
+    }
+
+    void CardSearchIndex::MarkDirty(BoardId boardId)
+    {
+        mBoards[boardId].dirty = true;
+    }
+
+    void CardSearchIndex::Sync(const std::vector<BoardData>& boards)
+    {
+        ++mEpoch;
+        for(const auto& board : boards)
+        {
+            BoardState& state = mBoards[board.id];
+            state.epoch = mEpoch;
+
+            const uint64_t layout = BoardLayout(board);
+            if(!state.dirty && state.layout == layout)
+                continue;
+
+            SyncBoard(board, state);
+            state.layout = layout;
+            state.dirty = false;
+        }
+
+        // Boards that were deleted, or re-keyed by their first save
+        for(auto it = mBoards.begin(); it != mBoards.end();)
+        {
+            if(it->second.epoch == mEpoch)
+            {
+                ++it;
+                continue;
+            }
+            for(uint32_t slot : it->second.slots)
+            {
+                if(mDocuments[slot].board == it->first)
+                    RemoveDocument(slot);
+            }
+            it = mBoards.erase(it);
+        }
+    }
+
+    void CardSearchIndex::SyncBoard(const BoardData& board, BoardState& state)
+    {
+        std::vector<uint32_t> slots;
+        slots.reserve(state.slots.size());
+
+        for(const auto& list : board.lists)
+        {
+            for(const auto& card : list.cards)
+            {
+                auto [it, inserted] = mDocumentSlots.try_emplace(card.id, 0);
+                if(inserted)
+                {
+                    if(mFreeSlots.empty())
+                    {
+                        it->second = static_cast<uint32_t>(mDocuments.size());
+                        mDocuments.emplace_back();
+                    }
+                    else
+                    {
+                        it->second = mFreeSlots.back();
+                        mFreeSlots.pop_back();
+                    }
+                    mDocuments[it->second].card = card.id;
+                }
+
+                const uint32_t slot = it->second;
+                Document& document = mDocuments[slot];
+                document.board = board.id;
+                document.epoch = mEpoch;
+                if(document.revision != card.changes.revision)
+                    IndexCard(slot, card);
+                slots.push_back(slot);
+            }
+        }
+
+        // Cards no longer on the board; moved ones were claimed by their new board already
+        for(uint32_t slot : state.slots)
+        {
+            const Document& document = mDocuments[slot];
+            if(document.card.IsValid() && document.board == board.id && document.epoch != mEpoch)
+                RemoveDocument(slot);
+        }
+        state.slots = std::move(slots);
+    }
+
+    void CardSearchIndex::IndexCard(uint32_t slot, const Card& card)
+    {
+        ClearPostings(slot);
+
+        // Token -> fields it occurs in
+        std::vector<std::pair<uint32_t, uint32_t>> occurrences;
+        auto collect = [&](const std::string& text, uint32_t field) {
+            ForEachToken(text, [&](const std::string& token) {
+                occurrences.emplace_back(InternToken(token), field);
+            });
+        };
+        collect(card.title, kTitleField);
+        collect(card.description, kBodyField);
+        for(const auto& item : card.checklist)
+        {
+            collect(item.text, kBodyField);
+        }
+        std::sort(occurrences.begin(), occurrences.end());
+
+        Document& document = mDocuments[slot];
+        document.revision = card.changes.revision;
+        for(size_t i = 0; i < occurrences.size();)
+        {
+            const uint32_t token = occurrences[i].first;
+            uint32_t fields = 0;
+            for(; i < occurrences.size() && occurrences[i].first == token; ++i)
+            {
+                fields |= occurrences[i].second;
+            }
+            mPostings[token].push_back(slot | fields);
+            document.tokens.push_back(token);
+        }
+
+        for(const auto& badge : card.badges)
+        {
+            document.badges.push_back(InternBadge(FoldBadge(badge)));
+        }
+        std::sort(document.badges.begin(), document.badges.end());
+        document.badges.erase(
+            std::unique(document.badges.begin(), document.badges.end()),
+            document.badges.end()
+        );
+        for(uint32_t badge : document.badges)
+        {
+            mBadgePostings[badge].push_back(slot);
+        }
+    }
+
+    void CardSearchIndex::ClearPostings(uint32_t slot)
+    {
+        Document& document = mDocuments[slot];
+        for(uint32_t token : document.tokens)
+        {
+            RemovePosting(mPostings[token], slot, kSlotMask);
+        }
+        for(uint32_t badge : document.badges)
+        {
+            RemovePosting(mBadgePostings[badge], slot, kSlotMask);
+        }
+        document.tokens.clear();
+        document.badges.clear();
+    }
+
+    void CardSearchIndex::RemoveDocument(uint32_t slot)
+    {
+        ClearPostings(slot);
+        mDocumentSlots.erase(mDocuments[slot].card);
+        mDocuments[slot] = Document();
+        mFreeSlots.push_back(slot);
+    }
+
+    uint32_t CardSearchIndex::InternToken(const std::string& token)
+    {
+        auto [it, inserted] = mTokenIds.try_emplace(token, static_cast<uint32_t>(mTokens.size()));
+        if(!inserted)
+            return it->second;
+
+        const uint32_t id = it->second;
+        mTokens.push_back(token);
+        mPostings.emplace_back();
+        mOrderedTokens.emplace(token, id);
+
+        std::vector<uint32_t> trigrams;
+        ForEachTrigram(token, [&](uint32_t trigram) { trigrams.push_back(trigram); });
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        for(uint32_t trigram : trigrams)
+        {
+            mTrigrams[trigram].push_back(id);
+        }
+        return id;
+    }
+
+    uint32_t CardSearchIndex::InternBadge(const std::string& badge)
+    {
+        auto [it, inserted] = mBadgeIds.try_emplace(badge, static_cast<uint32_t>(mBadgeIds.size()));
+        if(inserted)
+            mBadgePostings.emplace_back();
+        return it->second;
+    }
+
+    std::vector<CardSearchIndex::TermMatch>
+    CardSearchIndex::MatchTerm(const std::string& term, bool fuzzy) const
+    {
+        std::vector<TermMatch> matches;
+        for(auto it = mOrderedTokens.lower_bound(term);
+            it != mOrderedTokens.end() && it->first.compare(0, term.size(), term) == 0;
+            ++it)
+        {
+            const bool exact = it->first.size() == term.size();
+            matches.push_back({ it->second, exact ? kExactQuality : kPrefixQuality });
+        }
+
+        if(!fuzzy || term.size() < kMinFuzzyLength)
+            return matches;
+
+        // Each edit destroys at most three trigrams (four for a transposition), so a token
+        // within maxEdits of the term shares all but 4 * maxEdits of them
+        const size_t maxEdits = term.size() >= 8 ? 2 : 1;
+        size_t termTrigrams = 0;
+        std::unordered_map<uint32_t, size_t> shared;
+        ForEachTrigram(term, [&](uint32_t trigram) {
+            ++termTrigrams;
+            auto it = mTrigrams.find(trigram);
+            if(it == mTrigrams.end())
+                return;
+            for(uint32_t token : it->second)
+            {
+                ++shared[token];
+            }
+        });
+
+        const size_t needed = termTrigrams > 4 * maxEdits ? termTrigrams - 4 * maxEdits : 1;
+        for(const auto& [token, count] : shared)
+        {
+            const std::string& candidate = mTokens[token];
+            if(count < needed || candidate.compare(0, term.size(), term) == 0)
+                continue;
+            if(BoundedEditDistance(term, candidate, maxEdits) <= maxEdits)
+                matches.push_back({ token, kFuzzyQuality });
+        }
+        return matches;
+    }
+
+    uint32_t CardSearchIndex::NextStamp()
+    {
+        if(++mStamp == 0)
+        {
+            std::fill(mStamps.begin(), mStamps.end(), 0);
+            mStamp = 1;
+        }
+        return mStamp;
+    }
+
+    std::vector<CardSearchHit>
+    CardSearchIndex::Search(const std::vector<BoardData>& boards, const CardSearchQuery& query)
+    {
+        Sync(boards);
+
+        std::vector<CardSearchHit> hits;
+        std::vector<uint32_t> requiredBadges;
+        for(const auto& badge : query.badges)
+        {
+            auto it = mBadgeIds.find(FoldBadge(badge));
+            if(it == mBadgeIds.end())
+                return hits;
+            requiredBadges.push_back(it->second);
+        }
+        std::sort(requiredBadges.begin(), requiredBadges.end());
+
+        // Expand every term first, then intersect starting from the most selective one
+        std::vector<std::pair<size_t, std::vector<TermMatch>>> terms;
+        ForEachToken(query.text, [&](const std::string& term) {
+            std::vector<TermMatch> matches = MatchTerm(term, query.fuzzy);
+            size_t postings = 0;
+            for(const auto& match : matches)
+            {
+                postings += mPostings[match.token].size();
+            }
+            terms.emplace_back(postings, std::move(matches));
+        });
+        std::sort(terms.begin(), terms.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        if(terms.empty() && requiredBadges.empty())
+            return hits;
+
+        if(mStamps.size() < mDocuments.size())
+        {
+            mStamps.resize(mDocuments.size(), 0);
+            mMatchedTerms.resize(mDocuments.size(), 0);
+            mTermScores.resize(mDocuments.size(), 0.0f);
+            mScores.resize(mDocuments.size(), 0.0f);
+        }
+        const uint32_t stamp = NextStamp();
+
+        std::vector<uint32_t> candidates;
+        if(terms.empty())
+        {
+            // Badge-only filter: start from the rarest badge
+            const auto rarest = std::min_element(
+                requiredBadges.begin(),
+                requiredBadges.end(),
+                [&](uint32_t a, uint32_t b) {
+                    return mBadgePostings[a].size() < mBadgePostings[b].size();
+                }
+            );
+            candidates = mBadgePostings[*rarest];
+            for(uint32_t slot : candidates)
+            {
+                mScores[slot] = 0.0f;
+            }
+        }
+
+        for(size_t t = 0; t < terms.size(); ++t)
+        {
+            for(const TermMatch& match : terms[t].second)
+            {
+                for(uint32_t entry : mPostings[match.token])
+                {
+                    const uint32_t slot = entry & kSlotMask;
+                    if(t == 0 && mStamps[slot] != stamp)
+                    {
+                        mStamps[slot] = stamp;
+                        mMatchedTerms[slot] = 0;
+                        mTermScores[slot] = 0.0f;
+                        mScores[slot] = 0.0f;
+                        candidates.push_back(slot);
+                    }
+                    else if(mStamps[slot] != stamp || mMatchedTerms[slot] != t)
+                    {
+                        continue;
+                    }
+
+                    const float weight = (entry & kTitleField) ? kTitleWeight : 1.0f;
+                    mTermScores[slot] = std::max(mTermScores[slot], match.quality * weight);
+                }
+            }
+
+            // Keep the cards that matched this term too
+            size_t kept = 0;
+            for(uint32_t slot : candidates)
+            {
+                if(mTermScores[slot] > 0.0f)
+                {
+                    mScores[slot] += mTermScores[slot];
+                    mTermScores[slot] = 0.0f;
+                    mMatchedTerms[slot] = static_cast<uint32_t>(t + 1);
+                    candidates[kept++] = slot;
+                }
+            }
+            candidates.resize(kept);
+            if(candidates.empty())
+                return hits;
+        }
+
+        for(uint32_t slot : candidates)
+        {
+            const Document& document = mDocuments[slot];
+            if(query.board.IsValid() && document.board != query.board)
+                continue;
+            if(!std::includes(
+                   document.badges.begin(),
+                   document.badges.end(),
+                   requiredBadges.begin(),
+                   requiredBadges.end()
+               ))
+                continue;
+            hits.push_back({ document.card, document.board, mScores[slot] });
+        }
+
+        const size_t count = std::min(query.limit, hits.size());
+        std::partial_sort(
+            hits.begin(),
+            hits.begin() + count,
+            hits.end(),
+            [](const CardSearchHit& a, const CardSearchHit& b) {
+                if(a.score != b.score)
+                    return a.score > b.score;
+                return a.card < b.card;
+            }
+        );
+        hits.resize(count);
+        return hits;
+    }
+}
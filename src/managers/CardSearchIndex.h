@@ -0,0 +1,135 @@
+#pragma once
+#include "BoardData.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stride
+{
+    struct CardSearchQuery
+    {
+        std::string text;                // Every term must match; each also matches as a prefix
+        std::vector<std::string> badges; // Cards must carry all of these (case-insensitive)
+        BoardId board;                   // Invalid searches every board
+        bool fuzzy = true;               // Terms of 4+ characters tolerate 1 typo (2 from 8)
+        size_t limit = 100;
+    };
+
+    struct CardSearchHit
+    {
+        CardId card;
+        BoardId board;
+        float score = 0.0f;
+    };
+
+    /**
+     * @brief In-memory inverted index over the cards of every loaded board.
+     *
+     * Answers search-as-you-type queries without touching SQLite. Card titles, descriptions and
+     * checklist items are split into lowercase tokens; each token keeps a posting list of the
+     * cards containing it, tagged with whether it occurs in the title. Prefix matches walk the
+     * ordered token dictionary, fuzzy matches are found through a trigram index over the
+     * dictionary and confirmed with a bounded edit distance, and badges have postings of their
+     * own so filtering by badge is a lookup.
+     *
+     * The index follows the boards incrementally. Search() re-reads a board only when it was
+     * marked dirty or its card layout changed, and then re-tokenizes only the cards whose
+     * ChangeTracker revision moved, so a keystroke after a one-card edit costs one card.
+     * Cards that disappear (deleted, or re-keyed by their first save) are swept from the index.
+     *
+     * Usage:
+     * @code
+     * CardSearchIndex index;
+     * repository.OnBoardModified([&](BoardId id) { index.MarkDirty(id); });
+     *
+     * CardSearchQuery query;
+     * query.text = "login bu";
+     * query.badges = { "Bug" };
+     * for(const CardSearchHit& hit : index.Search(repository.GetAll(), query))
+     *     ...
+     * @endcode
+     *
+     * @note Main thread only, like the boards it reads.
+     */
+    class CardSearchIndex
+    {
+      public:
+        // Card contents changed without a layout change (edits are followed by a save)
+        void MarkDirty(BoardId boardId);
+
+        std::vector<CardSearchHit>
+        Search(const std::vector<BoardData>& boards, const CardSearchQuery& query);
+
+        // Bring the index up to date with the boards without querying
+        void Sync(const std::vector<BoardData>& boards);
+
+        size_t CardCount() const { return mDocumentSlots.size(); }
+        size_t TokenCount() const { return mTokens.size(); }
+
+      private:
+        static constexpr uint32_t kTitleField = 1u << 30;
+        static constexpr uint32_t kBodyField = 1u << 31;
+        static constexpr uint32_t kSlotMask = kTitleField - 1;
+
+        struct Document
+        {
+            CardId card;
+            BoardId board;
+            uint32_t revision = 0;
+            uint32_t epoch = 0;
+            std::vector<uint32_t> tokens; // Token ids, each listed once
+            std::vector<uint32_t> badges; // Badge ids, sorted
+        };
+
+        struct BoardState
+        {
+            uint64_t layout = 0;
+            bool dirty = true;
+            uint32_t epoch = 0; // Last Sync() that saw the board
+            std::vector<uint32_t> slots;
+        };
+
+        // A dictionary token matched by a query term, and how well
+        struct TermMatch
+        {
+            uint32_t token;
+            float quality;
+        };
+
+        // Documents, addressed by slot; freed slots are reused
+        std::vector<Document> mDocuments;
+        std::vector<uint32_t> mFreeSlots;
+        std::unordered_map<CardId, uint32_t> mDocumentSlots;
+        std::unordered_map<BoardId, BoardState> mBoards;
+        uint32_t mEpoch = 0;
+
+        // Token dictionary. Tokens are never removed; their posting lists just empty out
+        std::vector<std::string> mTokens;
+        std::vector<std::vector<uint32_t>> mPostings; // Slot | field flags, per token
+        std::unordered_map<std::string, uint32_t> mTokenIds;
+        std::map<std::string, uint32_t> mOrderedTokens; // For prefix ranges
+        std::unordered_map<uint32_t, std::vector<uint32_t>> mTrigrams; // Trigram -> tokens
+
+        std::unordered_map<std::string, uint32_t> mBadgeIds;
+        std::vector<std::vector<uint32_t>> mBadgePostings; // Slots, per badge
+
+        // Per-slot scratch for scoring; stamps avoid clearing it between terms and queries
+        std::vector<uint32_t> mStamps;
+        std::vector<uint32_t> mMatchedTerms;
+        std::vector<float> mTermScores;
+        std::vector<float> mScores;
+        uint32_t mStamp = 0;
+
+        void SyncBoard(const BoardData& board, BoardState& state);
+        void IndexCard(uint32_t slot, const Card& card);
+        void RemoveDocument(uint32_t slot);
+        void ClearPostings(uint32_t slot);
+
+        uint32_t InternToken(const std::string& token);
+        uint32_t InternBadge(const std::string& badge);
+        std::vector<TermMatch> MatchTerm(const std::string& term, bool fuzzy) const;
+        uint32_t NextStamp();
+    };
+}
@@ -0,0 +1,47 @@
+#include "pch.h"
+#include "managers/CardSelection.h"
+#include <algorithm>
+
+namespace Stride
+{
+    void CardSelection::Toggle(CardId cardId)
+    {
+        CardSelection& selection = Get();
+        if(!selection.mSelected.erase(cardId))
+            selection.mSelected.insert(cardId);
+        selection.mAnchor = cardId;
+    }
+
+    void CardSelection::SelectRange(const CardList& list, size_t index)
+    {
+        if(index >= list.cards.size())
+            return;
+
+        // Without an anchor in this list the click starts a new range
+        CardSelection& selection = Get();
+        std::optional<size_t> anchor = list.GetCardIndex(selection.mAnchor);
+        if(!anchor)
+        {
+            Toggle(list.cards[index].id);
+            return;
+        }
+
+        const size_t first = std::min(*anchor, index);
+        const size_t last = std::max(*anchor, index);
+        for(size_t i = first; i <= last; ++i)
+        {
+            selection.mSelected.insert(list.cards[i].id);
+        }
+    }
+
+    void CardSelection::Clear()
+    {
+        Get().mSelected.clear();
+        Get().mAnchor = {};
+    }
+
+    std::vector<CardId> CardSelection::GetSelected()
+    {
+        return std::vector<CardId>(Get().mSelected.begin(), Get().mSelected.end());
+    }
+}
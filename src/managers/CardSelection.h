@@ -0,0 +1,42 @@
+#pragma once
+#include "CardList.h"
+#include "EntityId.h"
+#include <unordered_set>
+#include <vector>
+
+namespace Stride
+{
+    /**
+     * @brief Cards picked with Ctrl/Shift-click for batch operations on the active board.
+     *
+     * Ctrl-click toggles a card and makes it the anchor; Shift-click adds the cards between the
+     * anchor and the clicked one when both are in the same list. Dragging a selected card then
+     * moves the whole selection with BoardData::MoveCards. The selection holds IDs, so it
+     * survives reordering; IDs that are no longer on the board are skipped by the move.
+     *
+     * @see DragDropManager::PerformDropOperation
+     */
+    class CardSelection
+    {
+      public:
+        static CardSelection& Get()
+        {
+            static CardSelection instance;
+            return instance;
+        }
+
+        static void Toggle(CardId cardId);
+        static void SelectRange(const CardList& list, size_t index);
+        static void Clear();
+
+        static bool IsSelected(CardId cardId) { return Get().mSelected.count(cardId) > 0; }
+        static size_t Count() { return Get().mSelected.size(); }
+        static std::vector<CardId> GetSelected();
+
+      private:
+        CardSelection() = default;
+
+        std::unordered_set<CardId> mSelected;
+        CardId mAnchor;
+    };
+}
@@ -5,9 +5,34 @@
 #include "managers/DragDropManager.h"
 #include "renderers/CardListRenderer.h"
 #include "renderers/CardRenderer.h"
+#include "managers/CardSelection.h"
+#include "managers/UndoJournal.h"
+#include <algorithm>
 
 namespace Stride
 {
+    namespace
+    {
+        // A zone only replaces a closer-ranked candidate when it is nearer by more than this
+        // (squared pixels), so the preview does not flicker between two equidistant zones
+        constexpr float kTieMargin = 10.0f;
+
+        // Keeps a tracked band clear of float rounding at its boundaries
+        constexpr float kBandMargin = 0.25f;
+
+        bool SameRect(const ImRect& a, const ImRect& b)
+        {
+            return a.Min.x == b.Min.x && a.Min.y == b.Min.y && a.Max.x == b.Max.x
+                   && a.Max.y == b.Max.y;
+        }
+
+        bool SameZone(const Dropzone& a, const Dropzone& b)
+        {
+            return a.list_id == b.list_id && a.insert_index == b.insert_index
+                   && SameRect(a.rect, b.rect);
+        }
+    }
+
     void DragDropManager::DrawTooltipOfDraggedCard(const BoardData* board)
     {
         if(!board)
@@ -19,18 +44,19 @@ namespace Stride
         if(payload_active && global_payload->IsDataType("CARD_PAYLOAD"))
         {
             const DragDropPayload* d = (const DragDropPayload*)global_payload->Data;
-            Card* card = GetCard(board, d->GetSourceListId(), d->card_index);
+            Card* card = GetCard(board, d->source_list_id, d->card_index);
 
             if(card)
             {
                 ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.7f);
                 ImGui::BeginTooltip();
-                std::string preview_id = std::string("preview_tooltip");
                 CardRenderer::Render(
                     *card,
-                    preview_id.c_str(),
+                    "preview_tooltip",
                     false // isDragging false for tooltip to show content
                 );
+                if(d->card_count > 1)
+                    ImGui::Text("%d cards", d->card_count);
                 ImGui::EndTooltip();
                 ImGui::PopStyleVar();
             }
@@ -72,6 +98,24 @@ namespace Stride
         if(insert_index > (int)target_list->CardCount())
             insert_index = (int)target_list->CardCount();
 
+        // A selected card drags the whole selection: one splice per list, kept in board order
+        if(dragOp.card_count > 1)
+        {
+            const std::vector<CardId> selected = CardSelection::GetSelected();
+            auto before = board->CapturePlacements(selected);
+            board->MoveCards(selected, target_list->id, insert_index);
+            UndoJournal::Get().Record(
+                *board,
+                PlaceCardsCommand{ std::move(before), board->CapturePlacements(selected) }
+            );
+            dragOp.Reset();
+            return;
+        }
+
+        // Undo puts the card back at the rank it had
+        const std::vector<CardId> moved = { source_list->cards[dragOp.source_index].id };
+        auto before = board->CapturePlacements(moved);
+
         // Check if moving within the same list
         if(source_list == target_list)
         {
@@ -91,90 +135,223 @@ namespace Stride
             if(move_to_index >= (int)source_list->CardCount())
                 move_to_index = (int)source_list->CardCount() - 1;
 
-            // Use MoveCard for same-list reordering
+            // MoveCard re-ranks only the moved card
             source_list->MoveCard(dragOp.source_index, move_to_index);
-
-            // Update positions to match new array order
-            source_list->UpdateCardPositions();
         }
         else
         {
-            // Moving between different lists
-            // Extract the card
-            Card moved_card = std::move(source_list->cards[dragOp.source_index]);
+            // Moving between different lists: the board keeps its card index in step and
+            // InsertCard ranks the card between its new neighbours, leaving the rest of both
+            // lists at their positions
+            board->MoveCard(moved.front(), target_list->id, insert_index);
+        }
 
-            // Remove from source list
-            source_list->cards.erase(source_list->cards.begin() + dragOp.source_index);
+        UndoJournal::Get().Record(
+            *board,
+            PlaceCardsCommand{ std::move(before), board->CapturePlacements(moved) }
+        );
+        dragOp.Reset();
+    }
 
-            // Insert into target list using CardList method
-            target_list->InsertCard(std::move(moved_card), insert_index);
+    void DragDropManager::UpdateDropZone()
+    {
+        Dropzone* zone = FindCurrentDropzone();
+        Get().mDropZoneLead = ImVec2(0.0f, 0.0f);
+        Get().mHasCurrentDropZone = zone != nullptr;
+        if(zone)
+            Get().mCurrentDropZone = *zone;
+    }
 
-            // Update positions in both lists
-            source_list->UpdateCardPositions();
-            target_list->UpdateCardPositions();
-        }
+    void DragDropManager::RegisterListBounds(ListId list_id, ImRect bounds)
+    {
+        FrameVector<ListBounds>& lists = Get().mListBounds;
+        IM_ASSERT(lists.empty() || lists[lists.size() - 1].rect.Min.x <= bounds.Min.x);
 
-        dragOp.Reset();
+        const int zone_index = (int)Get().mDropZones.size();
+        lists.push_back({ list_id, bounds, zone_index, zone_index });
     }
 
-    void DragDropManager::UpdateDropZone() { Get().mCurrentDropZonePtr = FindCurrentDropzone(); }
+    void DragDropManager::RegisterDropZone(const Dropzone& zone)
+    {
+        FrameVector<Dropzone>& zones = Get().mDropZones;
+        FrameVector<ListBounds>& lists = Get().mListBounds;
+        IM_ASSERT(!lists.empty() && lists[lists.size() - 1].list_id == zone.list_id);
+        IM_ASSERT(
+            zones.empty() || zones[zones.size() - 1].list_id != zone.list_id
+            || zones[zones.size() - 1].rect.Min.y <= zone.rect.Min.y
+        );
+
+        zones.push_back(zone);
+        if(!lists.empty() && lists[lists.size() - 1].list_id == zone.list_id)
+            lists[lists.size() - 1].zone_end = (int)zones.size();
+    }
 
-    void DragDropManager::RegisterListBounds(const std::string& list_id, ImRect bounds)
+    Dropzone* DragDropManager::NearestDropzoneInList(
+        const ListBounds& list,
+        ImVec2 point,
+        float& closest_dist
+    )
     {
-        Get().mListBounds.push_back({ list_id, bounds });
+        Dropzone* first = Get().mDropZones.begin() + list.zone_begin;
+        Dropzone* last = Get().mDropZones.begin() + list.zone_end;
+
+        // The zones span the list's width, so only the two around the point's height can win
+        Dropzone* below = std::lower_bound(first, last, point.y, [](const Dropzone& zone, float y) {
+            return (zone.rect.Min.y + zone.rect.Max.y) * 0.5f < y;
+        });
+
+        Dropzone* closest_zone = nullptr;
+        auto consider = [&](Dropzone* zone) {
+            ImVec2 center = (zone->rect.Min + zone->rect.Max) * 0.5f;
+            float dx = point.x - center.x;
+            float dy = point.y - center.y;
+            float dist = dx * dx + dy * dy;
+
+            if(dist + kTieMargin < closest_dist)
+            {
+                closest_dist = dist;
+                closest_zone = zone;
+            }
+        };
+        if(below != first)
+            consider(below - 1);
+        if(below != last)
+            consider(below);
+        return closest_zone;
     }
 
-    void DragDropManager::ClearListBounds() { Get().mListBounds.clear(); }
+    Dropzone* DragDropManager::HitTestDropzones(ImVec2 point)
+    {
+        FrameVector<ListBounds>& lists = Get().mListBounds;
+
+        // Lists are registered left to right: the one under the point, if any, is the last
+        // one starting at or before it
+        ListBounds* right = std::upper_bound(
+            lists.begin(),
+            lists.end(),
+            point.x,
+            [](float x, const ListBounds& bounds) { return x < bounds.rect.Min.x; }
+        );
+        ListBounds* left = right != lists.begin() ? right - 1 : nullptr;
+
+        float closest_dist = FLT_MAX;
+        if(left && left->rect.Contains(point))
+            return NearestDropzoneInList(*left, point, closest_dist);
+
+        // Between or beside lists: the nearest zone of the closest lists on either side that
+        // have zones (culled lists register none)
+        while(left && left->zone_begin == left->zone_end)
+            left = left != lists.begin() ? left - 1 : nullptr;
+        while(right != lists.end() && right->zone_begin == right->zone_end)
+            ++right;
+
+        Dropzone* closest_zone = nullptr;
+        if(left)
+            closest_zone = NearestDropzoneInList(*left, point, closest_dist);
+        if(right != lists.end())
+        {
+            if(Dropzone* zone = NearestDropzoneInList(*right, point, closest_dist))
+                closest_zone = zone;
+        }
+        return closest_zone;
+    }
 
-    Dropzone* DragDropManager::FindCurrentDropzone()
+    Dropzone* DragDropManager::TrackDropzone(ImVec2 point)
     {
-        DragOperation& dragOp = Get().mDragOperation;
+        FrameVector<ListBounds>& lists = Get().mListBounds;
+        FrameVector<Dropzone>& zones = Get().mDropZones;
+        TrackedDropzone& tracked = Get().mTrackedDropzone;
 
-        if(const ImGuiPayload* payload = ImGui::GetDragDropPayload())
+        if(tracked.valid && point.y > tracked.min_y && point.y < tracked.max_y
+           && tracked.list.rect.Contains(point) && tracked.list_index < (int)lists.size()
+           && tracked.zone_index < (int)zones.size())
         {
-            if(payload->IsDataType("CARD_PAYLOAD"))
-            {
-                ImVec2 mouse = ImGui::GetIO().MousePos;
+            const ListBounds& list = lists[tracked.list_index];
+            const int z = tracked.zone_index;
+            if(list.list_id == tracked.list.list_id && SameRect(list.rect, tracked.list.rect)
+               && list.zone_begin == tracked.list.zone_begin
+               && list.zone_end == tracked.list.zone_end && SameZone(zones[z], tracked.zone)
+               && (!tracked.has_above || SameZone(zones[z - 1], tracked.above))
+               && (!tracked.has_below || SameZone(zones[z + 1], tracked.below)))
+                return &zones[z];
+        }
 
-                // 1. Find which list we are hovering
-                std::string hovered_list_id;
-                for(const auto& bounds : Get().mListBounds)
-                {
-                    if(bounds.rect.Contains(mouse))
-                    {
-                        hovered_list_id = bounds.list_id;
-                        break;
-                    }
-                }
+        tracked.valid = false;
+        Dropzone* zone = HitTestDropzones(point);
+        if(!zone)
+            return nullptr;
 
-                float closest_dist = FLT_MAX;
-                Dropzone* closest_zone = nullptr;
+        // Points between lists are cheap to hit test again; only a point inside a list is
+        // tracked, where the result depends on nothing but the zone and its two neighbours
+        const int z = (int)(zone - zones.begin());
+        ListBounds* list = std::upper_bound(
+                               lists.begin(),
+                               lists.end(),
+                               z,
+                               [](int index, const ListBounds& bounds) {
+                                   return index < bounds.zone_begin;
+                               }
+                           )
+                           - 1;
+        if(!list->rect.Contains(point))
+            return zone;
+
+        // The zones share a center x, so the neighbour that takes over is decided by y alone:
+        // past the midpoint, shifted by the tie margin in favour of the zone checked first
+        const ImVec2 center = (zone->rect.Min + zone->rect.Max) * 0.5f;
+        tracked.has_above = z > list->zone_begin;
+        tracked.has_below = z + 1 < list->zone_end;
+        tracked.min_y = -FLT_MAX;
+        tracked.max_y = FLT_MAX;
+        if(tracked.has_above)
+        {
+            tracked.above = zones[z - 1];
+            const ImVec2 above = (tracked.above.rect.Min + tracked.above.rect.Max) * 0.5f;
+            if(above.x != center.x || above.y >= center.y)
+                return zone;
+            const float boundary
+                = (above.y + center.y) * 0.5f + kTieMargin * 0.5f / (center.y - above.y);
+            tracked.min_y = std::max(boundary, above.y) + kBandMargin;
+        }
+        if(tracked.has_below)
+        {
+            tracked.below = zones[z + 1];
+            const ImVec2 below = (tracked.below.rect.Min + tracked.below.rect.Max) * 0.5f;
+            if(below.x != center.x || below.y <= center.y)
+                return zone;
+            const float boundary
+                = (center.y + below.y) * 0.5f + kTieMargin * 0.5f / (below.y - center.y);
+            tracked.max_y = std::min(boundary, below.y) - kBandMargin;
+        }
 
-                // 2. Filter dropzones by hovered list
-                for(auto& zone : Get().mDropZones)
-                {
-                    // Skip if hovering a list and this zone isn't in it
-                    if(!hovered_list_id.empty() && zone.list_id != hovered_list_id)
-                        continue;
+        tracked.list_index = (int)(list - lists.begin());
+        tracked.zone_index = z;
+        tracked.list = *list;
+        tracked.zone = *zone;
+        tracked.valid = true;
+        return zone;
+    }
 
-                    ImVec2 center = (zone.rect.Min + zone.rect.Max) * 0.5f;
-                    float dx = mouse.x - center.x;
-                    float dy = mouse.y - center.y;
-                    float dist = dx * dx + dy * dy;
+    Dropzone* DragDropManager::FindCurrentDropzone()
+    {
+        DragOperation& dragOp = Get().mDragOperation;
 
-                    if(dist + 10.0f < closest_dist)
-                    {
-                        closest_dist = dist;
-                        closest_zone = &zone;
-                    }
-                }
+        if(const ImGuiPayload* payload = ImGui::GetDragDropPayload())
+        {
+            if(payload->IsDataType("CARD_PAYLOAD"))
+            {
+                // Recomputed only once the cursor, or the zones through scrolling, cross into
+                // another zone's band
+                const ImVec2 point = ImGui::GetIO().MousePos + Get().mDropZoneLead;
+                Dropzone* closest_zone = TrackDropzone(point);
 
-                // 3. Set pending operation if mouse released
+                // Set pending operation if mouse released
                 if(closest_zone && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
                 {
                     const DragDropPayload* d = (const DragDropPayload*)payload->Data;
-                    dragOp.source_list_id = d->GetSourceListId();
+                    dragOp.source_list_id = d->source_list_id;
                     dragOp.source_index = d->card_index;
+                    dragOp.card_count = d->card_count;
                     dragOp.target_list_id = closest_zone->list_id;
                     dragOp.target_index = closest_zone->insert_index;
                     ImGui::ClearDragDrop();
@@ -246,10 +423,9 @@ namespace Stride
         if (!dragOp.IsPending()) return;
 
         // If preview positioning was active, the list is already at the correct position
-        // Just update positions and reset preview tracking
+        // and MoveList has ranked it, so just reset preview tracking
         if (Get().mListPreviewOriginalIndex != -1)
         {
-            board->UpdateListPositions();
             Get().mListPreviewOriginalIndex = -1;
             Get().mListPreviewCurrentIndex = -1;
             dragOp.Reset();
@@ -284,18 +460,18 @@ namespace Stride
         if (move_to_index >= (int)board->lists.size())
             move_to_index = (int)board->lists.size() - 1;
         
-        // Perform the move
+        // Perform the move (re-ranks only the moved list)
         board->MoveList(dragOp.source_index, move_to_index);
-        
-        // Update list positions
-        board->UpdateListPositions();
 
         dragOp.Reset();
     }
 
     void DragDropManager::UpdateListDropZone()
     {
-        Get().mCurrentListDropZonePtr = FindCurrentListDropzone();
+        ListDropzone* zone = FindCurrentListDropzone();
+        Get().mHasCurrentListDropZone = zone != nullptr;
+        if (zone)
+            Get().mCurrentListDropZone = *zone;
     }
 
     ListDropzone* DragDropManager::FindCurrentListDropzone()
@@ -342,8 +518,7 @@ namespace Stride
         return nullptr;
     }
 
-    Card*
-    DragDropManager::GetCard(const BoardData* board, const std::string& list_id, int card_index)
+    Card* DragDropManager::GetCard(const BoardData* board, ListId list_id, int card_index)
     {
         if(!board)
             return nullptr;
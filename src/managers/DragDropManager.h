@@ -3,6 +3,7 @@
 #include "imgui_internal.h"
 #include "managers/DragDropTypes.h"
 #include "BoardData.h"
+#include "utilities/FrameArena.h"
 #include <vector>
 #include <string>
 
@@ -31,40 +32,88 @@ namespace Stride
         // State accessors
         static DragOperation& GetDragOperation() { return Get().mDragOperation; }
         static ListDragOperation& GetListDragOperation() { return Get().mListDragOperation; }
-        static std::vector<Dropzone>& GetDropZones() { return Get().mDropZones; }
-        static std::vector<ListDropzone>& GetListDropZones() { return Get().mListDropZones; }
-        static Dropzone* GetCurrentDropZonePtr() { return Get().mCurrentDropZonePtr; }
-        static ListDropzone* GetCurrentListDropZonePtr() { return Get().mCurrentListDropZonePtr; }
+        // Zones and bounds live on the FrameArena: registered while rendering, gone next frame
+        static FrameVector<Dropzone>& GetDropZones() { return Get().mDropZones; }
+        static FrameVector<ListDropzone>& GetListDropZones() { return Get().mListDropZones; }
+
+        // Copies of the zones hovered last frame, so they outlive the arena reset
+        static Dropzone* GetCurrentDropZonePtr()
+        {
+            return Get().mHasCurrentDropZone ? &Get().mCurrentDropZone : nullptr;
+        }
+        static ListDropzone* GetCurrentListDropZonePtr()
+        {
+            return Get().mHasCurrentListDropZone ? &Get().mCurrentListDropZone : nullptr;
+        }
 
         // Helper - now takes board data
-        static Card* GetCard(const BoardData* board, const std::string& list_id, int card_index);
+        static Card* GetCard(const BoardData* board, ListId list_id, int card_index);
+
+        // List bounds and dropzones, registered while rendering: lists left to right, each
+        // followed by its dropzones top to bottom
+        static void RegisterListBounds(ListId list_id, ImRect bounds);
+        static void RegisterDropZone(const Dropzone& zone);
 
-        // List bounds management
-        static void RegisterListBounds(const std::string& list_id, ImRect bounds);
-        static void ClearListBounds();
+        // Dropzone nearest to a point: in the list under it, else in the lists on either side
+        static Dropzone* HitTestDropzones(ImVec2 point);
+
+        // HitTestDropzones, reusing the previous result while the point stays inside the band
+        // its zone wins and that zone and its neighbours were registered at the same place
+        static Dropzone* TrackDropzone(ImVec2 point);
+
+        // Scroll applied by auto-scroll this frame; the next hit test looks that far ahead
+        static void LeadDropZone(ImVec2 scroll_delta) { Get().mDropZoneLead += scroll_delta; }
 
     private:
         DragDropManager() = default;
 
         struct ListBounds
         {
-            std::string list_id;
+            ListId list_id;
             ImRect rect;
+            int zone_begin; // This list's range in mDropZones
+            int zone_end;
+        };
+
+        // Last TrackDropzone result and what it depended on; zones are matched by value since
+        // they are registered again every frame
+        struct TrackedDropzone
+        {
+            bool valid = false;
+            int list_index = -1;
+            int zone_index = -1;
+            ListBounds list{};
+            Dropzone zone{};
+            Dropzone above{}; // Neighbours in the same list, if has_above / has_below
+            Dropzone below{};
+            bool has_above = false;
+            bool has_below = false;
+            float min_y = 0.0f; // The zone wins for points strictly between these
+            float max_y = 0.0f;
         };
 
         DragOperation mDragOperation;
         ListDragOperation mListDragOperation;
-        std::vector<Dropzone> mDropZones;
-        std::vector<ListDropzone> mListDropZones;
-        std::vector<ListBounds> mListBounds;
-        Dropzone* mCurrentDropZonePtr = nullptr;
-        ListDropzone* mCurrentListDropZonePtr = nullptr;
+        FrameVector<Dropzone> mDropZones;
+        FrameVector<ListDropzone> mListDropZones;
+        FrameVector<ListBounds> mListBounds;
+        Dropzone mCurrentDropZone{};
+        ListDropzone mCurrentListDropZone{};
+        bool mHasCurrentDropZone = false;
+        bool mHasCurrentListDropZone = false;
+        TrackedDropzone mTrackedDropzone;
+        ImVec2 mDropZoneLead{ 0.0f, 0.0f };
         
         // List preview tracking
         int mListPreviewOriginalIndex = -1;
         int mListPreviewCurrentIndex = -1;
 
         static Dropzone* FindCurrentDropzone();
+        static Dropzone* NearestDropzoneInList(
+            const ListBounds& list,
+            ImVec2 point,
+            float& closest_dist
+        );
         static ListDropzone* FindCurrentListDropzone();
     };
 }
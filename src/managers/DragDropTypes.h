@@ -1,67 +1,43 @@
 #pragma once
 #include "imgui.h"
 #include "imgui_internal.h"
-#include <string>
+#include "EntityId.h"
+#include <type_traits>
 
 namespace Stride
 {
+    // ImGui copies payloads byte-wise, so they must stay trivially copyable
     struct DragDropPayload
     {
-        char source_list_id[64];  // Fixed-size for ImGui payload compatibility
+        ListId source_list_id;
         int card_index;
-        
-        // Helper to set from std::string
-        void SetSourceListId(const std::string& id)
-        {
-            size_t len = id.length();
-            if (len >= sizeof(source_list_id))
-                len = sizeof(source_list_id) - 1;
-            memcpy(source_list_id, id.c_str(), len);
-            source_list_id[len] = '\0';
-        }
-        
-        // Helper to get as std::string
-        std::string GetSourceListId() const
-        {
-            return std::string(source_list_id);
-        }
+        int card_count; // > 1 when the card drags the whole CardSelection along
     };
 
     struct ListDragDropPayload
     {
-        char list_id[64];  // Fixed-size for ImGui payload compatibility
+        ListId list_id;
         int list_index;
-        
-        // Helper to set from std::string
-        void SetListId(const std::string& id)
-        {
-            size_t len = id.length();
-            if (len >= sizeof(list_id))
-                len = sizeof(list_id) - 1;
-            memcpy(list_id, id.c_str(), len);
-            list_id[len] = '\0';
-        }
-        
-        // Helper to get as std::string
-        std::string GetListId() const
-        {
-            return std::string(list_id);
-        }
     };
 
+    static_assert(std::is_trivially_copyable_v<DragDropPayload>);
+    static_assert(std::is_trivially_copyable_v<ListDragDropPayload>);
+
     struct DragOperation
     {
-        std::string source_list_id = "";
+        ListId source_list_id;
         int source_index = -1;
-        std::string target_list_id = "";
+        ListId target_list_id;
         int target_index = -1;
-        bool IsPending() const { return !source_list_id.empty(); }
+        int card_count = 1;
+        bool IsPending() const { return source_list_id.IsValid(); }
         void Reset()
         {
-            source_list_id = "";
+            source_list_id = {};
             source_index = -1;
-            target_list_id = "";
+            target_list_id = {};
             target_index = -1;
+            card_count = 1;
         }
     };
 
@@ -80,7 +56,7 @@ namespace Stride
     struct Dropzone
     {
         ImRect rect;
-        std::string list_id;
+        ListId list_id;
         int insert_index;
     };
 
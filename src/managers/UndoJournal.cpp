@@ -0,0 +1,848 @@
+#include "pch.h"
+#include "UndoJournal.h"
+#include "storage/PersistenceWorker.h"
+#include "storage/StorageManager.h"
+#include "utilities/MemoryUsage.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
+
+namespace Stride
+{
+    namespace
+    {
+        // Payload encoding: fixed-size fields in native byte order, strings and arrays prefixed
+        // with a 32-bit count, entities by row ID. A transient ID cannot be stored.
+        class PayloadWriter
+        {
+          public:
+            explicit PayloadWriter(std::vector<char>& bytes) : mBytes(bytes) {}
+
+            bool ok = true;
+
+            template<typename T>
+            void Put(T value)
+            {
+                static_assert(std::is_arithmetic_v<T>);
+                const char* raw = reinterpret_cast<const char*>(&value);
+                mBytes.insert(mBytes.end(), raw, raw + sizeof(T));
+            }
+
+            void Put(const std::string& text)
+            {
+                Put(static_cast<uint32_t>(text.size()));
+                mBytes.insert(mBytes.end(), text.begin(), text.end());
+            }
+
+            template<EntityKind Kind>
+            void Put(EntityId<Kind> id)
+            {
+                ok &= id.IsPersisted();
+                Put(static_cast<int32_t>(id.RowId()));
+            }
+
+          private:
+            std::vector<char>& mBytes;
+        };
+
+        class PayloadReader
+        {
+          public:
+            explicit PayloadReader(const std::vector<char>& bytes) : mBytes(bytes) {}
+
+            bool ok = true;
+
+            bool AtEnd() const { return mOffset == mBytes.size(); }
+
+            template<typename T>
+            void Get(T& value)
+            {
+                static_assert(std::is_arithmetic_v<T>);
+                if(!Take(sizeof(T)))
+                    return;
+                std::memcpy(&value, mBytes.data() + mOffset - sizeof(T), sizeof(T));
+            }
+
+            void Get(std::string& text)
+            {
+                uint32_t size = 0;
+                Get(size);
+                if(!Take(size))
+                    return;
+                text.assign(mBytes.data() + mOffset - size, size);
+            }
+
+            template<EntityKind Kind>
+            void Get(EntityId<Kind>& id)
+            {
+                int32_t row = 0;
+                Get(row);
+                id = EntityId<Kind>::FromRow(row);
+                ok &= id.IsValid();
+            }
+
+            // Element count of an array, bounded by the bytes left so a corrupt count fails
+            uint32_t Count(size_t minElementSize)
+            {
+                uint32_t count = 0;
+                Get(count);
+                if(ok && static_cast<size_t>(count) * minElementSize > mBytes.size() - mOffset)
+                    ok = false;
+                return ok ? count : 0;
+            }
+
+          private:
+            const std::vector<char>& mBytes;
+            size_t mOffset = 0;
+
+            bool Take(size_t size)
+            {
+                ok = ok && size <= mBytes.size() - mOffset;
+                if(ok)
+                    mOffset += size;
+                return ok;
+            }
+        };
+
+        void Write(PayloadWriter& out, const std::vector<CardPlacement>& placements)
+        {
+            out.Put(static_cast<uint32_t>(placements.size()));
+            for(const CardPlacement& placement : placements)
+            {
+                out.Put(placement.cardId);
+                out.Put(placement.listId);
+                out.Put(placement.position);
+            }
+        }
+
+        void Read(PayloadReader& in, std::vector<CardPlacement>& placements)
+        {
+            placements.resize(in.Count(16));
+            for(CardPlacement& placement : placements)
+            {
+                in.Get(placement.cardId);
+                in.Get(placement.listId);
+                in.Get(placement.position);
+            }
+        }
+
+        void Write(PayloadWriter& out, const std::vector<std::string>& badges)
+        {
+            out.Put(static_cast<uint32_t>(badges.size()));
+            for(const std::string& badge : badges)
+            {
+                out.Put(badge);
+            }
+        }
+
+        void Read(PayloadReader& in, std::vector<std::string>& badges)
+        {
+            badges.resize(in.Count(4));
+            for(std::string& badge : badges)
+            {
+                in.Get(badge);
+            }
+        }
+
+        void Write(PayloadWriter& out, const std::vector<ChecklistItem>& checklist)
+        {
+            out.Put(static_cast<uint32_t>(checklist.size()));
+            for(const ChecklistItem& item : checklist)
+            {
+                out.Put(item.id);
+                out.Put(item.text);
+                out.Put(static_cast<uint8_t>(item.isChecked));
+            }
+        }
+
+        void Read(PayloadReader& in, std::vector<ChecklistItem>& checklist)
+        {
+            checklist.resize(in.Count(9));
+            for(ChecklistItem& item : checklist)
+            {
+                uint8_t checked = 0;
+                in.Get(item.id);
+                in.Get(item.text);
+                in.Get(checked);
+                item.isChecked = checked != 0;
+            }
+        }
+
+        void Write(PayloadWriter& out, const CardContent& content)
+        {
+            out.Put(content.title);
+            out.Put(content.description);
+            Write(out, content.badges);
+            Write(out, content.checklist);
+        }
+
+        void Read(PayloadReader& in, CardContent& content)
+        {
+            in.Get(content.title);
+            in.Get(content.description);
+            Read(in, content.badges);
+            Read(in, content.checklist);
+        }
+
+        void Write(PayloadWriter& out, const Card& card)
+        {
+            out.Put(card.id);
+            out.Put(card.position);
+            out.Put(card.coverImage);
+            out.Put(static_cast<int64_t>(card.dueDate));
+            out.Put(static_cast<uint8_t>(card.isCompleted));
+            Write(out, CardContent::Of(card));
+        }
+
+        void Read(PayloadReader& in, Card& card)
+        {
+            int64_t dueDate = 0;
+            uint8_t completed = 0;
+            CardContent content;
+            in.Get(card.id);
+            in.Get(card.position);
+            in.Get(card.coverImage);
+            in.Get(dueDate);
+            in.Get(completed);
+            Read(in, content);
+            card.dueDate = static_cast<time_t>(dueDate);
+            card.isCompleted = completed != 0;
+            content.ApplyTo(card);
+        }
+
+        std::vector<char> Encode(const UndoCommand& command, bool& ok)
+        {
+            std::vector<char> bytes;
+            PayloadWriter out(bytes);
+            std::visit(
+                [&](const auto& c) {
+                    using T = std::decay_t<decltype(c)>;
+                    if constexpr(std::is_same_v<T, PlaceCardsCommand>)
+                    {
+                        Write(out, c.before);
+                        Write(out, c.after);
+                    }
+                    else if constexpr(std::is_same_v<T, RemoveCardCommand>)
+                    {
+                        out.Put(c.listId);
+                        Write(out, c.card);
+                    }
+                    else if constexpr(std::is_same_v<T, ToggleChecklistItemCommand>)
+                    {
+                        out.Put(c.cardId);
+                        out.Put(c.itemId);
+                    }
+                    else if constexpr(std::is_same_v<T, RenameListCommand>)
+                    {
+                        out.Put(c.listId);
+                        out.Put(c.before);
+                        out.Put(c.after);
+                    }
+                    else if constexpr(std::is_same_v<T, EditCardCommand>)
+                    {
+                        out.Put(c.cardId);
+                        Write(out, c.before);
+                        Write(out, c.after);
+                    }
+                },
+                command
+            );
+            ok = out.ok;
+            return bytes;
+        }
+
+        template<typename T>
+        bool DecodeAs(const std::vector<char>& bytes, UndoCommand& command)
+        {
+            T c;
+            PayloadReader in(bytes);
+            if constexpr(std::is_same_v<T, PlaceCardsCommand>)
+            {
+                Read(in, c.before);
+                Read(in, c.after);
+            }
+            else if constexpr(std::is_same_v<T, RemoveCardCommand>)
+            {
+                in.Get(c.listId);
+                Read(in, c.card);
+            }
+            else if constexpr(std::is_same_v<T, ToggleChecklistItemCommand>)
+            {
+                in.Get(c.cardId);
+                in.Get(c.itemId);
+            }
+            else if constexpr(std::is_same_v<T, RenameListCommand>)
+            {
+                in.Get(c.listId);
+                in.Get(c.before);
+                in.Get(c.after);
+            }
+            else if constexpr(std::is_same_v<T, EditCardCommand>)
+            {
+                in.Get(c.cardId);
+                Read(in, c.before);
+                Read(in, c.after);
+            }
+
+            if(!in.ok || !in.AtEnd())
+                return false;
+            command = std::move(c);
+            return true;
+        }
+
+        // The kind column stores the command's index in UndoCommand, plus one
+        template<size_t Index = 0>
+        bool Decode(size_t index, const std::vector<char>& bytes, UndoCommand& command)
+        {
+            if constexpr(Index < std::variant_size_v<UndoCommand>)
+            {
+                if(index == Index)
+                    return DecodeAs<std::variant_alternative_t<Index, UndoCommand>>(bytes, command);
+                return Decode<Index + 1>(index, bytes, command);
+            }
+            else
+                return false;
+        }
+
+        bool SamePlacements(
+            const std::vector<CardPlacement>& a,
+            const std::vector<CardPlacement>& b
+        )
+        {
+            return std::equal(
+                a.begin(),
+                a.end(),
+                b.begin(),
+                b.end(),
+                [](const CardPlacement& x, const CardPlacement& y) {
+                    return x.cardId == y.cardId && x.listId == y.listId
+                           && x.position == y.position;
+                }
+            );
+        }
+
+        // Commands that change nothing are not worth a step
+        bool IsNoOp(const UndoCommand& command)
+        {
+            if(auto* place = std::get_if<PlaceCardsCommand>(&command))
+                return SamePlacements(place->before, place->after);
+            if(auto* rename = std::get_if<RenameListCommand>(&command))
+                return rename->before == rename->after;
+            if(auto* edit = std::get_if<EditCardCommand>(&command))
+                return edit->before.SameAs(edit->after);
+            return false;
+        }
+
+        // Fold `next` into `last` when both edit the same text; false if they cannot merge
+        bool Coalesce(UndoCommand& last, UndoCommand& next)
+        {
+            if(auto* rename = std::get_if<RenameListCommand>(&last))
+            {
+                auto* nextRename = std::get_if<RenameListCommand>(&next);
+                if(!nextRename || nextRename->listId != rename->listId)
+                    return false;
+                rename->after = std::move(nextRename->after);
+                return true;
+            }
+            if(auto* edit = std::get_if<EditCardCommand>(&last))
+            {
+                auto* nextEdit = std::get_if<EditCardCommand>(&next);
+                if(!nextEdit || nextEdit->cardId != edit->cardId)
+                    return false;
+                edit->after = std::move(nextEdit->after);
+                return true;
+            }
+            return false;
+        }
+
+        bool Apply(BoardData& board, const UndoCommand& command, bool undo)
+        {
+            return std::visit(
+                [&](const auto& c) -> bool {
+                    using T = std::decay_t<decltype(c)>;
+                    if constexpr(std::is_same_v<T, PlaceCardsCommand>)
+                    {
+                        // All or nothing: a half-applied step could be neither retried nor undone
+                        const auto& placements = undo ? c.before : c.after;
+                        for(const CardPlacement& placement : placements)
+                        {
+                            if(!board.FindCard(placement.cardId))
+                                return false;
+                            if(!board.FindList(placement.listId))
+                                return false;
+                        }
+                        return board.PlaceCards(placements) == placements.size();
+                    }
+                    else if constexpr(std::is_same_v<T, RemoveCardCommand>)
+                    {
+                        if(!undo)
+                        {
+                            auto [list, card] = board.FindCardWithList(c.card.id);
+                            if(!card)
+                                return false;
+                            list->RemoveCard(c.card.id);
+                            return true;
+                        }
+
+                        CardList* list = board.FindList(c.listId);
+                        if(!list || board.FindCard(c.card.id))
+                            return false;
+
+                        // A deletion not saved yet is simply dropped; otherwise the card is
+                        // written again as dirty
+                        auto& removed = list->removedCardIds;
+                        removed.erase(
+                            std::remove(removed.begin(), removed.end(), c.card.id),
+                            removed.end()
+                        );
+                        std::vector<Card> restored;
+                        restored.push_back(c.card);
+                        for(ChecklistItem& item : restored.front().checklist)
+                        {
+                            item.changes.Touch();
+                        }
+                        list->PlaceCards(std::move(restored));
+                        return true;
+                    }
+                    else if constexpr(std::is_same_v<T, ToggleChecklistItemCommand>)
+                    {
+                        auto [list, card] = board.FindCardWithList(c.cardId);
+                        if(!card || !card->FindChecklistItem(c.itemId))
+                            return false;
+                        card->ToggleChecklistItem(c.itemId);
+                        list->TouchLayout();
+                        return true;
+                    }
+                    else if constexpr(std::is_same_v<T, RenameListCommand>)
+                    {
+                        CardList* list = board.FindList(c.listId);
+                        if(!list)
+                            return false;
+                        list->title = undo ? c.before : c.after;
+                        list->changes.Touch();
+                        return true;
+                    }
+                    else if constexpr(std::is_same_v<T, EditCardCommand>)
+                    {
+                        auto [list, card] = board.FindCardWithList(c.cardId);
+                        if(!card)
+                            return false;
+                        (undo ? c.before : c.after).ApplyTo(*card);
+                        list->TouchLayout();
+                        return true;
+                    }
+                },
+                command
+            );
+        }
+
+        size_t CommandHeapBytes(const UndoCommand& command)
+        {
+            return std::visit(
+                [](const auto& c) -> size_t {
+                    using T = std::decay_t<decltype(c)>;
+                    if constexpr(std::is_same_v<T, PlaceCardsCommand>)
+                        return MemoryUsage::HeapBytes(c.before) + MemoryUsage::HeapBytes(c.after);
+                    else if constexpr(std::is_same_v<T, RemoveCardCommand>)
+                        return c.card.HeapBytes();
+                    else if constexpr(std::is_same_v<T, RenameListCommand>)
+                        return MemoryUsage::HeapBytes(c.before) + MemoryUsage::HeapBytes(c.after);
+                    else if constexpr(std::is_same_v<T, EditCardCommand>)
+                        return c.before.HeapBytes() + c.after.HeapBytes();
+                    else
+                        return 0;
+                },
+                command
+            );
+        }
+
+        std::string JournalKey(int rowId) { return "journal:" + std::to_string(rowId); }
+    }
+
+    CardContent CardContent::Of(const Card& card)
+    {
+        return { card.title, card.description, card.badges, card.checklist };
+    }
+
+    void CardContent::ApplyTo(Card& card) const
+    {
+        card.title = title;
+        card.description = description;
+        card.badges = badges;
+        card.SetChecklist(checklist);
+    }
+
+    bool CardContent::SameAs(const CardContent& other) const
+    {
+        return title == other.title && description == other.description
+               && badges == other.badges
+               && std::equal(
+                   checklist.begin(),
+                   checklist.end(),
+                   other.checklist.begin(),
+                   other.checklist.end(),
+                   [](const ChecklistItem& a, const ChecklistItem& b) {
+                       return a.id == b.id && a.text == b.text && a.isChecked == b.isChecked;
+                   }
+               );
+    }
+
+    size_t CardContent::HeapBytes() const
+    {
+        size_t bytes = MemoryUsage::HeapBytes(title) + MemoryUsage::HeapBytes(description)
+                       + MemoryUsage::HeapBytes(badges) + MemoryUsage::HeapBytes(checklist);
+        for(const auto& item : checklist)
+        {
+            bytes += MemoryUsage::HeapBytes(item.text);
+        }
+        return bytes;
+    }
+
+    UndoJournal::Step UndoJournal::MakeStep(UndoCommand command) const
+    {
+        Step step;
+        step.command = std::move(command);
+        step.recordedAt = std::chrono::steady_clock::now();
+        step.bytes = sizeof(Step) + CommandHeapBytes(step.command);
+        return step;
+    }
+
+    void UndoJournal::Record(const BoardData& board, UndoCommand command)
+    {
+        if(IsNoOp(command))
+            return;
+
+        History& history = mHistories[board.id];
+
+        // A new edit forks the history: the redo steps can no longer be reached
+        while(history.steps.size() > history.cursor)
+        {
+            DropStep(history, history.steps.size() - 1);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if(!history.steps.empty() && now - history.steps.back().recordedAt < kCoalesceWindow)
+        {
+            Step& last = history.steps.back();
+            if(Coalesce(last.command, command))
+            {
+                last.recordedAt = now;
+                last.persisted = false;
+                mBytes -= last.bytes;
+                last.bytes = sizeof(Step) + CommandHeapBytes(last.command);
+                mBytes += last.bytes;
+
+                // Typed back to where it started
+                if(IsNoOp(last.command))
+                {
+                    DropStep(history, history.steps.size() - 1);
+                    history.cursor = history.steps.size();
+                }
+                return;
+            }
+        }
+
+        history.steps.push_back(MakeStep(std::move(command)));
+        history.cursor = history.steps.size();
+        mBytes += history.steps.back().bytes;
+        Trim(history);
+    }
+
+    bool UndoJournal::Undo(BoardData& board)
+    {
+        auto found = mHistories.find(board.id);
+        if(found == mHistories.end() || found->second.cursor == 0)
+            return false;
+
+        History& history = found->second;
+        const size_t index = history.cursor - 1;
+        if(!Apply(board, history.steps[index].command, true))
+        {
+            GL_WARN("Undo step no longer matches board '{}', dropping it", board.title);
+            DropStep(history, index);
+            history.cursor = index;
+            return false;
+        }
+
+        history.cursor = index;
+        history.steps[index].persisted = false;
+        return true;
+    }
+
+    bool UndoJournal::Redo(BoardData& board)
+    {
+        auto found = mHistories.find(board.id);
+        if(found == mHistories.end() || found->second.cursor >= found->second.steps.size())
+            return false;
+
+        History& history = found->second;
+        const size_t index = history.cursor;
+        if(!Apply(board, history.steps[index].command, false))
+        {
+            // Everything after it builds on this step
+            GL_WARN("Redo step no longer matches board '{}', dropping the redo steps", board.title);
+            while(history.steps.size() > index)
+            {
+                DropStep(history, history.steps.size() - 1);
+            }
+            return false;
+        }
+
+        history.cursor = index + 1;
+        history.steps[index].persisted = false;
+        return true;
+    }
+
+    size_t UndoJournal::UndoCount(BoardId boardId) const
+    {
+        auto found = mHistories.find(boardId);
+        return found != mHistories.end() ? found->second.cursor : 0;
+    }
+
+    size_t UndoJournal::RedoCount(BoardId boardId) const
+    {
+        auto found = mHistories.find(boardId);
+        return found != mHistories.end() ? found->second.steps.size() - found->second.cursor
+                                         : 0;
+    }
+
+    void UndoJournal::SetMemoryLimit(size_t bytes)
+    {
+        mMemoryLimit = bytes;
+        for(auto& [boardId, history] : mHistories)
+        {
+            Trim(history);
+        }
+    }
+
+    void UndoJournal::DropStep(History& history, size_t index)
+    {
+        Step& step = history.steps[index];
+        if(step.rowId != 0)
+            history.deletedRows.push_back(step.rowId);
+        mBytes -= step.bytes;
+        history.steps.erase(history.steps.begin() + index);
+        if(index < history.cursor)
+            --history.cursor;
+    }
+
+    bool UndoJournal::TrimOne(History& history)
+    {
+        if(history.steps.empty())
+            return false;
+
+        // The oldest undo step goes first; without one, the redo step furthest away
+        DropStep(history, history.cursor > 0 ? 0 : history.steps.size() - 1);
+        return true;
+    }
+
+    void UndoJournal::Trim(History& current)
+    {
+        // Other boards give up their steps before the one being edited
+        for(auto& [boardId, history] : mHistories)
+        {
+            while(mBytes > mMemoryLimit && &history != &current && TrimOne(history))
+            {}
+        }
+        while(mBytes > mMemoryLimit && TrimOne(current))
+        {}
+    }
+
+    void UndoJournal::ResolveIds(UndoCommand& command, const AssignedIds& assigned)
+    {
+        std::visit(
+            [&](auto& c) {
+                using T = std::decay_t<decltype(c)>;
+                auto resolveChecklist = [&](std::vector<ChecklistItem>& checklist) {
+                    for(ChecklistItem& item : checklist)
+                    {
+                        Resolve(item.id, assigned);
+                    }
+                };
+
+                if constexpr(std::is_same_v<T, PlaceCardsCommand>)
+                {
+                    for(auto* placements : { &c.before, &c.after })
+                    {
+                        for(CardPlacement& placement : *placements)
+                        {
+                            Resolve(placement.cardId, assigned);
+                            Resolve(placement.listId, assigned);
+                        }
+                    }
+                }
+                else if constexpr(std::is_same_v<T, RemoveCardCommand>)
+                {
+                    Resolve(c.listId, assigned);
+                    Resolve(c.card.id, assigned);
+                    resolveChecklist(c.card.checklist);
+                }
+                else if constexpr(std::is_same_v<T, ToggleChecklistItemCommand>)
+                {
+                    Resolve(c.cardId, assigned);
+                    Resolve(c.itemId, assigned);
+                }
+                else if constexpr(std::is_same_v<T, RenameListCommand>)
+                {
+                    Resolve(c.listId, assigned);
+                }
+                else if constexpr(std::is_same_v<T, EditCardCommand>)
+                {
+                    Resolve(c.cardId, assigned);
+                    resolveChecklist(c.before.checklist);
+                    resolveChecklist(c.after.checklist);
+                }
+            },
+            command
+        );
+    }
+
+    void UndoJournal::Persist(const BoardData& board, const AssignedIds& assigned)
+    {
+        // A board's history is keyed by its ID, transient until the first save
+        for(auto it = mHistories.begin(); it != mHistories.end(); ++it)
+        {
+            auto row = assigned.find(it->first.Raw());
+            if(row != assigned.end() && !it->first.IsPersisted())
+            {
+                History moved = std::move(it->second);
+                mHistories.erase(it);
+                mHistories[BoardId::FromRow(row->second)] = std::move(moved);
+                break;
+            }
+        }
+
+        auto found = mHistories.find(board.id);
+        const int boardRow = board.id.RowId();
+        if(found == mHistories.end() || boardRow == 0)
+            return;
+
+        History& history = found->second;
+        const int64_t now = static_cast<int64_t>(time(nullptr));
+        for(size_t i = 0; i < history.steps.size(); ++i)
+        {
+            Step& step = history.steps[i];
+            ResolveIds(step.command, assigned);
+            if(step.persisted)
+                continue;
+
+            // Steps naming an entity that was never saved stay in memory only
+            bool encoded = false;
+            Storage::JournalEntryData row;
+            row.payload = Encode(step.command, encoded);
+            if(!encoded)
+                continue;
+
+            if(step.rowId == 0)
+                step.rowId = StorageManager::ReserveId<Storage::JournalEntryData>();
+            row.id = step.rowId;
+            row.board_id = boardRow;
+            row.kind = static_cast<int>(step.command.index()) + 1;
+            row.undone = i >= history.cursor;
+            row.created_at = now;
+            PersistenceWorker::Submit(JournalKey(row.id), [row = std::move(row)] {
+                StorageManager::UpsertJournalEntry(row);
+            });
+            step.persisted = true;
+        }
+
+        // Supersedes a still pending write of the same row
+        for(int rowId : history.deletedRows)
+        {
+            PersistenceWorker::Submit(JournalKey(rowId), [rowId] {
+                StorageManager::DeleteJournalEntry(rowId);
+            });
+        }
+        history.deletedRows.clear();
+    }
+
+    void UndoJournal::Load(BoardId boardId, const std::vector<Storage::JournalEntryData>& rows)
+    {
+        History& history = mHistories[boardId];
+        if(history.loaded)
+            return;
+        history.loaded = true;
+
+        // Rows this session already knows: written by a save since the board was opened
+        std::unordered_set<int> known(history.deletedRows.begin(), history.deletedRows.end());
+        for(const Step& step : history.steps)
+        {
+            if(step.rowId != 0)
+                known.insert(step.rowId);
+        }
+
+        History stored;
+        for(const Storage::JournalEntryData& row : rows)
+        {
+            if(known.count(row.id))
+                continue;
+
+            UndoCommand command;
+            const size_t index = static_cast<size_t>(row.kind - 1);
+            if(row.kind < 1 || !Decode(index, row.payload, command))
+            {
+                GL_WARN("Dropping unreadable undo step {} of '{}'", row.id, boardId.ToString());
+                history.deletedRows.push_back(row.id);
+                continue;
+            }
+
+            Step step = MakeStep(std::move(command));
+            step.recordedAt = {}; // Never coalesces with a new edit
+            step.rowId = row.id;
+            step.persisted = true;
+            if(!row.undone && stored.cursor == stored.steps.size())
+                stored.cursor = stored.steps.size() + 1;
+            else if(!row.undone)
+                step.persisted = false; // Done after an undone step: becomes a redo step
+
+            mBytes += step.bytes;
+            stored.steps.push_back(std::move(step));
+        }
+
+        // An edit recorded in the meantime already forked the history past the stored redo steps
+        if(!history.steps.empty())
+        {
+            while(stored.steps.size() > stored.cursor)
+            {
+                DropStep(stored, stored.steps.size() - 1);
+            }
+        }
+
+        // Stored steps are older than anything recorded this session
+        history.cursor += stored.cursor;
+        history.steps.insert(
+            history.steps.begin(),
+            std::make_move_iterator(stored.steps.begin()),
+            std::make_move_iterator(stored.steps.end())
+        );
+        history.deletedRows.insert(
+            history.deletedRows.end(),
+            stored.deletedRows.begin(),
+            stored.deletedRows.end()
+        );
+        Trim(history);
+    }
+
+    bool UndoJournal::IsLoaded(BoardId boardId) const
+    {
+        auto found = mHistories.find(boardId);
+        return found != mHistories.end() && found->second.loaded;
+    }
+
+    void UndoJournal::Forget(BoardId boardId)
+    {
+        auto found = mHistories.find(boardId);
+        if(found == mHistories.end())
+            return;
+
+        for(const Step& step : found->second.steps)
+        {
+            mBytes -= step.bytes;
+        }
+        mHistories.erase(found);
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "BoardData.h"
+#include "Card.h"
+#include "EntityId.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace Storage
+{
+    struct JournalEntryData;
+}
+
+namespace Stride
+{
+    // The card fields the editor popup saves together
+    struct CardContent
+    {
+        std::string title;
+        std::string description;
+        std::vector<std::string> badges;
+        std::vector<ChecklistItem> checklist;
+
+        static CardContent Of(const Card& card);
+        void ApplyTo(Card& card) const; // Touches the card and the checklist items that differ
+        bool SameAs(const CardContent& other) const;
+        size_t HeapBytes() const;
+    };
+
+    // Each command holds both sides of its edit, so the same command undoes and redoes it
+    struct PlaceCardsCommand
+    {
+        std::vector<CardPlacement> before;
+        std::vector<CardPlacement> after;
+    };
+
+    struct RemoveCardCommand
+    {
+        ListId listId;
+        Card card; // As it was when removed, rank included
+    };
+
+    struct ToggleChecklistItemCommand
+    {
+        CardId cardId;
+        ChecklistItemId itemId;
+    };
+
+    struct RenameListCommand
+    {
+        ListId listId;
+        std::string before;
+        std::string after;
+    };
+
+    struct EditCardCommand
+    {
+        CardId cardId;
+        CardContent before;
+        CardContent after;
+    };
+
+    using UndoCommand = std::variant<
+        PlaceCardsCommand,
+        RemoveCardCommand,
+        ToggleChecklistItemCommand,
+        RenameListCommand,
+        EditCardCommand>;
+
+    /**
+     * @brief Per-board undo/redo history of inverse commands.
+     *
+     * Every step stores only what its edit changed (card placements, a removed card, the old and
+     * new text), never a copy of the board. Undoing a move of any number of cards is one
+     * BoardData::PlaceCards call, a single pass over the lists involved.
+     *
+     * Renames and card edits of the same target recorded within kCoalesceWindow of each other
+     * merge into one step, so a burst of typing undoes at once. The steps of all boards share a
+     * memory limit; past it the oldest steps are dropped.
+     *
+     * Steps are written to the undo_journal table and read back when a board is opened, so the
+     * history survives restarts. Entities created since the last save still carry transient IDs:
+     * the save reports the row IDs it hands out and Persist(), run after every save, rewrites the
+     * steps with them before encoding.
+     *
+     * Usage:
+     * @code
+     * auto before = board.CapturePlacements(ids);
+     * board.MoveCards(ids, target, index);
+     * UndoJournal::Get().Record(board, PlaceCardsCommand{ before, board.CapturePlacements(ids) });
+     * ...
+     * if(UndoJournal::Get().Undo(board))
+     *     SaveActiveBoard();
+     * @endcode
+     *
+     * @note Main thread only, like the boards it edits.
+     */
+    class UndoJournal
+    {
+      public:
+        static constexpr size_t kDefaultMemoryLimit = 8 * 1024 * 1024;
+        static constexpr std::chrono::milliseconds kCoalesceWindow{ 1000 };
+
+        static UndoJournal& Get()
+        {
+            static UndoJournal instance;
+            return instance;
+        }
+
+        // Add a step for an edit already applied to the board; clears the board's redo steps
+        void Record(const BoardData& board, UndoCommand command);
+
+        // False when there is nothing to undo or redo, or the step no longer applies
+        bool Undo(BoardData& board);
+        bool Redo(BoardData& board);
+
+        size_t UndoCount(BoardId boardId) const;
+        size_t RedoCount(BoardId boardId) const;
+
+        void SetMemoryLimit(size_t bytes);
+        size_t MemoryLimit() const { return mMemoryLimit; }
+        size_t HeapBytes() const { return mBytes; } // Every board's steps
+
+        // After a save: resolve the IDs it assigned and queue the board's new or changed steps
+        void Persist(const BoardData& board, const AssignedIds& assigned = {});
+
+        // Adopt the board's stored steps, read off the main thread by the BoardRepository.
+        // Steps recorded while they were read stay the newest; stored redo steps are dropped.
+        void Load(BoardId boardId, const std::vector<Storage::JournalEntryData>& rows);
+        bool IsLoaded(BoardId boardId) const; // Load() ran this session
+
+        // The board was deleted; its rows go with it (ON DELETE CASCADE)
+        void Forget(BoardId boardId);
+
+      private:
+        struct Step
+        {
+            UndoCommand command;
+            std::chrono::steady_clock::time_point recordedAt;
+            size_t bytes = 0;
+            int rowId = 0;          // 0 until first written
+            bool persisted = false; // Row matches command and undone state
+        };
+
+        // steps[0, cursor) can be undone, steps[cursor, end) redone
+        struct History
+        {
+            std::deque<Step> steps;
+            size_t cursor = 0;
+            std::vector<int> deletedRows; // Rows of dropped steps, deleted by the next Persist
+            bool loaded = false;          // Stored steps adopted
+        };
+
+        std::unordered_map<BoardId, History> mHistories;
+        size_t mMemoryLimit = kDefaultMemoryLimit;
+        size_t mBytes = 0;
+
+        Step MakeStep(UndoCommand command) const;
+        void DropStep(History& history, size_t index);
+        void Trim(History& current);
+        bool TrimOne(History& history);
+        static void ResolveIds(UndoCommand& command, const AssignedIds& assigned);
+
+        template<EntityKind Kind>
+        static void Resolve(EntityId<Kind>& id, const AssignedIds& assigned)
+        {
+            if(!id.IsValid() || id.IsPersisted())
+                return;
+            auto found = assigned.find(id.Raw());
+            if(found != assigned.end())
+                id = EntityId<Kind>::FromRow(found->second);
+        }
+    };
+}
@@ -6,6 +6,8 @@
 #include "managers/DragDropManager.h"
 #include "managers/FontManager.h"
 #include "managers/BoardManager.h"
+#include "managers/CardSelection.h"
+#include "managers/UndoJournal.h"
 #include "managers/DragDropTypes.h"
 #include "FontAwesome6.h"
 #include "BadgeColors.h"
@@ -13,23 +15,53 @@
 #include "Utils.h"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include <cstring>
 #include <string>
 
 namespace Stride
 {
+    namespace
+    {
+        constexpr size_t kCardPopupIdSize = 32;
+
+        // Popup names are formatted into a stack buffer, the list is rendered every frame
+        void FormatCardPopupId(char (&buffer)[kCardPopupIdSize], ListId listId)
+        {
+            ImFormatString(
+                buffer,
+                kCardPopupIdSize,
+                "Card Popup##%016llX",
+                static_cast<unsigned long long>(listId.Raw())
+            );
+        }
+
+        uint64_t Mix(uint64_t hash, uint64_t value)
+        {
+            return (hash ^ value) * 1099511628211ull;
+        }
+
+        uint64_t FloatBits(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    }
+
     // Static member initialization
     CardListStyle CardListRenderer::sStyle;
     std::vector<std::string> CardListRenderer::sAvailableBadges
         = { "Bug", "Feature", "Urgent", "Design", "Dev", "Test", "High Priority", "Low Priority" };
 
     // CardListUIState implementation
-    CardListUIState::CardListUIState() : uniqueId(genUID()) {}
+    CardListUIState::CardListUIState() : uniqueId(UniqueId::Generate()) {}
 
     void CardListUIState::Reset()
     {
         isEditingTitle = false;
         memset(titleBuffer, 0, sizeof(titleBuffer));
         scrollY = 0.0f;
+        autoScroll.Reset();
     }
 
     // CardEditorState implementation
@@ -37,7 +69,7 @@ namespace Stride
     {
         isOpen = true;
         isEditing = false;
-        editingCardId.clear();
+        editingCardId = {};
         Reset();
     }
 
@@ -128,25 +160,30 @@ namespace Stride
             ImGui::SetNextItemWidth(width - padding_x - (button_size * 2.0f) - spacing - 5.0f);
             ImGui::SetKeyboardFocusHere();
             if(ImGui::InputText(
-                   (std::string("##titleEditor") + uiState.uniqueId).c_str(),
+                   "##titleEditor",
                    uiState.titleBuffer,
                    IM_ARRAYSIZE(uiState.titleBuffer),
                    ImGuiInputTextFlags_EnterReturnsTrue
                ))
             {
-                data.title = uiState.titleBuffer;
                 uiState.isEditingTitle = false;
             }
             // Deactivate edit mode when clicking outside or losing focus
             if(ImGui::IsItemDeactivated()
                || (!ImGui::IsItemFocused() && ImGui::IsMouseClicked(ImGuiMouseButton_Left)))
             {
-                if(strlen(uiState.titleBuffer) > 0)
-                {
-                    data.title = uiState.titleBuffer;
-                }
                 uiState.isEditingTitle = false;
             }
+            if(!uiState.isEditingTitle && strlen(uiState.titleBuffer) > 0
+               && data.title != uiState.titleBuffer)
+            {
+                RenameListCommand rename{ data.id, data.title, uiState.titleBuffer };
+                data.title = uiState.titleBuffer;
+                data.changes.Touch();
+                if(const BoardData* board = BoardManager::Get().GetActiveBoard())
+                    UndoJournal::Get().Record(*board, std::move(rename));
+                BoardManager::Get().SaveActiveBoard();
+            }
             ImGui::PopStyleColor();
             if(ImGui::IsItemFocused())
             {
@@ -166,7 +203,7 @@ namespace Stride
             // Make the header text area interactive for clicking and dragging
             ImGui::SetCursorScreenPos(text_pos);
             ImGui::InvisibleButton(
-                (std::string("##headerInteraction") + uiState.uniqueId).c_str(),
+                "##headerInteraction",
                 ImVec2(
                     width - padding_x - (button_size * 2.0f) - spacing - 5.0f,
                     ImGui::GetTextLineHeight()
@@ -184,7 +221,7 @@ namespace Stride
             if(ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceNoPreviewTooltip))
             {
                 ListDragDropPayload payload;
-                payload.SetListId(data.id);
+                payload.list_id = data.id;
                 payload.list_index = listIndex;
 
                 ImGui::SetDragDropPayload("LIST_PAYLOAD", &payload, sizeof(payload));
@@ -274,9 +311,10 @@ namespace Stride
         ImGui::PushStyleColor(ImGuiCol_PopupBg, IM_COL32(28, 30, 34, 255));
         ImGui::PushStyleColor(ImGuiCol_Border, IM_COL32(50, 50, 55, 255));
 
-        std::string popupId = std::string("Card Popup##") + data.id;
+        char popupId[kCardPopupIdSize];
+        FormatCardPopupId(popupId, data.id);
         if(ImGui::BeginPopupModal(
-               popupId.c_str(),
+               popupId,
                NULL,
                ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove
            ))
@@ -480,10 +518,7 @@ namespace Stride
             {
                 if(strlen(editorState.checklistInputBuffer) > 0)
                 {
-                    ChecklistItem newItem;
-                    newItem.text = editorState.checklistInputBuffer;
-                    newItem.isChecked = false;
-                    editorState.checklist.push_back(newItem);
+                    editorState.checklist.emplace_back(editorState.checklistInputBuffer);
                     memset(
                         editorState.checklistInputBuffer,
                         0,
@@ -537,10 +572,15 @@ namespace Stride
                         // Update existing card
                         if(Card* card = data.FindCard(editorState.editingCardId))
                         {
-                            card->title = editorState.titleBuffer;
-                            card->description = editorState.descriptionBuffer;
-                            card->badges = editorState.badges;
-                            card->checklist = editorState.checklist;
+                            EditCardCommand edit{ card->id, CardContent::Of(*card) };
+                            edit.after = { editorState.titleBuffer,
+                                           editorState.descriptionBuffer,
+                                           editorState.badges,
+                                           editorState.checklist };
+                            edit.after.ApplyTo(*card);
+                            data.TouchLayout();
+                            if(const BoardData* board = BoardManager::Get().GetActiveBoard())
+                                UndoJournal::Get().Record(*board, std::move(edit));
                         }
                     }
                     else
@@ -554,6 +594,7 @@ namespace Stride
                         newCard.checklist = editorState.checklist;
                         data.AddCard(std::move(newCard));
                     }
+                    BoardManager::Get().SaveActiveBoard();
                     editorState.Close();
                     ImGui::CloseCurrentPopup();
                 }
@@ -568,45 +609,155 @@ namespace Stride
         ImGui::PopStyleVar(2);
     }
 
-    void CardListRenderer::RenderCards(CardList& data, CardEditorState& editorState, int listIndex)
+    void CardListRenderer::UpdateCardSlots(const CardList& data, CardListUIState& uiState)
+    {
+        const float spacing = ImGui::GetStyle().ItemSpacing.y;
+
+        // The layout version covers card order and in-place edits, and the font is read once
+        // for the whole list, so an unchanged list is skipped without visiting its cards
+        uint64_t key = 1469598103934665603ull;
+        key = Mix(key, data.LayoutVersion());
+        key = Mix(key, data.cards.size());
+        key = Mix(key, FloatBits(spacing));
+        key = Mix(key, reinterpret_cast<uintptr_t>(ImGui::GetFont()));
+        key = Mix(key, FloatBits(ImGui::GetFontSize()));
+        key = Mix(key, FloatBits(FontManager::GetDpiScale()));
+
+        std::vector<float>& tops = uiState.cardSlotTops;
+        if(key == uiState.cardSlotKey && tops.size() == data.cards.size() + 2)
+            return;
+
+        // Each slot is a 1px drop zone followed by the card, both advanced by ItemSpacing
+        const float zone_advance = 1.0f + spacing;
+        tops.resize(data.cards.size() + 2);
+        float y = 0.0f;
+        for(size_t i = 0; i < data.cards.size(); ++i)
+        {
+            tops[i] = y;
+            y += zone_advance + CardRenderer::CalculateHeight(data.cards[i]) + spacing;
+        }
+        tops[data.cards.size()] = y;
+        tops[data.cards.size() + 1] = y + zone_advance;
+        uiState.cardSlotKey = key;
+    }
+
+    void CardListRenderer::RenderCards(
+        CardList& data,
+        CardListUIState& uiState,
+        CardEditorState& editorState
+    )
     {
         const float dpiScale = FontManager::GetDpiScale();
         const ImGuiPayload* global_payload = ImGui::GetDragDropPayload();
         bool payload_active = (global_payload && global_payload->IsDataType("CARD_PAYLOAD"));
 
-        std::vector<Stride::Dropzone>& aDropZones = Stride::DragDropManager::GetDropZones();
         Stride::DragOperation& aDragOperation = Stride::DragDropManager::GetDragOperation();
         Stride::Dropzone* current_drop = Stride::DragDropManager::GetCurrentDropZonePtr();
 
-        for(size_t i = 0; i <= data.cards.size(); ++i)
+        // Only the slots overlapping the visible part of the container are submitted; the
+        // cursor jumps over the rest using the slot offsets, so scrolling behaves as before
+        UpdateCardSlots(data, uiState);
+        const std::vector<float>& tops = uiState.cardSlotTops;
+        const float spacing = ImGui::GetStyle().ItemSpacing.y;
+
+        // While a card is dragged its own slot is skipped and the hovered drop zone grows a
+        // placeholder card, which shifts every slot after them
+        int dragged_index = -1;
+        int placeholder_index = -1;
+        float placeholder_advance = 0.0f;
+        if(payload_active)
+        {
+            const Stride::DragDropPayload* d = (const Stride::DragDropPayload*)global_payload->Data;
+            if(d->source_list_id == data.id && d->card_index >= 0
+               && d->card_index < (int)data.cards.size())
+                dragged_index = d->card_index;
+
+            if(current_drop && current_drop->list_id == data.id
+               && current_drop->insert_index != dragged_index && current_drop->insert_index >= 0
+               && current_drop->insert_index <= (int)data.cards.size())
+            {
+                BoardData* board = BoardManager::Get().GetActiveBoard();
+                Card* moving = DragDropManager::GetCard(board, d->source_list_id, d->card_index);
+                if(moving)
+                {
+                    placeholder_index = current_drop->insert_index;
+                    placeholder_advance
+                        = CardRenderer::CalculateHeight(*moving) + spacing + 1.0f + spacing;
+                }
+            }
+        }
+
+        auto slot_top = [&](size_t slot) {
+            float y = tops[slot];
+            if(dragged_index >= 0 && (int)slot > dragged_index)
+                y -= tops[dragged_index + 1] - tops[dragged_index];
+            if(placeholder_index >= 0 && (int)slot > placeholder_index)
+                y += placeholder_advance;
+            return y;
+        };
+
+        const size_t slot_count = data.cards.size() + 1;
+        const float origin_y = ImGui::GetCursorPosY();
+        const float visible_top = ImGui::GetScrollY() - origin_y;
+        const float visible_bottom = visible_top + ImGui::GetWindowHeight();
+
+        size_t first = 0, last = slot_count;
+        {
+            size_t lo = 0, hi = slot_count;
+            while(lo < hi) // First slot ending below the top edge
+            {
+                size_t mid = (lo + hi) / 2;
+                if(slot_top(mid + 1) <= visible_top)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            first = lo;
+
+            hi = slot_count;
+            while(lo < hi) // First slot starting below the bottom edge
+            {
+                size_t mid = (lo + hi) / 2;
+                if(slot_top(mid) < visible_bottom)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            last = lo;
+        }
+
+        if(first > 0)
+            ImGui::SetCursorPosY(origin_y + slot_top(first));
+
+        for(size_t i = first; i < last; ++i)
         {
             bool isCurrentCardDragging = false;
             if(payload_active && global_payload->IsDataType("CARD_PAYLOAD"))
             {
                 const Stride::DragDropPayload* d
                     = (const Stride::DragDropPayload*)global_payload->Data;
-                if(d->GetSourceListId() == data.id && d->card_index == (int)i)
+                if(d->source_list_id == data.id && d->card_index == (int)i)
                     isCurrentCardDragging = true;
             }
             if(isCurrentCardDragging)
                 continue;
 
+            // Labels below are scoped by the slot index, so none of them is formatted per frame
+            ImGui::PushID((int)i);
+
             // Dropzone between cards
-            std::string dropzone_id = std::string("dropzone_") + data.id + "_" + std::to_string(i);
-            ImGui::InvisibleButton(
-                dropzone_id.c_str(),
-                ImVec2(ImGui::GetContentRegionAvail().x, 1.0f)
-            );
+            ImGui::InvisibleButton("dropzone", ImVec2(ImGui::GetContentRegionAvail().x, 1.0f));
             ImRect zone_rect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
-            aDropZones.push_back({ zone_rect, data.id, (int)i });
+            Stride::DragDropManager::RegisterDropZone({ zone_rect, data.id, (int)i });
 
             if(ImGui::BeginDragDropTarget())
             {
                 if(const ImGuiPayload* p = ImGui::AcceptDragDropPayload("CARD_PAYLOAD"))
                 {
                     const Stride::DragDropPayload* d = (const Stride::DragDropPayload*)p->Data;
-                    aDragOperation.source_list_id = d->GetSourceListId();
+                    aDragOperation.source_list_id = d->source_list_id;
                     aDragOperation.source_index = d->card_index;
+                    aDragOperation.card_count = d->card_count;
                     aDragOperation.target_list_id = data.id;
                     aDragOperation.target_index = (int)i;
                 }
@@ -630,12 +781,8 @@ namespace Stride
                             = (ImGui::GetContentRegionAvail().x - 256.0f * dpiScale) * 0.5f;
                         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + x_center);
                         CardRenderer::Render(*moving_card, "placeholder_card", true);
-
-                        std::string dropzone_id_x = std::string("dropzonex_")
-                                                    + std::to_string(listIndex) + "_"
-                                                    + std::to_string(i);
                         ImGui::InvisibleButton(
-                            dropzone_id_x.c_str(),
+                            "dropzonex",
                             ImVec2(ImGui::GetContentRegionAvail().x, 1.0f)
                         );
                     }
@@ -645,11 +792,10 @@ namespace Stride
             // Card Render
             if(i < data.cards.size())
             {
-                std::string card_id
-                    = std::string("card_") + std::to_string(listIndex) + "_" + std::to_string(i);
                 float x_center = (ImGui::GetContentRegionAvail().x - 256.0f * dpiScale) * 0.5f;
                 ImGui::SetCursorPosX(ImGui::GetCursorPosX() + x_center);
-                CardRenderer::Render(data.cards[i], card_id.c_str());
+                const bool isSelected = CardSelection::IsSelected(data.cards[i].id);
+                CardRenderer::Render(data.cards[i], "card", false, isSelected);
 
                 if(ImGui::IsItemHovered())
                     ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
@@ -659,7 +805,21 @@ namespace Stride
                     if(ImGui::GetMouseDragDelta(ImGuiMouseButton_Left, 0.0f).x == 0.0f
                        && ImGui::GetMouseDragDelta(ImGuiMouseButton_Left, 0.0f).y == 0.0f)
                     {
-                        editorState.OpenForEdit(data.cards[i]);
+                        // Ctrl/Shift-click build a selection, a plain click edits the card
+                        const ImGuiIO& io = ImGui::GetIO();
+                        if(io.KeyCtrl)
+                        {
+                            CardSelection::Toggle(data.cards[i].id);
+                        }
+                        else if(io.KeyShift)
+                        {
+                            CardSelection::SelectRange(data, i);
+                        }
+                        else
+                        {
+                            CardSelection::Clear();
+                            editorState.OpenForEdit(data.cards[i]);
+                        }
                     }
                 }
 
@@ -670,13 +830,56 @@ namespace Stride
                    ))
                 {
                     Stride::DragDropPayload d;
-                    d.SetSourceListId(data.id);
+                    d.source_list_id = data.id;
                     d.card_index = (int)i;
+                    d.card_count = isSelected ? (int)CardSelection::Count() : 1;
                     ImGui::SetDragDropPayload("CARD_PAYLOAD", &d, sizeof(d));
                     ImGui::EndDragDropSource();
                 }
             }
+
+            ImGui::PopID();
         }
+
+        // Extend the content to where the last drop zone would have ended
+        if(last < slot_count)
+        {
+            ImGui::SetCursorPosY(origin_y + slot_top(slot_count) - spacing);
+            ImGui::Dummy(ImVec2(0.0f, 0.0f));
+        }
+    }
+
+    void CardListRenderer::UpdateAutoScroll(CardListUIState& uiState, const ImRect& listRect)
+    {
+        // Only a card dragged over this list scrolls it; the header and footer count as the
+        // deepest part of the top and bottom edge bands
+        const ImGuiPayload* payload = ImGui::GetDragDropPayload();
+        const ImGuiIO& io = ImGui::GetIO();
+        if(!payload || !payload->IsDataType("CARD_PAYLOAD") || !listRect.Contains(io.MousePos))
+        {
+            uiState.autoScroll.Reset();
+            return;
+        }
+
+        const float top = ImGui::GetWindowPos().y;
+        const float bottom = top + ImGui::GetWindowHeight();
+        const float delta = uiState.autoScroll.Update(
+            io.MousePos.y,
+            top,
+            bottom,
+            io.DeltaTime,
+            FontManager::GetDpiScale()
+        );
+
+        const float scrollY = ImGui::GetScrollY();
+        const float target = ImClamp(scrollY + delta, 0.0f, ImGui::GetScrollMaxY());
+        if(target == scrollY)
+            return;
+
+        // The cards move by the difference next frame, so the drop preview is hit tested at
+        // the spot that will then be under the cursor
+        ImGui::SetScrollY(target);
+        Stride::DragDropManager::LeadDropZone(ImVec2(0.0f, target - scrollY));
     }
 
     void CardListRenderer::Render(
@@ -687,23 +890,15 @@ namespace Stride
         ImVec2 size
     )
     {
-        const float dpiScale = FontManager::GetDpiScale();
-        std::vector<Stride::Dropzone>& aDropZones = Stride::DragDropManager::GetDropZones();
-
-        if(listIndex == 0)
-        {
-            aDropZones.clear();
-            Stride::DragDropManager::ClearListBounds();
-        }
-
         ImGui::PushStyleColor(ImGuiCol_ChildBg, sStyle.backgroundColor);
         ImGui::PushStyleColor(ImGuiCol_WindowBg, sStyle.backgroundColor);
         ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, sStyle.cornerRadius);
         ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, { 0.0f, 0.0f });
         ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
 
+        ImGui::PushID(uiState.uniqueId.c_str());
         ImGui::BeginChild(
-            (std::string("CardList_") + uiState.uniqueId).c_str(),
+            "CardList",
             size,
             false,
             ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse
@@ -731,13 +926,14 @@ namespace Stride
             availableHeight = 100.0f;
 
         ImGui::BeginChild(
-            (std::string("CardContainer_") + data.title).c_str(),
+            "CardContainer",
             ImVec2(0, availableHeight),
             false,
             ImGuiWindowFlags_None
         );
 
-        RenderCards(data, editorState, listIndex);
+        UpdateAutoScroll(uiState, listRect);
+        RenderCards(data, uiState, editorState);
 
         ImGui::EndChild();
 
@@ -752,7 +948,9 @@ namespace Stride
 
         if(editorState.isOpen || openNewCard)
         {
-            ImGui::OpenPopup((std::string("Card Popup##") + data.id).c_str());
+            char popupId[kCardPopupIdSize];
+            FormatCardPopupId(popupId, data.id);
+            ImGui::OpenPopup(popupId);
             editorState.isOpen = true;
         }
 
@@ -760,9 +958,19 @@ namespace Stride
 
         ImGui::PopStyleColor();
         ImGui::EndChild();
+        ImGui::PopID();
 
         ImGui::PopStyleColor(2);
         ImGui::PopStyleVar(3);
     }
 
+    void CardListRenderer::RenderPlaceholder(const CardList& data, ImVec2 size)
+    {
+        // Same footprint as the child window Render() would submit, so the board's content
+        // width and scrollbar do not change as lists are culled
+        ImVec2 pos = ImGui::GetCursorScreenPos();
+        Stride::DragDropManager::RegisterListBounds(data.id, ImRect(pos, pos + size));
+        ImGui::Dummy(size);
+    }
+
 }
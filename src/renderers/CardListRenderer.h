@@ -1,7 +1,10 @@
 #pragma once
 #include "CardList.h"
 #include "Card.h"
+#include "utilities/EdgeAutoScroll.h"
+#include "utilities/UniqueId.h"
 #include "imgui.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -9,7 +12,7 @@ namespace Stride
 {
     struct CardListUIState
     {
-        std::string uniqueId;
+        UniqueId uniqueId;
 
         // Title editing
         bool isEditingTitle = false;
@@ -18,6 +21,12 @@ namespace Stride
         // Scroll state
         float scrollY = 0.0f;
         float lastContentHeight = 0.0f;
+        EdgeAutoScroll autoScroll; // Scrolls the cards while a drag hovers the top or bottom
+
+        // Card virtualization: offset of every card slot (drop zone + card) from the top of the
+        // card container, plus the end of the last one. Rebuilt when cardSlotKey changes.
+        std::vector<float> cardSlotTops;
+        uint64_t cardSlotKey = 0;
 
         CardListUIState();
         void Reset();
@@ -27,7 +36,7 @@ namespace Stride
     {
         bool isOpen = false;
         bool isEditing = false;
-        std::string editingCardId;
+        CardId editingCardId;
 
         // Edit buffers
         char titleBuffer[256] = "";
@@ -74,12 +83,21 @@ namespace Stride
             ImVec2 size
         );
 
+        // Stand-in for a list scrolled out of view: registers its bounds and reserves its size
+        static void RenderPlaceholder(const CardList& data, ImVec2 size);
+
       private:
         static CardListStyle sStyle;
         static std::vector<std::string> sAvailableBadges;
 
         static void RenderHeader(CardList& data, CardListUIState& uiState, int listIndex);
-        static void RenderCards(CardList& data, CardEditorState& editorState, int listIndex);
+        static void RenderCards(
+            CardList& data,
+            CardListUIState& uiState,
+            CardEditorState& editorState
+        );
+        static void UpdateCardSlots(const CardList& data, CardListUIState& uiState);
+        static void UpdateAutoScroll(CardListUIState& uiState, const ImRect& listRect);
         static void RenderFooter(CardList& data, CardEditorState& editorState);
         static void RenderCardPopup(CardList& data, CardEditorState& editorState);
         static void ResetCardListState(CardList& data, CardEditorState& editorState);
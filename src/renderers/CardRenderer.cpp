@@ -5,108 +5,145 @@
 #include "managers/FontManager.h"
 #include "external/FontAwesome6.h"
 #include "renderers/CardRenderer.h"
+#include <cstring>
 
 namespace Stride
 {
+    namespace
+    {
+        const char* const kDescriptionBadge = ICON_FA_ALIGN_LEFT " Description";
+
+        uint64_t Mix(uint64_t hash, uint64_t value)
+        {
+            return (hash ^ value) * 1099511628211ull;
+        }
+
+        uint64_t FloatBits(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    }
+
     // Static member initialization
     CardStyle CardRenderer::sStyle;
+    std::unordered_map<CardId, CardRenderer::CachedLayout> CardRenderer::sLayouts;
+    int CardRenderer::sLastSweepFrame = 0;
 
-    void CardRenderer::SetStyle(const CardStyle& style) { sStyle = style; }
+    void CardRenderer::SetStyle(const CardStyle& style)
+    {
+        sStyle = style;
+        sLayouts.clear();
+    }
 
     const CardStyle& CardRenderer::GetStyle() { return sStyle; }
 
-    float CardRenderer::CalculateBadgeRowsHeight(
-        const Card& card,
-        float maxWidth,
-        float badgePadding,
-        float badgeHeight,
-        float badgeSpacing
-    )
+    uint64_t CardRenderer::LayoutKey(const Card& card)
+    {
+        uint64_t key = 1469598103934665603ull;
+        key = Mix(key, card.changes.revision);
+
+        // A reloaded card starts over at revision 1, so its shape is part of the key as well
+        key = Mix(key, card.title.size());
+        key = Mix(key, card.badges.size());
+        key = Mix(key, card.checklist.size());
+        key = Mix(key, card.HasDescription());
+
+        key = Mix(key, reinterpret_cast<uintptr_t>(ImGui::GetFont()));
+        key = Mix(key, FloatBits(ImGui::GetFontSize()));
+        key = Mix(key, FloatBits(FontManager::GetDpiScale()));
+        return key;
+    }
+
+    CardLayout CardRenderer::MeasureLayout(const Card& card)
     {
-        float badge_row_width = 0.0f;
-        float badge_total_height = badgeHeight;
+        const float dpiScale = FontManager::GetDpiScale();
+        const float padding = sStyle.padding * dpiScale;
+        const float badge_padding = sStyle.badgePadding * dpiScale;
+        const float badge_height = sStyle.badgeHeight * dpiScale;
+        const float badge_spacing = sStyle.badgeSpacing * dpiScale;
+        const float content_width = sStyle.width * dpiScale - (padding * 2.0f);
 
-        for(const std::string& badge : card.badges)
-        {
-            ImVec2 badge_size = ImGui::CalcTextSize(badge.c_str());
-            badge_size.x += badgePadding * 2;
-            if(badge_row_width + badge_size.x > maxWidth)
-            {
-                badge_total_height += badgeHeight + badgeSpacing;
-                badge_row_width = badge_size.x;
-            }
-            else
+        CardLayout layout;
+        layout.titleHeight
+            = ImGui::CalcTextSize(card.title.c_str(), nullptr, true, content_width).y;
+        layout.height = padding + layout.titleHeight + padding;
+
+        if(card.badges.empty() && !card.HasDescription() && !card.HasChecklist())
+            return layout;
+
+        // Badges flow left to right and wrap once the next one would cross the content edge
+        ImVec2 cursor(0.0f, 0.0f);
+        auto place = [&](const char* text) {
+            const float width = ImGui::CalcTextSize(text).x + (badge_padding * 2.0f);
+            if(cursor.x + width > content_width)
             {
-                badge_row_width += badge_size.x + badgeSpacing;
+                cursor.x = 0.0f;
+                cursor.y += badge_height + badge_spacing;
             }
+            layout.badges.push_back({ cursor, width });
+            cursor.x += width + badge_spacing;
+        };
+
+        layout.badges.reserve(card.badges.size() + 2);
+        for(const std::string& badge : card.badges)
+        {
+            place(badge.c_str());
         }
 
-        // Add checklist badge
         if(card.HasChecklist())
         {
-            std::string check_str = std::string(ICON_FA_SQUARE_CHECK " ")
+            layout.checklistLabel = std::string(ICON_FA_SQUARE_CHECK " ")
                                     + std::to_string(card.GetChecklistCompleted()) + "/"
                                     + std::to_string(card.GetChecklistTotal());
-            ImVec2 badge_size = ImGui::CalcTextSize(check_str.c_str());
-            badge_size.x += badgePadding * 2;
-
-            if(badge_row_width + badge_size.x > maxWidth)
-            {
-                badge_total_height += badgeHeight + badgeSpacing;
-                badge_row_width = badge_size.x;
-            }
-            else
-            {
-                badge_row_width += badge_size.x + badgeSpacing;
-            }
+            place(layout.checklistLabel.c_str());
         }
 
-        // Add description badge
         if(card.HasDescription())
-        {
-            const char* desc_text = ICON_FA_ALIGN_LEFT " Description";
-            ImVec2 badge_size = ImGui::CalcTextSize(desc_text);
-            badge_size.x += badgePadding * 2;
-
-            if(badge_row_width + badge_size.x > maxWidth)
-            {
-                badge_total_height += badgeHeight + badgeSpacing;
-            }
-        }
+            place(kDescriptionBadge);
 
-        return badge_total_height;
+        layout.height += cursor.y + badge_height + padding * 0.5f;
+        return layout;
     }
 
-    float CardRenderer::CalculateHeight(const Card& card)
+    const CardLayout& CardRenderer::GetLayout(const Card& card)
     {
-        const float dpiScale = FontManager::GetDpiScale();
-        const float padding = sStyle.padding * dpiScale;
-        const float badge_padding = sStyle.badgePadding * dpiScale;
-        const float badge_height = sStyle.badgeHeight * dpiScale;
-        const float badge_spacing = sStyle.badgeSpacing * dpiScale;
-        const float card_width = sStyle.width * dpiScale;
-
-        ImVec2 title_size
-            = ImGui::CalcTextSize(card.title.c_str(), nullptr, true, card_width - (padding * 2.0f));
-        float card_height = padding + title_size.y;
+        const int frame = ImGui::GetFrameCount();
+        if(frame - sLastSweepFrame > kLayoutRetainFrames)
+            SweepLayouts(frame);
 
-        if(!card.badges.empty() || card.HasDescription() || card.HasChecklist())
+        const uint64_t key = LayoutKey(card);
+        CachedLayout& cached = sLayouts[card.id];
+        if(cached.key != key)
         {
-            float badge_total_height = CalculateBadgeRowsHeight(
-                card,
-                card_width - (padding * 2.0f),
-                badge_padding,
-                badge_height,
-                badge_spacing
-            );
-            card_height += badge_total_height + padding * 0.5f;
+            cached.layout = MeasureLayout(card);
+            cached.key = key;
         }
+        cached.lastUsedFrame = frame;
+        return cached.layout;
+    }
 
-        card_height += padding;
-        return card_height;
+    void CardRenderer::SweepLayouts(int frame)
+    {
+        sLastSweepFrame = frame;
+        for(auto it = sLayouts.begin(); it != sLayouts.end();)
+        {
+            if(frame - it->second.lastUsedFrame > kLayoutRetainFrames)
+                it = sLayouts.erase(it);
+            else
+                ++it;
+        }
     }
 
-    bool CardRenderer::Render(const Card& card, const char* uniqueId, bool isDragging)
+    float CardRenderer::CalculateHeight(const Card& card) { return GetLayout(card).height; }
+
+    bool CardRenderer::Render(
+        const Card& card,
+        const char* uniqueId,
+        bool isDragging,
+        bool isSelected
+    )
     {
         const float dpiScale = FontManager::GetDpiScale();
         ImGuiWindow* window = ImGui::GetCurrentWindow();
@@ -121,31 +158,10 @@ namespace Stride
         const float padding = sStyle.padding * dpiScale;
         const float badge_padding = sStyle.badgePadding * dpiScale;
         const float badge_height = sStyle.badgeHeight * dpiScale;
-        const float badge_spacing = sStyle.badgeSpacing * dpiScale;
         const float card_width = sStyle.width * dpiScale;
 
-        ImVec2 title_size
-            = ImGui::CalcTextSize(card.title.c_str(), nullptr, true, card_width - (padding * 2.0f));
-        float title_height = title_size.y;
-
-        float badge_total_height = 0.0f;
-        if(!card.badges.empty() || card.HasDescription() || card.HasChecklist())
-        {
-            badge_total_height = CalculateBadgeRowsHeight(
-                card,
-                card_width - (padding * 2.0f),
-                badge_padding,
-                badge_height,
-                badge_spacing
-            );
-        }
-
-        float card_height = padding + title_height;
-        if(!card.badges.empty() || card.HasDescription() || card.HasChecklist())
-        {
-            card_height += badge_total_height + padding * 0.5f;
-        }
-        card_height += padding;
+        const CardLayout& layout = GetLayout(card);
+        const float card_height = layout.height;
 
         const ImVec2 card_size(card_width, card_height);
         const ImRect bb(pos, ImVec2(pos.x + card_size.x, pos.y + card_size.y));
@@ -158,6 +174,8 @@ namespace Stride
         ImGui::ButtonBehavior(bb, id, &is_hovered, &is_held);
 
         ImU32 border_color = is_hovered ? sStyle.hoverBorderColor : sStyle.normalBorderColor;
+        if(isSelected)
+            border_color = sStyle.selectedBorderColor;
 
         window->DrawList
             ->AddRectFilled(bb.Min, bb.Max, sStyle.backgroundColor, sStyle.cornerRadius);
@@ -176,119 +194,59 @@ namespace Stride
             nullptr,
             card_width - (padding * 2.0f)
         );
-        text_pos.y += title_height;
-
-        if(!card.badges.empty() || card.HasDescription() || card.HasChecklist())
-        {
-            text_pos.y += padding * 0.5f;
-        }
-        ImVec2 badge_pos = text_pos;
-
-        // Render badges
-        for(const std::string& badge : card.badges)
-        {
-            BadgeColors::BadgeStyle badgeColor = BadgeColors::GetBadgeStyleForText(badge);
-            ImVec2 badge_size = ImGui::CalcTextSize(badge.c_str());
-            badge_size.x += (badge_padding * 2);
-
-            if(badge_pos.x + badge_size.x > bb.Max.x - padding)
-            {
-                badge_pos.x = bb.Min.x + padding;
-                badge_pos.y += badge_height + badge_spacing;
-            }
-
+        text_pos.y += layout.titleHeight + padding * 0.5f;
+
+        // Badges at the offsets measured by the layout, in the order it placed them
+        const float text_height = ImGui::GetFontSize();
+        auto draw_badge = [&](const CardLayout::Badge& badge,
+                              const char* text,
+                              ImU32 bg,
+                              ImU32 fg) {
+            const ImVec2 badge_pos(text_pos.x + badge.offset.x, text_pos.y + badge.offset.y);
             window->DrawList->AddRectFilled(
                 badge_pos,
-                { badge_pos.x + badge_size.x, badge_pos.y + badge_height },
-                badgeColor.bg,
+                { badge_pos.x + badge.width, badge_pos.y + badge_height },
+                bg,
                 4.0f * dpiScale
             );
 
             ImVec2 text_center = ImVec2(
                 badge_pos.x + badge_padding,
-                badge_pos.y + (badge_height - badge_size.y) * 0.5f
+                badge_pos.y + (badge_height - text_height) * 0.5f
             );
 
-            ImGui::PushStyleColor(ImGuiCol_Text, badgeColor.text);
-            ImGui::RenderText(text_center, badge.c_str());
+            ImGui::PushStyleColor(ImGuiCol_Text, fg);
+            ImGui::RenderText(text_center, text);
             ImGui::PopStyleColor();
+        };
 
-            badge_pos.x += badge_size.x + badge_spacing;
+        size_t next_badge = 0;
+        for(const std::string& badge : card.badges)
+        {
+            BadgeColors::BadgeStyle badgeColor = BadgeColors::GetBadgeStyleForText(badge);
+            draw_badge(layout.badges[next_badge++], badge.c_str(), badgeColor.bg, badgeColor.text);
         }
 
         // Checklist Badge
         if(card.HasChecklist())
         {
-            int checklistCompleted = card.GetChecklistCompleted();
-            int checklistTotal = card.GetChecklistTotal();
-            std::string check_str = std::string(ICON_FA_SQUARE_CHECK " ")
-                                    + std::to_string(checklistCompleted) + "/"
-                                    + std::to_string(checklistTotal);
-
-            BadgeColors::BadgeStyle badgeColor;
-            badgeColor.bg = IM_COL32(34, 197, 94, 255);
-            badgeColor.text = IM_COL32(255, 255, 255, 255);
-
-            ImVec2 badge_size = ImGui::CalcTextSize(check_str.c_str());
-            badge_size.x += (badge_padding * 2);
-
-            if(badge_pos.x + badge_size.x > bb.Max.x - padding)
-            {
-                badge_pos.x = bb.Min.x + padding;
-                badge_pos.y += badge_height + badge_spacing;
-            }
-
-            window->DrawList->AddRectFilled(
-                badge_pos,
-                { badge_pos.x + badge_size.x, badge_pos.y + badge_height },
-                badgeColor.bg,
-                4.0f * dpiScale
-            );
-
-            ImVec2 text_center = ImVec2(
-                badge_pos.x + badge_padding,
-                badge_pos.y + (badge_height - badge_size.y) * 0.5f
+            draw_badge(
+                layout.badges[next_badge++],
+                layout.checklistLabel.c_str(),
+                IM_COL32(34, 197, 94, 255),
+                IM_COL32(255, 255, 255, 255)
             );
-
-            ImGui::PushStyleColor(ImGuiCol_Text, badgeColor.text);
-            ImGui::RenderText(text_center, check_str.c_str());
-            ImGui::PopStyleColor();
-
-            badge_pos.x += badge_size.x + badge_spacing;
         }
 
         // Description Badge
         if(card.HasDescription())
         {
-            const char* desc_text = ICON_FA_ALIGN_LEFT " Description";
-            BadgeColors::BadgeStyle badgeColor;
-            badgeColor.bg = IM_COL32(45, 45, 50, 255);
-            badgeColor.text = IM_COL32(180, 180, 180, 255);
-
-            ImVec2 badge_size = ImGui::CalcTextSize(desc_text);
-            badge_size.x += (badge_padding * 2);
-
-            if(badge_pos.x + badge_size.x > bb.Max.x - padding)
-            {
-                badge_pos.x = bb.Min.x + padding;
-                badge_pos.y += badge_height + badge_spacing;
-            }
-
-            window->DrawList->AddRectFilled(
-                badge_pos,
-                { badge_pos.x + badge_size.x, badge_pos.y + badge_height },
-                badgeColor.bg,
-                4.0f * dpiScale
+            draw_badge(
+                layout.badges[next_badge++],
+                kDescriptionBadge,
+                IM_COL32(45, 45, 50, 255),
+                IM_COL32(180, 180, 180, 255)
             );
-
-            ImVec2 text_center = ImVec2(
-                badge_pos.x + badge_padding,
-                badge_pos.y + (badge_height - badge_size.y) * 0.5f
-            );
-
-            ImGui::PushStyleColor(ImGuiCol_Text, badgeColor.text);
-            ImGui::RenderText(text_center, desc_text);
-            ImGui::PopStyleColor();
         }
 
         return is_hovered && ImGui::IsMouseReleased(ImGuiMouseButton_Left);
@@ -1,6 +1,10 @@
 #pragma once
 #include "Card.h"
 #include "imgui.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Stride
 {
@@ -16,6 +20,24 @@ namespace Stride
         ImU32 backgroundColor = IM_COL32(34, 39, 43, 255);
         ImU32 hoverBorderColor = IM_COL32(255, 255, 255, 255);
         ImU32 normalBorderColor = IM_COL32(255, 255, 255, 0);
+        ImU32 selectedBorderColor = IM_COL32(87, 157, 255, 255);
+    };
+
+    // Measured layout of a card: everything Render() needs from CalcTextSize
+    struct CardLayout
+    {
+        struct Badge
+        {
+            ImVec2 offset; // From the top-left of the badge area
+            float width = 0.0f;
+        };
+
+        float titleHeight = 0.0f;
+        float height = 0.0f;
+
+        // The card's badges, then the checklist and description badges if it has them
+        std::vector<Badge> badges;
+        std::string checklistLabel;
     };
 
     class CardRenderer
@@ -25,20 +47,47 @@ namespace Stride
         static const CardStyle& GetStyle();
 
         // Render a card - returns true if clicked
-        static bool Render(const Card& card, const char* uniqueId, bool isDragging = false);
+        static bool Render(
+            const Card& card,
+            const char* uniqueId,
+            bool isDragging = false,
+            bool isSelected = false
+        );
 
         // Calculate height without rendering
         static float CalculateHeight(const Card& card);
 
+        /**
+         * @brief Layout of a card, measured on first use and cached per card.
+         *
+         * Entries are keyed on LayoutKey(), so an edit (which touches the card's revision) or a
+         * change of font, font size or DPI scale re-measures the card on its next use. Entries
+         * unused for a while are dropped, so the cache holds roughly the cards seen recently.
+         */
+        static const CardLayout& GetLayout(const Card& card);
+
+        // Changes whenever the card's cached layout would be re-measured
+        static uint64_t LayoutKey(const Card& card);
+
+        static size_t CachedLayoutCount() { return sLayouts.size(); }
+        static void ClearLayoutCache() { sLayouts.clear(); }
+
       private:
+        struct CachedLayout
+        {
+            uint64_t key = 0;
+            int lastUsedFrame = 0;
+            CardLayout layout;
+        };
+
+        // Frames an entry may go unused before a sweep drops it
+        static constexpr int kLayoutRetainFrames = 600;
+
         static CardStyle sStyle;
+        static std::unordered_map<CardId, CachedLayout> sLayouts;
+        static int sLastSweepFrame;
 
-        static float CalculateBadgeRowsHeight(
-            const Card& card,
-            float maxWidth,
-            float badgePadding,
-            float badgeHeight,
-            float badgeSpacing
-        );
+        static CardLayout MeasureLayout(const Card& card);
+        static void SweepLayouts(int frame);
     };
 }
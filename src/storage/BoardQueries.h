@@ -0,0 +1,131 @@
+#pragma once
+#include "storage/Storage.h"
+#include <unordered_map>
+#include <vector>
+
+namespace Storage
+{
+    // Read queries shared by the persistence worker's connection (StorageManager) and the
+    // read-only connections that load boards in parallel (ReadConnection). Each takes the
+    // sqlite_orm storage to run on, so both run exactly the same SQL.
+
+    template<typename StorageT>
+    std::vector<ListData> ListsInBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.template get_all<ListData>(
+            where(c(&ListData::board_id) == boardId),
+            order_by(&ListData::position)
+        );
+    }
+
+    template<typename StorageT>
+    std::vector<CardData> CardsInBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.template get_all<CardData>(
+            where(c(&CardData::board_id) == boardId && c(&CardData::archived) == false),
+            multi_order_by(order_by(&CardData::list_id), order_by(&CardData::position))
+        );
+    }
+
+    template<typename StorageT>
+    std::vector<BadgeData> BadgesInBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.template get_all<BadgeData>(where(c(&BadgeData::board_id) == boardId));
+    }
+
+    template<typename StorageT>
+    std::vector<CardBadgeData> CardBadgesInBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.select(
+            object<CardBadgeData>(),
+            inner_join<CardData>(on(c(&CardData::id) == &CardBadgeData::card_id)),
+            where(c(&CardData::board_id) == boardId && c(&CardData::archived) == false)
+        );
+    }
+
+    template<typename StorageT>
+    std::vector<ChecklistItemData> ChecklistItemsInBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.select(
+            object<ChecklistItemData>(),
+            inner_join<CardData>(on(c(&CardData::id) == &ChecklistItemData::card_id)),
+            where(c(&CardData::board_id) == boardId && c(&CardData::archived) == false),
+            multi_order_by(
+                order_by(&ChecklistItemData::card_id),
+                order_by(&ChecklistItemData::position)
+            )
+        );
+    }
+
+    // Undo steps of one board, oldest first
+    template<typename StorageT>
+    std::vector<JournalEntryData> JournalEntriesOfBoard(StorageT& storage, int boardId)
+    {
+        using namespace sqlite_orm;
+        return storage.template get_all<JournalEntryData>(
+            where(c(&JournalEntryData::board_id) == boardId),
+            order_by(&JournalEntryData::id)
+        );
+    }
+
+    // Every row of one board in a fixed number of queries, independent of its size
+    template<typename StorageT>
+    BoardBundle LoadBoardBundle(StorageT& storage, int boardId)
+    {
+        BoardBundle bundle;
+        bundle.board = storage.template get<BoardData>(boardId);
+        bundle.lists = ListsInBoard(storage, boardId);
+        bundle.cards = CardsInBoard(storage, boardId);
+        bundle.checklist = ChecklistItemsInBoard(storage, boardId);
+        bundle.badges = BadgesInBoard(storage, boardId);
+        bundle.cardBadges = CardBadgesInBoard(storage, boardId);
+        return bundle;
+    }
+
+    // Every board with its list and card counts. The counts are grouped scans of
+    // idx_lists_board_position and idx_cards_board_archived_list_position, which cover them,
+    // so the cost grows with the number of rows but no row is ever materialized.
+    template<typename StorageT>
+    std::vector<BoardSummary> LoadBoardSummaries(StorageT& storage)
+    {
+        using namespace sqlite_orm;
+
+        std::vector<BoardSummary> summaries;
+        std::unordered_map<int, size_t> slots;
+        for(auto& board : storage.template get_all<BoardData>(order_by(&BoardData::id)))
+        {
+            slots.emplace(board.id, summaries.size());
+            summaries.push_back({ std::move(board) });
+        }
+
+        auto listCounts = storage.select(
+            columns(&ListData::board_id, count<ListData>()),
+            group_by(&ListData::board_id)
+        );
+        for(const auto& [boardId, lists] : listCounts)
+        {
+            auto it = slots.find(boardId);
+            if(it != slots.end())
+                summaries[it->second].list_count = lists;
+        }
+
+        auto cardCounts = storage.select(
+            columns(&CardData::board_id, count<CardData>()),
+            where(c(&CardData::archived) == false),
+            group_by(&CardData::board_id)
+        );
+        for(const auto& [boardId, cards] : cardCounts)
+        {
+            auto it = slots.find(boardId);
+            if(it != slots.end())
+                summaries[it->second].card_count = cards;
+        }
+
+        return summaries;
+    }
+}
@@ -0,0 +1,447 @@
+#include "pch.h"
+#include "BoardSnapshot.h"
+#include "Log.h"
+#include "PathManager.h"
+#include "storage/PersistenceWorker.h"
+#include "storage/StorageManager.h"
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace Stride
+{
+    namespace
+    {
+        constexpr uint32_t kMagic = 0x53525453; // "STRS" read as a little-endian integer
+
+        // What a snapshot was taken against; any commit since then changes one of these
+        struct DatabaseStamp
+        {
+            int64_t size = 0;
+            int64_t modified = 0;
+            uint32_t changeCounter = 0; // Database header, offset 24
+            uint32_t userVersion = 0;   // Database header, offset 60
+
+            bool operator==(const DatabaseStamp& other) const
+            {
+                return size == other.size && modified == other.modified
+                       && changeCounter == other.changeCounter
+                       && userVersion == other.userVersion;
+            }
+        };
+
+        uint32_t ReadBigEndian32(const unsigned char* bytes)
+        {
+            return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16)
+                   | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+        }
+
+        // Stamp of a database whose commits are all in the main file, or nullopt
+        std::optional<DatabaseStamp> StampDatabase(const fs::path& databasePath)
+        {
+            std::error_code ec;
+            DatabaseStamp stamp;
+            stamp.size = static_cast<int64_t>(fs::file_size(databasePath, ec));
+            if(ec)
+                return std::nullopt;
+            stamp.modified = fs::last_write_time(databasePath, ec).time_since_epoch().count();
+            if(ec)
+                return std::nullopt;
+
+            // Frames still in the WAL are commits the main file does not reflect yet
+            fs::path walPath = databasePath;
+            walPath += "-wal";
+            if(fs::exists(walPath, ec) && fs::file_size(walPath, ec) > 0)
+                return std::nullopt;
+
+            unsigned char header[100] = {};
+            std::ifstream file(databasePath, std::ios::binary);
+            if(file.read(reinterpret_cast<char*>(header), sizeof(header)))
+            {
+                stamp.changeCounter = ReadBigEndian32(header + 24);
+                stamp.userVersion = ReadBigEndian32(header + 60);
+            }
+            return stamp;
+        }
+
+        // FNV-1a over the payload; catches truncated and partially written files
+        uint64_t Checksum(const char* bytes, size_t size)
+        {
+            uint64_t hash = 1469598103934665603ull;
+            for(size_t i = 0; i < size; ++i)
+            {
+                hash ^= static_cast<unsigned char>(bytes[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        class SnapshotWriter
+        {
+          public:
+            template<typename T>
+            void Pod(T value)
+            {
+                mBytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void Text(const std::string& text)
+            {
+                Pod(static_cast<uint32_t>(text.size()));
+                mBytes.append(text);
+            }
+
+            void Stamp(const DatabaseStamp& stamp)
+            {
+                Pod(stamp.size);
+                Pod(stamp.modified);
+                Pod(stamp.changeCounter);
+                Pod(stamp.userVersion);
+            }
+
+            std::string& Bytes() { return mBytes; }
+
+          private:
+            std::string mBytes;
+        };
+
+        // Bounds-checked reads; after the first overrun every read fails and Ok() is false
+        class SnapshotReader
+        {
+          public:
+            SnapshotReader(const char* begin, const char* end) : mAt(begin), mEnd(end) {}
+
+            template<typename T>
+            T Pod()
+            {
+                T value{};
+                if(!Take(sizeof(T)))
+                    return value;
+                std::memcpy(&value, mAt - sizeof(T), sizeof(T));
+                return value;
+            }
+
+            std::string Text()
+            {
+                uint32_t size = Pod<uint32_t>();
+                if(!Take(size))
+                    return {};
+                return std::string(mAt - size, size);
+            }
+
+            DatabaseStamp Stamp()
+            {
+                DatabaseStamp stamp;
+                stamp.size = Pod<int64_t>();
+                stamp.modified = Pod<int64_t>();
+                stamp.changeCounter = Pod<uint32_t>();
+                stamp.userVersion = Pod<uint32_t>();
+                return stamp;
+            }
+
+            // Element count, capped by the bytes left so a corrupt count can't over-reserve
+            uint32_t Count()
+            {
+                uint32_t count = Pod<uint32_t>();
+                return count <= Remaining() ? count : Fail();
+            }
+
+            bool Ok() const { return mOk; }
+            size_t Remaining() const { return static_cast<size_t>(mEnd - mAt); }
+
+          private:
+            const char* mAt;
+            const char* mEnd;
+            bool mOk = true;
+
+            bool Take(size_t bytes)
+            {
+                if(!mOk || Remaining() < bytes)
+                    return mOk = false;
+                mAt += bytes;
+                return true;
+            }
+
+            uint32_t Fail()
+            {
+                mOk = false;
+                return 0;
+            }
+        };
+
+        void WriteCard(SnapshotWriter& out, const Card& card)
+        {
+            out.Pod<int32_t>(card.id.RowId());
+            out.Text(card.title);
+            out.Text(card.description);
+            out.Text(card.coverImage);
+            out.Pod(card.position);
+            out.Pod<int64_t>(card.dueDate);
+            out.Pod<uint8_t>(card.isCompleted);
+
+            out.Pod(static_cast<uint32_t>(card.badges.size()));
+            for(const auto& badge : card.badges)
+            {
+                out.Text(badge);
+            }
+
+            out.Pod(static_cast<uint32_t>(card.checklist.size()));
+            for(const auto& item : card.checklist)
+            {
+                out.Pod<int32_t>(item.id.RowId());
+                out.Text(item.text);
+                out.Pod<uint8_t>(item.isChecked);
+            }
+        }
+
+        void WriteBoard(SnapshotWriter& out, const BoardData& board)
+        {
+            out.Pod<int32_t>(board.id.RowId());
+            out.Text(board.title);
+            out.Text(board.description);
+            out.Text(board.backgroundColor);
+            out.Text(board.backgroundImage);
+            out.Pod(board.createdAt);
+            out.Pod(board.updatedAt);
+            out.Pod<uint8_t>(board.archived);
+
+            // Boards still loading are stored as the summaries they were
+            out.Pod<uint8_t>(board.IsLoaded());
+            out.Pod(static_cast<uint32_t>(board.GetListCount()));
+            out.Pod(static_cast<uint32_t>(board.GetTotalCardCount()));
+            if(!board.IsLoaded())
+                return;
+
+            out.Pod(static_cast<uint32_t>(board.lists.size()));
+            for(const auto& list : board.lists)
+            {
+                out.Pod<int32_t>(list.id.RowId());
+                out.Text(list.title);
+                out.Pod(list.position);
+                out.Pod(static_cast<uint32_t>(list.cards.size()));
+                for(const auto& card : list.cards)
+                {
+                    WriteCard(out, card);
+                }
+            }
+        }
+
+        Card ReadCard(SnapshotReader& in)
+        {
+            Card card;
+            card.id = CardId::FromRow(in.Pod<int32_t>());
+            card.title = in.Text();
+            card.description = in.Text();
+            card.coverImage = in.Text();
+            card.position = in.Pod<double>();
+            card.dueDate = static_cast<time_t>(in.Pod<int64_t>());
+            card.isCompleted = in.Pod<uint8_t>() != 0;
+
+            card.badges.resize(in.Count());
+            for(auto& badge : card.badges)
+            {
+                badge = in.Text();
+            }
+
+            card.checklist.resize(in.Count());
+            for(auto& item : card.checklist)
+            {
+                item.id = ChecklistItemId::FromRow(in.Pod<int32_t>());
+                item.text = in.Text();
+                item.isChecked = in.Pod<uint8_t>() != 0;
+                item.changes.MarkClean();
+            }
+
+            card.changes.MarkClean();
+            return card;
+        }
+
+        BoardData ReadBoard(SnapshotReader& in)
+        {
+            BoardData board;
+            board.id = BoardId::FromRow(in.Pod<int32_t>());
+            board.title = in.Text();
+            board.description = in.Text();
+            board.backgroundColor = in.Text();
+            board.backgroundImage = in.Text();
+            board.createdAt = in.Pod<int64_t>();
+            board.updatedAt = in.Pod<int64_t>();
+            board.archived = in.Pod<uint8_t>() != 0;
+
+            const bool loaded = in.Pod<uint8_t>() != 0;
+            board.loadState = loaded ? BoardLoadState::Loaded : BoardLoadState::Summary;
+            board.summaryListCount = in.Pod<uint32_t>();
+            board.summaryCardCount = in.Pod<uint32_t>();
+            board.changes.MarkClean();
+            if(!loaded)
+                return board;
+
+            board.lists.resize(in.Count());
+            for(auto& list : board.lists)
+            {
+                list.id = ListId::FromRow(in.Pod<int32_t>());
+                list.title = in.Text();
+                list.position = in.Pod<double>();
+                uint32_t cards = in.Count();
+                list.cards.reserve(cards);
+                for(uint32_t i = 0; i < cards && in.Ok(); ++i)
+                {
+                    list.cards.push_back(ReadCard(in));
+                }
+                list.changes.MarkClean();
+            }
+            board.RebuildIndex();
+            return board;
+        }
+    }
+
+    bool BoardSnapshot::Save(const std::vector<BoardData>& boards)
+    {
+        // Runs after every pending write, so the stamp taken next covers all of them
+        bool checkpointed = PersistenceWorker::Run([] { return StorageManager::Checkpoint(); });
+        if(!checkpointed)
+        {
+            GL_WARN("BoardSnapshot::Save - WAL checkpoint incomplete, snapshot not written");
+            return false;
+        }
+
+        return Write(
+            boards,
+            PathManager::Get().GetSnapshotFile(),
+            PathManager::Get().GetDatabaseFile()
+        );
+    }
+
+    std::optional<std::vector<BoardData>> BoardSnapshot::Load()
+    {
+        return Read(PathManager::Get().GetSnapshotFile(), PathManager::Get().GetDatabaseFile());
+    }
+
+    bool BoardSnapshot::Write(
+        const std::vector<BoardData>& boards,
+        const fs::path& snapshotPath,
+        const fs::path& databasePath
+    )
+    {
+        // Only what the database holds may go in, or a valid stamp would vouch for other data
+        for(const auto& board : boards)
+        {
+            if(!board.id.IsPersisted() || board.HasUnsavedChanges())
+            {
+                GL_WARN("BoardSnapshot::Write - '{}' has unsaved changes", board.title);
+                return false;
+            }
+        }
+
+        std::optional<DatabaseStamp> stamp = StampDatabase(databasePath);
+        if(!stamp)
+        {
+            GL_WARN(
+                "BoardSnapshot::Write - \"{}\" is missing or not checkpointed",
+                databasePath.generic_string()
+            );
+            return false;
+        }
+
+        SnapshotWriter payload;
+        payload.Pod(static_cast<uint32_t>(boards.size()));
+        for(const auto& board : boards)
+        {
+            WriteBoard(payload, board);
+        }
+
+        SnapshotWriter header;
+        header.Pod(kMagic);
+        header.Pod(kFormatVersion);
+        header.Stamp(*stamp);
+        header.Pod(static_cast<uint64_t>(payload.Bytes().size()));
+        header.Pod(Checksum(payload.Bytes().data(), payload.Bytes().size()));
+
+        // Written aside and renamed over the old snapshot, so a crash never leaves half a file
+        fs::path tempPath = snapshotPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(header.Bytes().data(), header.Bytes().size());
+            file.write(payload.Bytes().data(), payload.Bytes().size());
+            if(!file)
+            {
+                GL_ERROR("BoardSnapshot::Write - Failed writing \"{}\"", tempPath.generic_string());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, snapshotPath, ec);
+        if(ec)
+        {
+            GL_ERROR("BoardSnapshot::Write - Failed to replace snapshot: {}", ec.message());
+            fs::remove(tempPath, ec);
+            return false;
+        }
+
+        GL_INFO(
+            "Wrote startup snapshot of {} boards ({} KiB)",
+            boards.size(),
+            (header.Bytes().size() + payload.Bytes().size()) / 1024
+        );
+        return true;
+    }
+
+    std::optional<std::vector<BoardData>>
+    BoardSnapshot::Read(const fs::path& snapshotPath, const fs::path& databasePath)
+    {
+        std::ifstream file(snapshotPath, std::ios::binary | std::ios::ate);
+        if(!file.is_open())
+            return std::nullopt;
+
+        // The whole file in one read
+        std::string bytes(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        if(!file.read(bytes.data(), bytes.size()))
+            return std::nullopt;
+
+        SnapshotReader header(bytes.data(), bytes.data() + bytes.size());
+        const uint32_t magic = header.Pod<uint32_t>();
+        const uint32_t version = header.Pod<uint32_t>();
+        const DatabaseStamp stamp = header.Stamp();
+        const uint64_t payloadSize = header.Pod<uint64_t>();
+        const uint64_t checksum = header.Pod<uint64_t>();
+        if(!header.Ok() || magic != kMagic || version != kFormatVersion)
+        {
+            GL_INFO("BoardSnapshot::Read - Unknown snapshot format, using the database");
+            return std::nullopt;
+        }
+
+        std::optional<DatabaseStamp> current = StampDatabase(databasePath);
+        if(!current || !(*current == stamp))
+        {
+            GL_INFO("BoardSnapshot::Read - Database changed since the snapshot, using it instead");
+            return std::nullopt;
+        }
+
+        const char* payloadBegin = bytes.data() + bytes.size() - header.Remaining();
+        if(header.Remaining() != payloadSize
+           || Checksum(payloadBegin, header.Remaining()) != checksum)
+        {
+            GL_WARN("BoardSnapshot::Read - Snapshot is damaged, using the database");
+            return std::nullopt;
+        }
+
+        SnapshotReader payload(payloadBegin, bytes.data() + bytes.size());
+        std::vector<BoardData> boards(payload.Count());
+        for(auto& board : boards)
+        {
+            board = ReadBoard(payload);
+        }
+
+        if(!payload.Ok() || payload.Remaining() != 0)
+        {
+            GL_WARN("BoardSnapshot::Read - Snapshot does not parse, using the database");
+            return std::nullopt;
+        }
+
+        GL_INFO("Loaded {} boards from the startup snapshot", boards.size());
+        return boards;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "managers/BoardData.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace Stride
+{
+    namespace fs = std::filesystem;
+
+    /**
+     * @brief Binary snapshot of the repository, written on a clean exit for an instant cold start.
+     *
+     * Loading boards from SQLite means stepping rows and building a string per column. The
+     * snapshot stores the same boards (summaries, plus the contents of boards that were loaded)
+     * in one length-prefixed blob, read back with a single file read and a checksum pass.
+     *
+     * A snapshot is only trusted while the database is exactly as it was when it was written.
+     * It records a stamp of the database file: size, last write time, and the header's file
+     * change counter and user_version. Saving first checkpoints the WAL into the main file, so
+     * any later commit either leaves a non-empty -wal file or changes the stamp; both reject the
+     * snapshot and startup falls back to the database. So do a version, size or checksum
+     * mismatch.
+     *
+     * Usage:
+     * @code
+     * // On exit, after the boards were saved
+     * BoardSnapshot::Save(repository.GetAll());
+     *
+     * // At startup, before the database is opened
+     * if(auto boards = BoardSnapshot::Load())
+     *     ...
+     * @endcode
+     *
+     * @see BoardRepository::LoadAll, BoardRepository::SaveSnapshot
+     */
+    class BoardSnapshot
+    {
+      public:
+        static constexpr uint32_t kFormatVersion = 1;
+
+        // Checkpoint the database and write the snapshot next to it; false if nothing was written
+        static bool Save(const std::vector<BoardData>& boards);
+
+        // Boards from the snapshot next to the database, if it is still valid
+        static std::optional<std::vector<BoardData>> Load();
+
+        // File level API: Write() expects the database checkpointed and the boards saved
+        static bool Write(
+            const std::vector<BoardData>& boards,
+            const fs::path& snapshotPath,
+            const fs::path& databasePath
+        );
+        static std::optional<std::vector<BoardData>>
+        Read(const fs::path& snapshotPath, const fs::path& databasePath);
+    };
+}
@@ -1,7 +1,11 @@
 #include "pch.h"
 #include "BoardStorageAdapter.h"
 #include "Log.h"
+#include "storage/PersistenceWorker.h"
+#include "storage/ReadConnection.h"
+#include "utilities/WorkerThread.h"
 #include <algorithm>
+#include <future>
 #include <stdexcept>
 
 namespace Stride
@@ -13,88 +17,114 @@ namespace Stride
     std::vector<BoardData> BoardStorageAdapter::LoadAllBoards()
     {
         std::vector<BoardData> boards;
-        
+
         try
         {
-            // Get all board metadata from storage
-            auto storageBoards = StorageManager::GetAllBoards();
-            
+            // Also flushes the writes still queued from this session, which readers can't see
+            auto storageBoards = PersistenceWorker::Run([] {
+                return StorageManager::GetAllBoards();
+            });
+
             GL_INFO("Loading {} boards from database...", storageBoards.size());
-            
-            // Load each board with full data
+
+            // One task per board: the pool threads each read through their own connection
+            std::vector<std::future<BoardData>> loads;
+            loads.reserve(storageBoards.size());
             for(const auto& storageBoard : storageBoards)
+            {
+                loads.push_back(WorkerThread::Enqueue(ReadBoard, storageBoard.id));
+            }
+
+            // Gathered in database order, so callers see the same order as a sequential load
+            boards.reserve(loads.size());
+            for(size_t i = 0; i < loads.size(); ++i)
             {
                 try
                 {
-                    BoardData board = LoadFullBoard(storageBoard.id);
-                    boards.push_back(std::move(board));
+                    boards.push_back(loads[i].get());
                 }
                 catch(const std::exception& e)
                 {
-                    GL_ERROR("Failed to load board {}: {}", storageBoard.id, e.what());
+                    GL_ERROR("Failed to load board {}: {}", storageBoards[i].id, e.what());
                     // Continue loading other boards even if one fails
                 }
             }
-            
+
             GL_INFO("Successfully loaded {} boards", boards.size());
         }
         catch(const std::exception& e)
         {
             GL_ERROR("Failed to load boards: {}", e.what());
         }
-        
+
         return boards;
     }
 
-    BoardData BoardStorageAdapter::LoadFullBoard(int boardId)
+    std::vector<BoardData> BoardStorageAdapter::LoadBoardSummaries()
     {
+        std::vector<BoardData> boards;
+
         try
         {
-            // Load board metadata
-            auto storageBoard = StorageManager::GetBoard(boardId);
-
-            // Load all lists for this board
-            auto storageLists = StorageManager::GetListsInBoard(boardId);
+            auto summaries = PersistenceWorker::Run([] {
+                return StorageManager::GetBoardSummaries();
+            });
 
-            // Load all cards for this board (more efficient than per-list queries)
-            std::vector<Storage::CardData> allCards;
-            for(const auto& list : storageLists)
+            boards.reserve(summaries.size());
+            for(const auto& summary : summaries)
             {
-                auto listCards = StorageManager::GetCardsInList(list.id);
-                allCards.insert(allCards.end(), listCards.begin(), listCards.end());
+                BoardData board;
+                board.id = BoardId::FromRow(summary.board.id);
+                board.title = summary.board.name;
+                board.createdAt = summary.board.created_at;
+                board.updatedAt = summary.board.updated_at;
+                board.loadState = BoardLoadState::Summary;
+                board.summaryListCount = static_cast<size_t>(summary.list_count);
+                board.summaryCardCount = static_cast<size_t>(summary.card_count);
+                board.changes.MarkClean();
+                boards.push_back(std::move(board));
             }
 
-            // Load all checklist items
-            std::vector<Storage::ChecklistItemData> allChecklist;
-            for(const auto& card : allCards)
-            {
-                auto items = StorageManager::GetChecklistItemsForCard(card.id);
-                allChecklist.insert(allChecklist.end(), items.begin(), items.end());
-            }
+            GL_INFO("Loaded {} board summaries", boards.size());
+        }
+        catch(const std::exception& e)
+        {
+            GL_ERROR("Failed to load board summaries: {}", e.what());
+        }
 
-            // Load badges
-            auto badges = StorageManager::GetBadgesInBoard(boardId);
-            std::vector<Storage::CardBadgeData> cardBadgeLinks;
-            for(const auto& card : allCards)
-            {
-                auto cardBadges = StorageManager::GetBadgesForCard(card.id);
-                for(const auto& badge : cardBadges)
-                {
-                    Storage::CardBadgeData link;
-                    link.card_id = card.id;
-                    link.badge_id = badge.id;
-                    cardBadgeLinks.push_back(link);
-                }
-            }
+        return boards;
+    }
+
+    BoardData BoardStorageAdapter::LoadFullBoard(int boardId)
+    {
+        // Readers only see committed rows
+        PersistenceWorker::Flush();
+        return ReadBoard(boardId);
+    }
+
+    std::vector<Storage::JournalEntryData> BoardStorageAdapter::LoadJournalEntries(int boardId)
+    {
+        // Steps persisted by the last save may still be queued
+        PersistenceWorker::Flush();
+        return Storage::ReadConnection::ForThisThread().LoadJournalEntries(boardId);
+    }
+
+    BoardData BoardStorageAdapter::ReadBoard(int boardId)
+    {
+        try
+        {
+            // Fetch every row of the board with a fixed number of set-based queries
+            Storage::BoardBundle bundle
+                = Storage::ReadConnection::ForThisThread().LoadBoardBundle(boardId);
 
             // Convert to domain model
             auto board = FromStorage(
-                storageBoard,
-                storageLists,
-                allCards,
-                allChecklist,
-                badges,
-                cardBadgeLinks
+                bundle.board,
+                bundle.lists,
+                bundle.cards,
+                bundle.checklist,
+                bundle.badges,
+                bundle.cardBadges
             );
 
             GL_INFO(
@@ -116,6 +146,9 @@ namespace Stride
     // ============================================================
     // ENTITY CREATION
     // ============================================================
+    // IDs are reserved up front so the domain object is returned immediately;
+    // the row itself is written by the persistence worker, and the object stays
+    // dirty until ApplyWriteResults() hears that it committed.
 
     BoardData BoardStorageAdapter::CreateBoard(
         const std::string& title,
@@ -125,18 +158,16 @@ namespace Stride
     {
         // Create storage object
         Storage::BoardData storageBoard;
+        storageBoard.id = StorageManager::ReserveId<Storage::BoardData>();
         storageBoard.name = title;
         storageBoard.description = description;
         storageBoard.background_image = backgroundImage;
         storageBoard.created_at = std::time(nullptr);
         storageBoard.updated_at = std::time(nullptr);
 
-        // Insert and get the auto-generated ID
-        int newBoardId = StorageManager::CreateBoard(storageBoard);
-
-        // Create domain object with prefixed ID
+        // Create domain object around the reserved row ID
         BoardData board;
-        board.id = MakeId(newBoardId, "board");
+        board.id = BoardId::FromRow(storageBoard.id);
         board.title = title;
         board.description = description;
         board.backgroundImage = backgroundImage;
@@ -144,81 +175,92 @@ namespace Stride
         board.updatedAt = storageBoard.updated_at;
         board.lists.clear();
 
-        GL_INFO("Created new board '{}' with ID: {}", title, board.id);
+        PersistenceWorker::Submit(
+            WriteKey("board", storageBoard.id),
+            [storageBoard] { StorageManager::UpsertBoard(storageBoard); },
+            Report({ board.id, {}, {}, {}, board.changes.revision })
+        );
+        board.changes.MarkQueued();
+
+        GL_INFO("Created new board '{}' with ID: {}", title, board.id.ToString());
         return board;
     }
 
     CardList BoardStorageAdapter::CreateList(
-        const std::string& boardId,
+        BoardId boardId,
         const std::string& title,
-        int position
+        double position
     )
     {
-        // Convert board ID from string to int
-        int dbBoardId = ParseId(boardId);
+        int dbBoardId = boardId.RowId();
         if(dbBoardId == 0)
         {
-            throw std::invalid_argument("Invalid board ID: " + boardId);
+            throw std::invalid_argument("Board is not persisted: " + boardId.ToString());
         }
 
         // Create storage object
         Storage::ListData storageList;
+        storageList.id = StorageManager::ReserveId<Storage::ListData>();
         storageList.board_id = dbBoardId;
         storageList.name = title;
         storageList.position = position;
         storageList.created_at = std::time(nullptr);
         storageList.updated_at = std::time(nullptr);
 
-        // Insert and get the auto-generated ID
-        int newListId = StorageManager::CreateList(storageList);
-
-        // Create domain object with prefixed ID
+        // Create domain object around the reserved row ID
         CardList list;
-        list.id = MakeId(newListId, "list");
+        list.id = ListId::FromRow(storageList.id);
         list.title = title;
         list.position = position;
         list.cards.clear();
 
-        GL_INFO("Created new list '{}' with ID: {} in board: {}", title, list.id, boardId);
+        PersistenceWorker::Submit(
+            WriteKey("list", storageList.id),
+            [storageList] { StorageManager::UpsertList(storageList); },
+            Report({ boardId, list.id, {}, {}, list.changes.revision })
+        );
+        list.changes.MarkQueued();
+
+        GL_INFO(
+            "Created new list '{}' with ID: {} in board: {}",
+            title,
+            list.id.ToString(),
+            boardId.ToString()
+        );
         return list;
     }
 
     Card BoardStorageAdapter::CreateCard(
-        const std::string& listId,
+        ListId listId,
         const std::string& title,
         const std::string& description,
-        int position
+        double position
     )
     {
-        // Convert list ID from string to int
-        int dbListId = ParseId(listId);
+        int dbListId = listId.RowId();
         if(dbListId == 0)
         {
-            throw std::invalid_argument("Invalid list ID: " + listId);
+            throw std::invalid_argument("List is not persisted: " + listId.ToString());
         }
 
-        // Get board ID from list
-        auto list = StorageManager::GetList(dbListId);
-
         // Create storage object
         Storage::CardData storageCard;
+        storageCard.id = StorageManager::ReserveId<Storage::CardData>();
         storageCard.list_id = dbListId;
-        storageCard.board_id = list.board_id;
+        storageCard.board_id = 0; // Resolved from the list on the worker
         storageCard.title = title;
         storageCard.description = description;
         storageCard.position = position;
         storageCard.cover_image = "";
         storageCard.due_date = 0;
         storageCard.completed = false;
+        storageCard.archived = false;
         storageCard.created_at = std::time(nullptr);
         storageCard.updated_at = std::time(nullptr);
 
-        // Insert and get the auto-generated ID
-        int newCardId = StorageManager::CreateCard(storageCard);
-
-        // Create domain object with prefixed ID
+        // Create domain object around the reserved row ID
         Card card;
-        card.id = MakeId(newCardId, "card");
+        card.id = CardId::FromRow(storageCard.id);
         card.title = title;
         card.description = description;
         card.position = position;
@@ -228,88 +270,114 @@ namespace Stride
         card.badges.clear();
         card.checklist.clear();
 
-        GL_INFO("Created new card '{}' with ID: {} in list: {}", title, card.id, listId);
+        PersistenceWorker::Submit(
+            WriteKey("card", storageCard.id),
+            [storageCard]() mutable {
+                storageCard.board_id = StorageManager::GetList(storageCard.list_id).board_id;
+                StorageManager::UpsertCard(storageCard);
+            },
+            Report({ {}, listId, card.id, {}, card.changes.revision })
+        );
+        card.changes.MarkQueued();
+
+        GL_INFO(
+            "Created new card '{}' with ID: {} in list: {}",
+            title,
+            card.id.ToString(),
+            listId.ToString()
+        );
         return card;
     }
 
     ChecklistItem BoardStorageAdapter::CreateChecklistItem(
-        const std::string& cardId,
+        CardId cardId,
         const std::string& title,
         bool isCompleted,
         int position
     )
     {
-        // Convert card ID from string to int
-        int dbCardId = ParseId(cardId);
+        int dbCardId = cardId.RowId();
         if(dbCardId == 0)
         {
-            throw std::invalid_argument("Invalid card ID: " + cardId);
+            throw std::invalid_argument("Card is not persisted: " + cardId.ToString());
         }
 
         // Create storage object
         Storage::ChecklistItemData storageItem;
+        storageItem.id = StorageManager::ReserveId<Storage::ChecklistItemData>();
         storageItem.card_id = dbCardId;
         storageItem.content = title;
         storageItem.completed = isCompleted;
         storageItem.position = position;
 
-        // Insert and get the auto-generated ID
-        int newItemId = StorageManager::CreateChecklistItem(storageItem);
-
-        // Create domain object with prefixed ID
+        // Create domain object around the reserved row ID
         ChecklistItem item;
-        item.id = MakeId(newItemId, "item");
+        item.id = ChecklistItemId::FromRow(storageItem.id);
         item.text = title;
         item.isChecked = isCompleted;
 
-        GL_INFO("Created new checklist item '{}' with ID: {} in card: {}", title, item.id, cardId);
+        PersistenceWorker::Submit(
+            WriteKey("item", storageItem.id),
+            [storageItem] { StorageManager::UpsertChecklistItem(storageItem); },
+            Report({ {}, {}, cardId, item.id, item.changes.revision })
+        );
+        item.changes.MarkQueued();
+
+        GL_INFO(
+            "Created new checklist item '{}' with ID: {} in card: {}",
+            title,
+            item.id.ToString(),
+            cardId.ToString()
+        );
         return item;
     }
 
     std::string BoardStorageAdapter::CreateBadge(
-        const std::string& cardId,
+        CardId cardId,
         const std::string& text,
         const std::string& colorName
     )
     {
-        // Convert card ID from string to int
-        int dbCardId = ParseId(cardId);
+        int dbCardId = cardId.RowId();
         if(dbCardId == 0)
         {
-            throw std::invalid_argument("Invalid card ID: " + cardId);
+            throw std::invalid_argument("Card is not persisted: " + cardId.ToString());
         }
 
-        // Get card to find board ID
-        auto card = StorageManager::GetCard(dbCardId);
-
-        // Create or get badge
-        Storage::BadgeData storageBadge;
-        storageBadge.board_id = card.board_id;
-        storageBadge.name = text;
-        storageBadge.color = colorName;
+        // Badges are identified by text, so nothing needs to be known before the write
+        PersistenceWorker::Submit(
+            WriteKey("card_badge", dbCardId) + ":" + text,
+            [dbCardId, text, colorName] {
+                // Get card to find board ID
+                auto card = StorageManager::GetCard(dbCardId);
 
-        // Try to find existing badge with same text in this board
-        auto existingBadges = StorageManager::GetBadgesInBoard(card.board_id);
-        int badgeId = 0;
-        for(const auto& badge : existingBadges)
-        {
-            if(badge.name == text)
-            {
-                badgeId = badge.id;
-                break;
-            }
-        }
+                // Try to find existing badge with same text in this board
+                int badgeId = 0;
+                for(const auto& badge : StorageManager::GetBadgesInBoard(card.board_id))
+                {
+                    if(badge.name == text)
+                    {
+                        badgeId = badge.id;
+                        break;
+                    }
+                }
 
-        // Create badge if it doesn't exist
-        if(badgeId == 0)
-        {
-            badgeId = StorageManager::CreateBadge(storageBadge);
-        }
+                // Create badge if it doesn't exist
+                if(badgeId == 0)
+                {
+                    Storage::BadgeData storageBadge;
+                    storageBadge.board_id = card.board_id;
+                    storageBadge.name = text;
+                    storageBadge.color = colorName;
+                    badgeId = StorageManager::CreateBadge(storageBadge);
+                }
 
-        // Link badge to card
-        StorageManager::AddBadgeToCard(dbCardId, badgeId);
+                // Link badge to card
+                StorageManager::AddBadgeToCard(dbCardId, badgeId);
+            }
+        );
 
-        GL_INFO("Added badge '{}' to card: {}", text, cardId);
+        GL_INFO("Added badge '{}' to card: {}", text, cardId.ToString());
         return text;
     }
 
@@ -317,155 +385,390 @@ namespace Stride
     // HIGH-LEVEL OPERATIONS (CONTINUED)
     // ============================================================
 
-    int BoardStorageAdapter::SaveFullBoard(const BoardData& board)
+    int BoardStorageAdapter::SaveFullBoard(BoardData& board, AssignedIds* assigned)
     {
-        try
+        // Runs on the UI thread: new entities get their IDs here, dirty rows are copied into
+        // self-contained commands and the model is marked queued. Nothing touches the database.
+        // The group commits all of them in one transaction, e.g. every card of a batch move.
+        PersistenceWorker::Group group;
+        size_t writesQueued = 0;
+
+        int boardId = board.id.RowId();
+        if(boardId == 0)
         {
-            int boardId = ParseId(board.id);
+            boardId = StorageManager::ReserveId<Storage::BoardData>();
+            if(assigned)
+                (*assigned)[board.id.Raw()] = boardId;
+            board.id = BoardId::FromRow(boardId);
+            board.changes.Touch();
+        }
 
-            // Convert board metadata
+        if(board.changes.NeedsWrite())
+        {
             auto storageBoard = ToStorageBoard(board);
+            storageBoard.id = boardId;
+            PersistenceWorker::Submit(
+                WriteKey("board", boardId),
+                [storageBoard] { StorageManager::UpsertBoard(storageBoard); },
+                Report({ board.id, {}, {}, {}, board.changes.revision })
+            );
+            board.changes.MarkQueued();
+            ++writesQueued;
+        }
 
-            // Create or update board
-            if(boardId == 0)
+        bool idsAssigned = false;
+        for(auto& list : board.lists)
+        {
+            int listId = list.id.RowId();
+            if(listId == 0)
             {
-                boardId = StorageManager::CreateBoard(storageBoard);
-                GL_INFO("Created new board '{}' with DB ID {}", board.title, boardId);
+                listId = StorageManager::ReserveId<Storage::ListData>();
+                if(assigned)
+                    (*assigned)[list.id.Raw()] = listId;
+                list.id = ListId::FromRow(listId);
+                idsAssigned = true;
+                list.changes.Touch();
             }
-            else
+
+            if(list.changes.NeedsWrite())
             {
-                storageBoard.id = boardId;
-                StorageManager::UpdateBoard(storageBoard);
-                GL_INFO("Updated board '{}' (DB ID {})", board.title, boardId);
+                auto storageList = ToStorageList(list, boardId, list.position);
+                storageList.id = listId;
+                PersistenceWorker::Submit(
+                    WriteKey("list", listId),
+                    [storageList] { StorageManager::UpsertList(storageList); },
+                    Report({ board.id, list.id, {}, {}, list.changes.revision })
+                );
+                list.changes.MarkQueued();
+                ++writesQueued;
             }
 
-            // Save lists and cards
-            for(size_t listIdx = 0; listIdx < board.lists.size(); ++listIdx)
+            // Only cards touched since they were last queued are copied out
+            for(auto& card : list.cards)
             {
-                const auto& list = board.lists[listIdx];
-                int listPosition = listIdx;
-
-                // Check if list exists in DB
-                int listId = ParseId(list.id);
-                auto storageList = ToStorageList(list, boardId, listPosition);
+                if(!card.changes.NeedsWrite())
+                    continue;
+
+                idsAssigned |= !card.id.IsPersisted();
+                CardSnapshot snapshot = SnapshotCard(card, listId, boardId, assigned);
+                const std::string key = WriteKey("card", snapshot.row.id);
+                PersistenceWorker::Completion done = Report(std::move(snapshot.written));
+                PersistenceWorker::Submit(
+                    key,
+                    [snapshot = std::move(snapshot)] { WriteCard(snapshot); },
+                    std::move(done)
+                );
+                ++writesQueued;
+            }
 
-                if(listId == 0)
-                {
-                    listId = StorageManager::CreateList(storageList);
-                }
-                else
+            // A pending write of a deleted card is superseded by its deletion
+            for(const auto& removedId : list.removedCardIds)
+            {
+                if(int cardId = removedId.RowId())
                 {
-                    storageList.id = listId;
-                    StorageManager::UpdateList(storageList);
+                    PersistenceWorker::Submit(
+                        WriteKey("card", cardId),
+                        [cardId] { StorageManager::DeleteCard(cardId); },
+                        Report({ board.id, list.id, removedId, {}, 0, {}, true })
+                    );
+                    ++board.deletesInFlight;
+                    ++writesQueued;
                 }
+            }
+            list.removedCardIds.clear();
+        }
 
-                // Save cards in this list
-                for(size_t cardIdx = 0; cardIdx < list.cards.size(); ++cardIdx)
-                {
-                    const auto& card = list.cards[cardIdx];
-                    int cardPosition = cardIdx;
+        // Cascading deletes remove the cards of deleted lists
+        for(const auto& removedId : board.removedListIds)
+        {
+            if(int listId = removedId.RowId())
+            {
+                PersistenceWorker::Submit(
+                    WriteKey("list", listId),
+                    [listId] { StorageManager::DeleteList(listId); },
+                    Report({ board.id, removedId, {}, {}, 0, {}, true })
+                );
+                ++board.deletesInFlight;
+                ++writesQueued;
+            }
+        }
+        board.removedListIds.clear();
 
-                    int cardId = ParseId(card.id);
-                    auto storageCard = ToStorageCard(card, listId, boardId, cardPosition);
+        // Lookups are keyed by ID, so the indexes must learn the row IDs handed out above
+        if(idsAssigned)
+            board.RebuildIndex();
 
-                    if(cardId == 0)
-                    {
-                        cardId = StorageManager::CreateCard(storageCard);
-                    }
-                    else
-                    {
-                        storageCard.id = cardId;
-                        StorageManager::UpdateCard(storageCard);
-                    }
+        if(writesQueued > 0)
+        {
+            GL_INFO("Queued {} writes for board '{}'", writesQueued, board.title);
+        }
+        return boardId;
+    }
 
-                    // Save checklist items
-                    // First, clear existing checklist items
-                    auto existingItems = StorageManager::GetChecklistItemsForCard(cardId);
-                    for(const auto& item : existingItems)
-                    {
-                        StorageManager::DeleteChecklistItem(item.id);
-                    }
+    BoardStorageAdapter::CardSnapshot
+    BoardStorageAdapter::SnapshotCard(Card& card, int listId, int boardId, AssignedIds* assigned)
+    {
+        int cardId = card.id.RowId();
+        if(cardId == 0)
+        {
+            cardId = StorageManager::ReserveId<Storage::CardData>();
+            if(assigned)
+                (*assigned)[card.id.Raw()] = cardId;
+            card.id = CardId::FromRow(cardId);
+        }
 
-                    // Then save new checklist items
-                    for(size_t itemIdx = 0; itemIdx < card.checklist.size(); ++itemIdx)
-                    {
-                        const auto& item = card.checklist[itemIdx];
-                        int itemPosition = itemIdx;
-                        auto storageItem = ToStorageChecklistItem(item, cardId, itemPosition);
-                        StorageManager::CreateChecklistItem(storageItem);
-                    }
+        CardSnapshot snapshot;
+        snapshot.row = ToStorageCard(card, listId, boardId, card.position);
+        snapshot.row.id = cardId;
 
-                    // Save badges (simplified - just recreate associations)
-                    // First remove existing badge associations
-                    auto existingBadges = StorageManager::GetBadgesForCard(cardId);
-                    for(const auto& badge : existingBadges)
-                    {
-                        StorageManager::RemoveBadgeFromCard(cardId, badge.id);
-                    }
+        snapshot.checklist.reserve(card.checklist.size());
+        for(size_t itemIdx = 0; itemIdx < card.checklist.size(); ++itemIdx)
+        {
+            auto& item = card.checklist[itemIdx];
+            int itemId = item.id.RowId();
+            if(itemId == 0)
+            {
+                itemId = StorageManager::ReserveId<Storage::ChecklistItemData>();
+                if(assigned)
+                    (*assigned)[item.id.Raw()] = itemId;
+                item.id = ChecklistItemId::FromRow(itemId);
+            }
 
-                    // Then add new badge associations
-                    for(const auto& badgeName : card.badges)
-                    {
-                        // Find or create badge
-                        auto boardBadges = StorageManager::GetBadgesInBoard(boardId);
-                        int badgeId = 0;
-                        for(const auto& badge : boardBadges)
-                        {
-                            if(badge.name == badgeName)
-                            {
-                                badgeId = badge.id;
-                                break;
-                            }
-                        }
-
-                        if(badgeId == 0)
-                        {
-                            // Create new badge
-                            Storage::BadgeData newBadge;
-                            newBadge.board_id = boardId;
-                            newBadge.name = badgeName;
-                            newBadge.color = "blue"; // Default color
-                            badgeId = StorageManager::CreateBadge(newBadge);
-                        }
-
-                        StorageManager::AddBadgeToCard(cardId, badgeId);
-                    }
-                }
+            auto storageItem = ToStorageChecklistItem(item, cardId, static_cast<int>(itemIdx));
+            storageItem.id = itemId;
+            snapshot.checklist.push_back(std::move(storageItem));
+            snapshot.written.items.emplace_back(item.id, item.changes.revision);
+            item.changes.MarkQueued();
+        }
+
+        snapshot.badges = card.badges;
+        snapshot.written.boardId = BoardId::FromRow(boardId);
+        snapshot.written.listId = ListId::FromRow(listId);
+        snapshot.written.cardId = card.id;
+        snapshot.written.revision = card.changes.revision;
+        card.changes.MarkQueued();
+        return snapshot;
+    }
+
+    BoardStorageAdapter::WriteResultQueue& BoardStorageAdapter::GetWriteResults()
+    {
+        static WriteResultQueue queue;
+        return queue;
+    }
+
+    PersistenceWorker::Completion BoardStorageAdapter::Report(WriteResult result)
+    {
+        return [result = std::move(result)](bool committed) mutable {
+            result.committed = committed;
+            WriteResultQueue& queue = GetWriteResults();
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.results.push_back(std::move(result));
+        };
+    }
+
+    void BoardStorageAdapter::ApplyWriteResults(std::vector<BoardData>& boards)
+    {
+        std::vector<WriteResult> results;
+        {
+            WriteResultQueue& queue = GetWriteResults();
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            results.swap(queue.results);
+        }
+
+        for(const WriteResult& result : results)
+        {
+            for(BoardData& board : boards)
+            {
+                // Entities made by Create*() are looked up on every board
+                if(result.boardId.IsValid() && board.id != result.boardId)
+                    continue;
+                if(ApplyWriteResult(board, result))
+                    break;
+            }
+        }
+    }
+
+    bool BoardStorageAdapter::ApplyWriteResult(BoardData& board, const WriteResult& result)
+    {
+        auto settle = [&result](ChangeTracker& changes, uint32_t revision) {
+            if(result.committed)
+                changes.MarkCommitted(revision);
+            else
+                changes.MarkDropped(revision);
+        };
+
+        if(result.remove)
+        {
+            if(board.deletesInFlight > 0)
+                --board.deletesInFlight;
+            if(result.committed)
+                return true;
+
+            // Handed back, so the next save deletes it again. A card whose list has been
+            // deleted since goes with the list.
+            if(!result.cardId.IsValid())
+                board.removedListIds.push_back(result.listId);
+            else if(CardList* list = board.FindList(result.listId))
+                list->removedCardIds.push_back(result.cardId);
+            return true;
+        }
+
+        if(result.cardId.IsValid())
+        {
+            Card* card = board.FindCard(result.cardId);
+            if(!card)
+                return false;
+
+            if(result.itemId.IsValid())
+            {
+                if(ChecklistItem* item = card->FindChecklistItem(result.itemId))
+                    settle(item->changes, result.revision);
+                return true;
             }
 
-            GL_INFO(
-                "Successfully saved board '{}' with {} lists and {} cards",
-                board.title,
-                board.lists.size(),
-                board.GetTotalCardCount()
+            settle(card->changes, result.revision);
+            for(const auto& [itemId, revision] : result.items)
+            {
+                if(ChecklistItem* item = card->FindChecklistItem(itemId))
+                    settle(item->changes, revision);
+            }
+            return true;
+        }
+
+        if(result.listId.IsValid())
+        {
+            CardList* list = board.FindList(result.listId);
+            if(!list)
+                return false;
+            settle(list->changes, result.revision);
+            return true;
+        }
+
+        settle(board.changes, result.revision);
+        return true;
+    }
+
+    void BoardStorageAdapter::WriteCard(const CardSnapshot& snapshot)
+    {
+        const int cardId = snapshot.row.id;
+        StorageManager::UpsertCard(snapshot.row);
+
+        // Diff against the stored rows so unchanged checklist items are not rewritten
+        std::unordered_map<int, Storage::ChecklistItemData> storedById;
+        for(auto& stored : StorageManager::GetChecklistItemsForCard(cardId))
+        {
+            storedById.emplace(stored.id, std::move(stored));
+        }
+
+        for(const auto& item : snapshot.checklist)
+        {
+            auto it = storedById.find(item.id);
+            if(it == storedById.end())
+            {
+                StorageManager::UpsertChecklistItem(item);
+                continue;
+            }
+
+            const auto& stored = it->second;
+            if(stored.content != item.content || stored.completed != item.completed
+               || stored.position != item.position)
+            {
+                StorageManager::UpsertChecklistItem(item);
+            }
+            storedById.erase(it);
+        }
+
+        // Whatever is left was removed from the card
+        for(const auto& [itemId, stored] : storedById)
+        {
+            StorageManager::DeleteChecklistItem(itemId);
+        }
+
+        WriteCardBadges(cardId, snapshot.row.board_id, snapshot.badges);
+    }
+
+    void BoardStorageAdapter::WriteCardBadges(
+        int cardId,
+        int boardId,
+        const std::vector<std::string>& badgeNames
+    )
+    {
+        auto storedBadges = StorageManager::GetBadgesForCard(cardId);
+        auto isStored = [&](const std::string& name) {
+            return std::any_of(
+                storedBadges.begin(),
+                storedBadges.end(),
+                [&](const Storage::BadgeData& badge) { return badge.name == name; }
             );
+        };
 
-            return boardId;
+        // Unlink badges the card no longer carries
+        for(const auto& badge : storedBadges)
+        {
+            if(std::find(badgeNames.begin(), badgeNames.end(), badge.name) == badgeNames.end())
+            {
+                StorageManager::RemoveBadgeFromCard(cardId, badge.id);
+            }
         }
-        catch(const std::exception& e)
+
+        // Board badges are only fetched when a new link is actually needed
+        std::optional<std::vector<Storage::BadgeData>> boardBadges;
+        for(const auto& badgeName : badgeNames)
         {
-            GL_ERROR("Failed to save board '{}': {}", board.title, e.what());
-            throw;
+            if(isStored(badgeName))
+                continue;
+
+            if(!boardBadges)
+                boardBadges = StorageManager::GetBadgesInBoard(boardId);
+
+            auto it = std::find_if(
+                boardBadges->begin(),
+                boardBadges->end(),
+                [&](const Storage::BadgeData& badge) { return badge.name == badgeName; }
+            );
+
+            int badgeId = 0;
+            if(it != boardBadges->end())
+            {
+                badgeId = it->id;
+            }
+            else
+            {
+                // Create new badge
+                Storage::BadgeData newBadge;
+                newBadge.board_id = boardId;
+                newBadge.name = badgeName;
+                newBadge.color = "blue"; // Default color
+                newBadge.id = StorageManager::CreateBadge(newBadge);
+                badgeId = newBadge.id;
+                boardBadges->push_back(std::move(newBadge));
+            }
+
+            StorageManager::AddBadgeToCard(cardId, badgeId);
         }
     }
 
     void BoardStorageAdapter::UpdateBoardMetadata(const BoardData& board)
     {
-        int boardId = ParseId(board.id);
+        int boardId = board.id.RowId();
         if(boardId == 0)
         {
-            GL_WARN("Cannot update board metadata - invalid board ID: {}", board.id);
+            GL_WARN("Cannot update metadata of unsaved board {}", board.id.ToString());
             return;
         }
 
         auto storageBoard = ToStorageBoard(board);
         storageBoard.id = boardId;
-        StorageManager::UpdateBoard(storageBoard);
+        PersistenceWorker::Submit(WriteKey("board", boardId), [storageBoard] {
+            StorageManager::UpdateBoard(storageBoard);
+        });
     }
 
     void BoardStorageAdapter::DeleteBoard(int boardId)
     {
-        StorageManager::DeleteBoard(boardId);
+        PersistenceWorker::Submit(WriteKey("board", boardId), [boardId] {
+            StorageManager::DeleteBoard(boardId);
+        });
         GL_INFO("Deleted board with DB ID {}", boardId);
     }
 
@@ -476,7 +779,7 @@ namespace Stride
     Storage::BoardData BoardStorageAdapter::ToStorageBoard(const BoardData& board)
     {
         Storage::BoardData storage;
-        storage.id = ParseId(board.id); // Will be 0 for new boards
+        storage.id = board.id.RowId(); // Will be 0 for new boards
         storage.name = board.title;
         storage.created_at = board.createdAt;
         storage.updated_at = board.updatedAt;
@@ -484,10 +787,10 @@ namespace Stride
     }
 
     Storage::ListData
-    BoardStorageAdapter::ToStorageList(const CardList& list, int boardId, int position)
+    BoardStorageAdapter::ToStorageList(const CardList& list, int boardId, double position)
     {
         Storage::ListData storage;
-        storage.id = ParseId(list.id);
+        storage.id = list.id.RowId();
         storage.board_id = boardId;
         storage.name = list.title;
         // Use provided position parameter (usually calculated), or list.position if non-zero
@@ -498,10 +801,10 @@ namespace Stride
     }
 
     Storage::CardData
-    BoardStorageAdapter::ToStorageCard(const Card& card, int listId, int boardId, int position)
+    BoardStorageAdapter::ToStorageCard(const Card& card, int listId, int boardId, double position)
     {
         Storage::CardData storage;
-        storage.id = ParseId(card.id);
+        storage.id = card.id.RowId();
         storage.list_id = listId;
         storage.board_id = boardId;
         storage.title = card.title;
@@ -543,37 +846,48 @@ namespace Stride
     )
     {
         BoardData board;
-        board.id = MakeId(storageBoard.id, "board");
+        board.id = BoardId::FromRow(storageBoard.id);
         board.title = storageBoard.name;
         board.createdAt = storageBoard.created_at;
         board.updatedAt = storageBoard.updated_at;
+        board.changes.MarkClean();
+
+        // Group child rows by parent once so the conversion stays linear in row count
+        std::unordered_map<int, std::vector<const Storage::CardData*>> cardsByList;
+        for(const auto& card : storageCards)
+        {
+            cardsByList[card.list_id].push_back(&card);
+        }
+
+        ChecklistByCard checklistByCard;
+        for(const auto& item : storageChecklist)
+        {
+            checklistByCard[item.card_id].push_back(&item);
+        }
+
+        BadgeNamesByCard badgeNamesByCard = GroupBadgeNamesByCard(storageBadges, cardBadgeLinks);
 
         // Sort lists by position
-        auto sortedLists = storageLists;
-        std::sort(sortedLists.begin(), sortedLists.end(), [](const auto& a, const auto& b) {
-            return a.position < b.position;
+        std::vector<const Storage::ListData*> sortedLists;
+        sortedLists.reserve(storageLists.size());
+        for(const auto& list : storageLists)
+        {
+            sortedLists.push_back(&list);
+        }
+        std::sort(sortedLists.begin(), sortedLists.end(), [](const auto* a, const auto* b) {
+            return a->position < b->position;
         });
 
         // Convert lists
-        for(const auto& storageList : sortedLists)
+        board.lists.reserve(sortedLists.size());
+        for(const auto* storageList : sortedLists)
         {
-            // Filter cards for this list
-            std::vector<Storage::CardData> cardsInList;
-            for(const auto& card : storageCards)
-            {
-                if(card.list_id == storageList.id)
-                {
-                    cardsInList.push_back(card);
-                }
-            }
+            std::vector<const Storage::CardData*> noCards;
+            auto it = cardsByList.find(storageList->id);
+            auto& cardsInList = it != cardsByList.end() ? it->second : noCards;
 
-            auto list = FromStorageList(
-                storageList,
-                cardsInList,
-                storageChecklist,
-                storageBadges,
-                cardBadgeLinks
-            );
+            auto list
+                = FromStorageList(*storageList, cardsInList, checklistByCard, badgeNamesByCard);
             board.lists.push_back(std::move(list));
         }
 
@@ -582,40 +896,34 @@ namespace Stride
 
     CardList BoardStorageAdapter::FromStorageList(
         const Storage::ListData& storageList,
-        const std::vector<Storage::CardData>& cardsInList,
-        const std::vector<Storage::ChecklistItemData>& allChecklist,
-        const std::vector<Storage::BadgeData>& allBadges,
-        const std::vector<Storage::CardBadgeData>& cardBadgeLinks
+        std::vector<const Storage::CardData*>& cardsInList,
+        const ChecklistByCard& checklistByCard,
+        const BadgeNamesByCard& badgeNamesByCard
     )
     {
         CardList list;
-        list.id = MakeId(storageList.id, "list");
+        list.id = ListId::FromRow(storageList.id);
         list.title = storageList.name;
         list.position = storageList.position;
+        list.changes.MarkClean();
 
         // Sort cards by position
-        auto sortedCards = cardsInList;
-        std::sort(sortedCards.begin(), sortedCards.end(), [](const auto& a, const auto& b) {
-            return a.position < b.position;
+        std::sort(cardsInList.begin(), cardsInList.end(), [](const auto* a, const auto* b) {
+            return a->position < b->position;
         });
 
         // Convert cards
-        for(const auto& storageCard : sortedCards)
+        list.cards.reserve(cardsInList.size());
+        for(const auto* storageCard : cardsInList)
         {
-            // Filter checklist items for this card
-            std::vector<Storage::ChecklistItemData> checklistItems;
-            for(const auto& item : allChecklist)
-            {
-                if(item.card_id == storageCard.id)
-                {
-                    checklistItems.push_back(item);
-                }
-            }
-
-            // Get badge names for this card
-            auto badgeNames = GetBadgeNamesForCard(storageCard.id, allBadges, cardBadgeLinks);
+            auto itemsIt = checklistByCard.find(storageCard->id);
+            auto badgesIt = badgeNamesByCard.find(storageCard->id);
 
-            auto card = FromStorageCard(storageCard, checklistItems, badgeNames);
+            auto card = FromStorageCard(
+                *storageCard,
+                itemsIt != checklistByCard.end() ? &itemsIt->second : nullptr,
+                badgesIt != badgeNamesByCard.end() ? &badgesIt->second : nullptr
+            );
             list.cards.push_back(std::move(card));
         }
 
@@ -624,27 +932,37 @@ namespace Stride
 
     Card BoardStorageAdapter::FromStorageCard(
         const Storage::CardData& storageCard,
-        const std::vector<Storage::ChecklistItemData>& checklistItems,
-        const std::vector<std::string>& badgeNames
+        const std::vector<const Storage::ChecklistItemData*>* checklistItems,
+        const std::vector<std::string>* badgeNames
     )
     {
         Card card;
-        card.id = MakeId(storageCard.id, "card");
+        card.id = CardId::FromRow(storageCard.id);
         card.title = storageCard.title;
         card.description = storageCard.description;
         card.position = storageCard.position;
-        card.badges = badgeNames;
+        card.changes.MarkClean();
+        if(badgeNames)
+        {
+            card.badges = *badgeNames;
+        }
+
+        if(!checklistItems)
+        {
+            return card;
+        }
 
         // Sort checklist items by position
-        auto sortedItems = checklistItems;
-        std::sort(sortedItems.begin(), sortedItems.end(), [](const auto& a, const auto& b) {
-            return a.position < b.position;
+        auto sortedItems = *checklistItems;
+        std::sort(sortedItems.begin(), sortedItems.end(), [](const auto* a, const auto* b) {
+            return a->position < b->position;
         });
 
         // Convert checklist items
-        for(const auto& item : sortedItems)
+        card.checklist.reserve(sortedItems.size());
+        for(const auto* item : sortedItems)
         {
-            card.checklist.push_back(FromStorageChecklistItem(item));
+            card.checklist.push_back(FromStorageChecklistItem(*item));
         }
 
         return card;
@@ -654,89 +972,46 @@ namespace Stride
     BoardStorageAdapter::FromStorageChecklistItem(const Storage::ChecklistItemData& item)
     {
         ChecklistItem checklistItem;
-        checklistItem.id = MakeId(item.id, "item");
+        checklistItem.id = ChecklistItemId::FromRow(item.id);
         checklistItem.text = item.content;
         checklistItem.isChecked = item.completed;
+        checklistItem.changes.MarkClean();
         return checklistItem;
     }
 
     // ============================================================
-    // ID CONVERSION (Prefixed String IDs)
+    // PERSISTENCE QUEUE KEYS
     // ============================================================
 
-    std::string BoardStorageAdapter::MakeId(int dbId, const std::string& prefix)
-    {
-        return prefix + "_" + std::to_string(dbId);
-    }
-
-    int BoardStorageAdapter::ParseId(const std::string& stringId)
-    {
-        if(stringId.empty())
-            return 0;
-
-        size_t pos = stringId.find('_');
-        if(pos == std::string::npos)
-        {
-            // Try parsing as plain number (for backward compatibility)
-            try
-            {
-                return std::stoi(stringId);
-            }
-            catch(...)
-            {
-                return 0;
-            }
-        }
-
-        try
-        {
-            return std::stoi(stringId.substr(pos + 1));
-        }
-        catch(...)
-        {
-            return 0;
-        }
-    }
-
-    bool BoardStorageAdapter::HasPrefix(const std::string& stringId, const std::string& prefix)
+    std::string BoardStorageAdapter::WriteKey(const std::string& table, int dbId)
     {
-        std::string expectedPrefix = prefix + "_";
-        return stringId.size() > expectedPrefix.size()
-               && stringId.compare(0, expectedPrefix.size(), expectedPrefix) == 0;
+        return table + ":" + std::to_string(dbId);
     }
 
     // ============================================================
     // HELPER FUNCTIONS
     // ============================================================
 
-    std::vector<std::string> BoardStorageAdapter::GetBadgeNamesForCard(
-        int cardId,
+    BoardStorageAdapter::BadgeNamesByCard BoardStorageAdapter::GroupBadgeNamesByCard(
         const std::vector<Storage::BadgeData>& allBadges,
         const std::vector<Storage::CardBadgeData>& cardBadgeLinks
     )
     {
-        std::vector<std::string> badgeNames;
-
-        // Find all badge IDs for this card
-        std::vector<int> badgeIds;
-        for(const auto& link : cardBadgeLinks)
+        // Index badges by ID so each link resolves in constant time
+        std::unordered_map<int, const Storage::BadgeData*> badgesById;
+        badgesById.reserve(allBadges.size());
+        for(const auto& badge : allBadges)
         {
-            if(link.card_id == cardId)
-            {
-                badgeIds.push_back(link.badge_id);
-            }
+            badgesById.emplace(badge.id, &badge);
         }
 
-        // Look up badge names
-        for(int badgeId : badgeIds)
+        BadgeNamesByCard badgeNames;
+        for(const auto& link : cardBadgeLinks)
         {
-            for(const auto& badge : allBadges)
+            auto it = badgesById.find(link.badge_id);
+            if(it != badgesById.end())
             {
-                if(badge.id == badgeId)
-                {
-                    badgeNames.push_back(badge.name);
-                    break;
-                }
+                badgeNames[link.card_id].push_back(it->second->name);
             }
         }
 
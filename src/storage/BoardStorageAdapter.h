@@ -4,8 +4,13 @@
 #include "CardList.h"
 #include "storage/Storage.h"
 #include "storage/StorageManager.h"
+#include "storage/PersistenceWorker.h"
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Stride
@@ -18,7 +23,7 @@ namespace Stride
      * - Storage models (Storage::BoardData, CardData, ListData) used by SQLite
      *
      * Key Responsibilities:
-     * - ID mapping: Domain string IDs ↔ Storage integer IDs
+     * - ID mapping: Domain EntityId handles ↔ Storage integer row IDs
      * - Structure flattening: Nested domain objects → Flat relational tables
      * - Position management: Array indices → Fractional positioning
      * - Timestamp handling: Domain timestamps ↔ Unix epochs
@@ -51,29 +56,63 @@ namespace Stride
 
         /**
          * @brief Load all boards with their complete data from database.
-         * @return Vector of all boards with nested lists and cards
+         * @return Vector of all boards with nested lists and cards, in database order
+         *
+         * Boards are hydrated in parallel on the WorkerThread pool, each task reading through
+         * its thread's ReadConnection. Boards that fail to load are logged and left out.
          */
         static std::vector<BoardData> LoadAllBoards();
 
+        /**
+         * @brief Load every board as a summary: metadata plus list and card counts.
+         * @return Boards in BoardLoadState::Summary with empty lists, for a cheap startup
+         * @see LoadFullBoard to hydrate one of them
+         */
+        static std::vector<BoardData> LoadBoardSummaries();
+
         /**
          * @brief Load a complete board with all lists and cards from database.
          * @param boardId Database ID of the board
          * @return Fully populated BoardData with nested lists and cards
          * @throws std::runtime_error if board not found
+         * @note Safe to call from any thread; it reads through that thread's ReadConnection.
          */
         static BoardData LoadFullBoard(int boardId);
 
         /**
-         * @brief Save a complete board with all lists and cards to database.
-         * @param board Domain board to persist
+         * @brief Load the stored undo steps of a board, for UndoJournal::Load.
+         * @param boardId Database ID of the board
+         * @return Journal rows, oldest first
+         * @note Safe to call from any thread; it reads through that thread's ReadConnection.
+         */
+        static std::vector<Storage::JournalEntryData> LoadJournalEntries(int boardId);
+
+        /**
+         * @brief Persist every change made to a board since its last save.
+         * @param board Domain board to persist (IDs of new entities are written back)
+         * @param assigned If set, receives the row ID given to each transient entity
          * @return Database ID of the saved board (new or existing)
          *
-         * This performs a full save:
-         * - Inserts/updates board record
-         * - Inserts/updates all lists
-         * - Inserts/updates all cards with checklists and badges
+         * This performs an incremental save driven by each entity's ChangeTracker:
+         * - Reserves database IDs for new boards, lists, cards and checklist items
+         * - Snapshots only dirty rows (a one-card edit queues O(1) writes)
+         * - Diffs checklist items and badge links of dirty cards on the worker
+         * - Deletes lists and cards recorded as removed
+         *
+         * Returns without touching the database: the writes are queued on the
+         * PersistenceWorker, which coalesces them and commits them in one batch. The entities
+         * stay dirty until ApplyWriteResults() hears that their writes committed.
+         */
+        static int SaveFullBoard(BoardData& board, AssignedIds* assigned = nullptr);
+
+        /**
+         * @brief Main thread: mark entities whose queued writes have committed as saved.
+         * @param boards Every board in memory
+         *
+         * An entity whose write was dropped stays dirty and is queued again by the next save;
+         * a dropped delete is handed back to its board the same way.
          */
-        static int SaveFullBoard(const BoardData& board);
+        static void ApplyWriteResults(std::vector<BoardData>& boards);
 
         /**
          * @brief Update only the board metadata (title, timestamps, etc).
@@ -107,39 +146,38 @@ namespace Stride
 
         /**
          * @brief Create a new list in the database.
-         * @param boardId Parent board ID (prefixed string)
+         * @param boardId Parent board (must already be persisted)
          * @param title List title
          * @param position Position for ordering
          * @return CardList with database-generated ID
          */
-        static CardList
-        CreateList(const std::string& boardId, const std::string& title, int position);
+        static CardList CreateList(BoardId boardId, const std::string& title, double position);
 
         /**
          * @brief Create a new card in the database.
-         * @param listId Parent list ID (prefixed string)
+         * @param listId Parent list (must already be persisted)
          * @param title Card title
          * @param description Card description
          * @param position Position for ordering
          * @return Card with database-generated ID
          */
         static Card CreateCard(
-            const std::string& listId,
+            ListId listId,
             const std::string& title,
             const std::string& description,
-            int position
+            double position
         );
 
         /**
          * @brief Create a new checklist item in the database.
-         * @param cardId Parent card ID (prefixed string)
+         * @param cardId Parent card (must already be persisted)
          * @param title Item title
          * @param isCompleted Completion status
          * @param position Position for ordering
          * @return ChecklistItem with database-generated ID
          */
         static ChecklistItem CreateChecklistItem(
-            const std::string& cardId,
+            CardId cardId,
             const std::string& title,
             bool isCompleted,
             int position
@@ -147,13 +185,13 @@ namespace Stride
 
         /**
          * @brief Create a new badge and attach it to a card.
-         * @param cardId Parent card ID (prefixed string)
+         * @param cardId Parent card (must already be persisted)
          * @param text Badge text/label
          * @param colorName Color scheme name
          * @return Badge text (badges are identified by text, not IDs)
          */
         static std::string CreateBadge(
-            const std::string& cardId,
+            CardId cardId,
             const std::string& text,
             const std::string& colorName
         );
@@ -164,9 +202,10 @@ namespace Stride
 
         // Domain → Storage conversion
         static Storage::BoardData ToStorageBoard(const BoardData& board);
-        static Storage::ListData ToStorageList(const CardList& list, int boardId, int position);
+        static Storage::ListData
+        ToStorageList(const CardList& list, int boardId, double position);
         static Storage::CardData
-        ToStorageCard(const Card& card, int listId, int boardId, int position);
+        ToStorageCard(const Card& card, int listId, int boardId, double position);
         static Storage::ChecklistItemData
         ToStorageChecklistItem(const ChecklistItem& item, int cardId, int position);
 
@@ -180,53 +219,79 @@ namespace Stride
             const std::vector<Storage::CardBadgeData>& cardBadgeLinks
         );
 
-        // ============================================================
-        // ID CONVERSION (Prefixed String IDs)
-        // ============================================================
+      private:
+        // Any thread: read and convert one board, without flushing pending writes first
+        static BoardData ReadBoard(int boardId);
 
-        /**
-         * @brief Create a prefixed domain ID from database integer ID.
-         * @param dbId Database integer ID
-         * @param prefix Entity type prefix ("board", "list", "card", "item")
-         * @return Prefixed string ID (e.g., "card_123")
-         */
-        static std::string MakeId(int dbId, const std::string& prefix);
+        // Rows grouped by their parent card, built once per load
+        using ChecklistByCard
+            = std::unordered_map<int, std::vector<const Storage::ChecklistItemData*>>;
+        using BadgeNamesByCard = std::unordered_map<int, std::vector<std::string>>;
 
-        /**
-         * @brief Parse database integer ID from prefixed domain ID.
-         * @param stringId Prefixed domain ID (e.g., "card_123")
-         * @return Database integer ID, or 0 if invalid format
-         */
-        static int ParseId(const std::string& stringId);
+        // Outcome of one queued write, passed from the persistence worker to the main thread.
+        // The most specific valid ID names the entity; Create*() writes leave the board unset.
+        struct WriteResult
+        {
+            BoardId boardId;
+            ListId listId;
+            CardId cardId;
+            ChecklistItemId itemId;
+            uint32_t revision = 0; // Of the entity's ChangeTracker when queued
+            std::vector<std::pair<ChecklistItemId, uint32_t>> items; // Card writes
+            bool remove = false;
+            bool committed = false;
+        };
 
-        /**
-         * @brief Check if a string ID has a specific prefix.
-         * @param stringId Domain ID to check
-         * @param prefix Expected prefix (e.g., "card")
-         * @return true if ID starts with prefix_
-         */
-        static bool HasPrefix(const std::string& stringId, const std::string& prefix);
+        struct WriteResultQueue
+        {
+            std::mutex mutex;
+            std::vector<WriteResult> results;
+        };
+        static WriteResultQueue& GetWriteResults();
+
+        // Completion that queues `result` for the next ApplyWriteResults()
+        static PersistenceWorker::Completion Report(WriteResult result);
+
+        // False if the entity is not on this board
+        static bool ApplyWriteResult(BoardData& board, const WriteResult& result);
+
+        // Self-contained copy of a dirty card, written by the persistence worker
+        struct CardSnapshot
+        {
+            Storage::CardData row;
+            std::vector<Storage::ChecklistItemData> checklist;
+            std::vector<std::string> badges;
+            WriteResult written;
+        };
+
+        // UI thread: reserves IDs for new rows and marks the card queued
+        static CardSnapshot
+        SnapshotCard(Card& card, int listId, int boardId, AssignedIds* assigned);
+
+        // Persistence worker: diff the snapshot against the stored rows and write the changes
+        static void WriteCard(const CardSnapshot& snapshot);
+        static void
+        WriteCardBadges(int cardId, int boardId, const std::vector<std::string>& badgeNames);
+
+        // Coalescing key of a row in the persistence queue (e.g. "card:42")
+        static std::string WriteKey(const std::string& table, int dbId);
 
-      private:
         // Helper functions
-        static int CalculatePosition(size_t index, size_t total);
         static CardList FromStorageList(
             const Storage::ListData& storageList,
-            const std::vector<Storage::CardData>& cardsInList,
-            const std::vector<Storage::ChecklistItemData>& allChecklist,
-            const std::vector<Storage::BadgeData>& allBadges,
-            const std::vector<Storage::CardBadgeData>& cardBadgeLinks
+            std::vector<const Storage::CardData*>& cardsInList,
+            const ChecklistByCard& checklistByCard,
+            const BadgeNamesByCard& badgeNamesByCard
         );
         static Card FromStorageCard(
             const Storage::CardData& storageCard,
-            const std::vector<Storage::ChecklistItemData>& checklistItems,
-            const std::vector<std::string>& badgeNames
+            const std::vector<const Storage::ChecklistItemData*>* checklistItems,
+            const std::vector<std::string>* badgeNames
         );
         static ChecklistItem FromStorageChecklistItem(const Storage::ChecklistItemData& item);
 
         // Badge helpers
-        static std::vector<std::string> GetBadgeNamesForCard(
-            int cardId,
+        static BadgeNamesByCard GroupBadgeNamesByCard(
             const std::vector<Storage::BadgeData>& allBadges,
             const std::vector<Storage::CardBadgeData>& cardBadgeLinks
         );
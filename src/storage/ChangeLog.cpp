@@ -0,0 +1,313 @@
+#include "pch.h"
+#include "ChangeLog.h"
+#include "Log.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Storage
+{
+    namespace
+    {
+        constexpr int kTriggerCount = 20;
+        constexpr const char* kNow = "CAST(strftime('%s', 'now') AS INTEGER)";
+
+        struct TrackedColumn
+        {
+            const char* column;
+            int field;
+        };
+
+        struct TrackedTable
+        {
+            const char* table;
+            ChangeEntity entity;
+            const char* boardColumn; // Null: the board is found through card_id
+            // Delete is only logged while this row's parent exists; a cascade is implied by it
+            const char* parentGuard;
+            std::vector<TrackedColumn> columns;
+        };
+
+        const TrackedTable kTrackedTables[] = {
+            { "boards",
+              ChangeEntity::Board,
+              "id",
+              nullptr,
+              { { "name", ChangeField::Title } } },
+            { "lists",
+              ChangeEntity::List,
+              "board_id",
+              "EXISTS (SELECT 1 FROM boards WHERE id = OLD.board_id)",
+              { { "name", ChangeField::Title },
+                { "position", ChangeField::Position },
+                { "board_id", ChangeField::Parent } } },
+            { "cards",
+              ChangeEntity::Card,
+              "board_id",
+              // Cards reference their board directly too, so either delete cascades to them
+              "EXISTS (SELECT 1 FROM lists WHERE id = OLD.list_id) "
+              "AND EXISTS (SELECT 1 FROM boards WHERE id = OLD.board_id)",
+              { { "title", ChangeField::Title },
+                { "description", ChangeField::Body },
+                { "position", ChangeField::Position },
+                { "list_id", ChangeField::Parent },
+                { "board_id", ChangeField::Parent },
+                { "due_date", ChangeField::State },
+                { "completed", ChangeField::State },
+                { "archived", ChangeField::State },
+                { "cover_color", ChangeField::Appearance },
+                { "cover_image", ChangeField::Appearance } } },
+            { "checklist_items",
+              ChangeEntity::ChecklistItem,
+              nullptr,
+              "EXISTS (SELECT 1 FROM cards WHERE id = OLD.card_id)",
+              { { "content", ChangeField::Title },
+                { "position", ChangeField::Position },
+                { "completed", ChangeField::State },
+                { "card_id", ChangeField::Parent } } },
+            { "badges",
+              ChangeEntity::Badge,
+              "board_id",
+              "EXISTS (SELECT 1 FROM boards WHERE id = OLD.board_id)",
+              { { "name", ChangeField::Title }, { "color", ChangeField::Appearance } } },
+            { "comments",
+              ChangeEntity::Comment,
+              nullptr,
+              "EXISTS (SELECT 1 FROM cards WHERE id = OLD.card_id)",
+              { { "content", ChangeField::Title }, { "card_id", ChangeField::Parent } } },
+        };
+
+        std::string Value(int value) { return std::to_string(value); }
+
+        std::string Value(ChangeEntity entity) { return Value(static_cast<int>(entity)); }
+
+        std::string Value(ChangeOp op) { return Value(static_cast<int>(op)); }
+
+        bool Exec(sqlite3* db, const std::string& sql)
+        {
+            char* error = nullptr;
+            if(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+            {
+                GL_ERROR("ChangeLog - \"{}\" failed: {}", sql, error ? error : "unknown");
+                sqlite3_free(error);
+                return false;
+            }
+            return true;
+        }
+
+        int64_t QueryInt64(sqlite3* db, const std::string& sql)
+        {
+            int64_t result = 0;
+            sqlite3_stmt* stmt = nullptr;
+            if(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+                return result;
+            if(sqlite3_step(stmt) == SQLITE_ROW)
+                result = sqlite3_column_int64(stmt, 0);
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        std::string BoardOfCard(const std::string& cardId)
+        {
+            return "IFNULL((SELECT board_id FROM cards WHERE id = " + cardId + "), 0)";
+        }
+
+        std::string BoardOf(const TrackedTable& table, const std::string& row)
+        {
+            return table.boardColumn ? row + table.boardColumn : BoardOfCard(row + "card_id");
+        }
+
+        // Sum of the field bits whose columns differ between OLD and NEW
+        std::string ChangedFields(const TrackedTable& table)
+        {
+            std::string sql;
+            for(const auto& column : table.columns)
+            {
+                if(!sql.empty())
+                    sql += " | ";
+                sql += "((OLD." + std::string(column.column) + " IS NOT NEW." + column.column
+                     + ") * " + Value(column.field) + ")";
+            }
+            return "(" + sql + ")";
+        }
+
+        std::string AppendChange(
+            ChangeEntity entity,
+            const std::string& entityId,
+            const std::string& boardId,
+            ChangeOp op,
+            const std::string& fields
+        )
+        {
+            return "INSERT INTO changes(entity, entity_id, board_id, op, fields, created_at) "
+                   "VALUES("
+                 + Value(entity) + ", " + entityId + ", " + boardId + ", " + Value(op) + ", "
+                 + fields + ", " + kNow + ");";
+        }
+
+        std::vector<std::string> TriggerStatements()
+        {
+            std::vector<std::string> statements;
+            for(const auto& tracked : kTrackedTables)
+            {
+                const std::string table = tracked.table;
+                const std::string prefix = "CREATE TRIGGER IF NOT EXISTS changes_" + table;
+                const std::string fields = ChangedFields(tracked);
+
+                statements.push_back(
+                    prefix + "_insert AFTER INSERT ON " + table + " BEGIN "
+                    + AppendChange(
+                        tracked.entity,
+                        "NEW.id",
+                        BoardOf(tracked, "NEW."),
+                        ChangeOp::Insert,
+                        "0"
+                    )
+                    + " END"
+                );
+
+                // A save rewrites every column, updated_at included; only real edits count
+                statements.push_back(
+                    prefix + "_update AFTER UPDATE ON " + table + " WHEN " + fields
+                    + " <> 0 BEGIN "
+                    + AppendChange(
+                        tracked.entity,
+                        "NEW.id",
+                        BoardOf(tracked, "NEW."),
+                        ChangeOp::Update,
+                        fields
+                    )
+                    + " END"
+                );
+
+                std::string guard;
+                if(tracked.parentGuard)
+                    guard = std::string(" WHEN ") + tracked.parentGuard;
+                statements.push_back(
+                    prefix + "_delete AFTER DELETE ON " + table + guard + " BEGIN "
+                    + AppendChange(
+                        tracked.entity,
+                        "OLD.id",
+                        BoardOf(tracked, "OLD."),
+                        ChangeOp::Delete,
+                        "0"
+                    )
+                    + " END"
+                );
+            }
+
+            // Badge links have no ID of their own: they are part of the card
+            const std::string linkChange = Value(ChangeField::Badges);
+            statements.push_back(
+                "CREATE TRIGGER IF NOT EXISTS changes_card_badges_insert AFTER INSERT ON "
+                "card_badges BEGIN "
+                + AppendChange(
+                    ChangeEntity::Card,
+                    "NEW.card_id",
+                    BoardOfCard("NEW.card_id"),
+                    ChangeOp::Update,
+                    linkChange
+                )
+                + " END"
+            );
+            statements.push_back(
+                "CREATE TRIGGER IF NOT EXISTS changes_card_badges_delete AFTER DELETE ON "
+                "card_badges WHEN EXISTS (SELECT 1 FROM cards c JOIN boards b ON b.id = c.board_id "
+                "WHERE c.id = OLD.card_id) BEGIN "
+                + AppendChange(
+                    ChangeEntity::Card,
+                    "OLD.card_id",
+                    BoardOfCard("OLD.card_id"),
+                    ChangeOp::Update,
+                    linkChange
+                )
+                + " END"
+            );
+            return statements;
+        }
+    }
+
+    void EnsureChangeLog(sqlite3* db)
+    {
+        const int64_t triggers = QueryInt64(
+            db,
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name LIKE 'changes\\_%' "
+            "ESCAPE '\\'"
+        );
+        if(triggers == kTriggerCount)
+            return;
+
+        bool ok = Exec(db, "SAVEPOINT change_log");
+        for(const auto& statement : TriggerStatements())
+        {
+            ok = ok && Exec(db, statement);
+        }
+
+        if(!ok)
+            Exec(db, "ROLLBACK TO change_log");
+        Exec(db, "RELEASE change_log");
+    }
+
+    int64_t LatestChangeSeq(sqlite3* db)
+    {
+        // AUTOINCREMENT keeps the highest seq here even after compaction deleted its row
+        return QueryInt64(db, "SELECT seq FROM sqlite_sequence WHERE name = 'changes'");
+    }
+
+    int64_t LastCompactedSeq(sqlite3* db)
+    {
+        return QueryInt64(db, "SELECT IFNULL(MAX(seq), 0) FROM change_checkpoints");
+    }
+
+    bool CompactChangeLog(sqlite3* db, int64_t now, int64_t retained)
+    {
+        const int64_t cutoff = LatestChangeSeq(db) - retained;
+        if(cutoff <= LastCompactedSeq(db))
+            return false;
+
+        const std::string upTo = "seq <= " + std::to_string(cutoff);
+        const std::string latestPerEntity
+            = "SELECT MAX(seq) FROM changes WHERE " + upTo + " GROUP BY entity, entity_id";
+        const std::string tombstones = upTo + " AND op = " + Value(ChangeOp::Delete)
+                                     + " AND created_at < " + std::to_string(now - kTombstoneAge);
+
+        bool ok = Exec(db, "SAVEPOINT change_compaction");
+
+        // The kept row stands for every change it replaces
+        ok = ok
+          && Exec(
+                 db,
+                 "UPDATE changes SET fields = " + Value(kAllFields) + " WHERE seq IN ("
+                     + latestPerEntity + " HAVING COUNT(*) > 1)"
+             )
+          && Exec(
+                 db,
+                 "DELETE FROM changes WHERE " + upTo + " AND seq NOT IN (" + latestPerEntity + ")"
+             );
+
+        // A cursor before a purged delete would never see it
+        const int64_t rescanBelow = std::max(
+            QueryInt64(db, "SELECT IFNULL(MAX(seq), 0) FROM changes WHERE " + tombstones),
+            QueryInt64(db, "SELECT IFNULL(MAX(rescan_below), 0) FROM change_checkpoints")
+        );
+        ok = ok && Exec(db, "DELETE FROM changes WHERE " + tombstones)
+          && Exec(
+                 db,
+                 "INSERT INTO change_checkpoints(seq, rescan_below, created_at) VALUES("
+                     + std::to_string(cutoff) + ", " + std::to_string(rescanBelow) + ", "
+                     + std::to_string(now) + ")"
+             )
+          // Only the newest checkpoint is ever read
+          && Exec(
+                 db,
+                 "DELETE FROM change_checkpoints WHERE id < (SELECT MAX(id) FROM "
+                 "change_checkpoints)"
+             );
+
+        if(!ok)
+            Exec(db, "ROLLBACK TO change_compaction");
+        Exec(db, "RELEASE change_compaction");
+        return ok;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+
+struct sqlite3;
+
+namespace Storage
+{
+    // Values match Stride::EntityKind where both exist
+    enum class ChangeEntity : int
+    {
+        Board = 1,
+        List = 2,
+        Card = 3,
+        ChecklistItem = 4,
+        Badge = 5,
+        Comment = 6
+    };
+
+    enum class ChangeOp : int
+    {
+        Insert = 1,
+        Update = 2,
+        Delete = 3
+    };
+
+    // Column groups an update touched, stored in ChangeData::fields
+    namespace ChangeField
+    {
+        constexpr int Title = 1 << 0;      // Board, list and card titles, item and comment text
+        constexpr int Body = 1 << 1;       // Card description
+        constexpr int Position = 1 << 2;   // Rank within the parent
+        constexpr int Parent = 1 << 3;     // Moved to another board, list or card
+        constexpr int State = 1 << 4;      // Completed, archived, due date
+        constexpr int Appearance = 1 << 5; // Cover and badge colours
+        constexpr int Badges = 1 << 6;     // A card's badge links
+    }
+    constexpr int kAllFields = -1;
+
+    /**
+     * @brief Append-only log of every row written to the board tables, for incremental sync.
+     *
+     * Triggers on boards, lists, cards, checklist items, badges, comments and card badge links
+     * append one row per insert, update and delete to `changes`, inside the transaction of the
+     * write itself, so the log can never disagree with the data. Each row names the entity, its
+     * board, the operation and which column groups an update touched; the row itself stays the
+     * source of truth. Updates that change nothing but updated_at are not logged, and deleting
+     * a row whose parent is already gone (a cascade) is implied by the parent's delete.
+     *
+     * Consumers (backups, exports, the search index) keep the seq they processed last and read
+     * only what follows it:
+     * @code
+     * auto changes = StorageManager::GetChangesSince(cursor);
+     * if(cursor < StorageManager::GetChangeLogCheckpoint().rescan_below)
+     *     RescanEverything();
+     * @endcode
+     *
+     * Compaction keeps the newest kRetainedChanges rows as they are and folds older ones into
+     * the latest row per entity, with every field marked changed; Insert and Update therefore
+     * both mean "read the current row". Deletes older than kTombstoneAge are dropped, and the
+     * checkpoint row records the seq below which a cursor may have missed one. The log stays
+     * within the recent window plus one row per entity.
+     *
+     * All functions must run on the connection's thread (the PersistenceWorker).
+     */
+    constexpr int64_t kRetainedChanges = 10000;
+    constexpr int64_t kCompactionStep = 10000;            // New rows before compacting again
+    constexpr int64_t kTombstoneAge = 30 * 24 * 60 * 60; // Seconds
+
+    // Create the triggers if missing (sync_schema() drops them when it recreates a table)
+    void EnsureChangeLog(sqlite3* db);
+
+    // Highest seq ever handed out, 0 for an empty log
+    int64_t LatestChangeSeq(sqlite3* db);
+
+    // Seq of the newest checkpoint, 0 before the first compaction
+    int64_t LastCompactedSeq(sqlite3* db);
+
+    /**
+     * @brief Fold changes older than the newest `retained` into a checkpoint.
+     * @param now Unix time, deletes logged before now - kTombstoneAge are purged
+     * @return false if there was nothing to compact or a statement failed (rolled back)
+     */
+    bool CompactChangeLog(sqlite3* db, int64_t now, int64_t retained = kRetainedChanges);
+}
@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "ConnectionProfile.h"
+#include "Log.h"
+#include "nlohmann/json.hpp"
+#include <sqlite3.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+
+namespace Storage
+{
+    namespace
+    {
+        constexpr std::array<const char*, 6> kJournalModes
+            = { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" };
+        constexpr std::array<const char*, 4> kSynchronousModes
+            = { "OFF", "NORMAL", "FULL", "EXTRA" };
+
+        // PRAGMA values are spliced into SQL, so only known keywords are accepted
+        template<size_t N>
+        std::string Validated(
+            std::string value,
+            const std::array<const char*, N>& allowed,
+            const std::string& fallback
+        )
+        {
+            std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+                return static_cast<char>(std::toupper(c));
+            });
+            auto it = std::find_if(allowed.begin(), allowed.end(), [&](const char* mode) {
+                return value == mode;
+            });
+            return it != allowed.end() ? value : fallback;
+        }
+
+        void Exec(sqlite3* db, const std::string& sql)
+        {
+            char* error = nullptr;
+            if(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+            {
+                GL_WARN("ConnectionProfile - \"{}\" failed: {}", sql, error ? error : "unknown");
+                sqlite3_free(error);
+            }
+        }
+    }
+
+    void ConnectionProfile::Apply(sqlite3* db) const
+    {
+        // busy_timeout first so the remaining PRAGMAs wait out a concurrent writer
+        sqlite3_busy_timeout(db, busyTimeoutMs);
+
+        Exec(db, "PRAGMA journal_mode=" + journalMode);
+        Exec(db, "PRAGMA synchronous=" + synchronous);
+        Exec(db, "PRAGMA mmap_size=" + std::to_string(mmapSize));
+        // Negative cache_size is in KiB rather than pages
+        Exec(db, "PRAGMA cache_size=-" + std::to_string(cacheSizeKiB));
+        Exec(db, std::string("PRAGMA temp_store=") + (tempStoreMemory ? "MEMORY" : "DEFAULT"));
+        Exec(db, std::string("PRAGMA foreign_keys=") + (foreignKeys ? "ON" : "OFF"));
+    }
+
+    ConnectionProfile ConnectionProfile::Load(const fs::path& settingsPath)
+    {
+        ConnectionProfile profile;
+
+        std::ifstream ifs(settingsPath);
+        if(!ifs.is_open())
+        {
+            GL_INFO(
+                "ConnectionProfile::Load - No settings found at \"{}\", writing defaults",
+                settingsPath.generic_string()
+            );
+            Save(profile, settingsPath);
+            return profile;
+        }
+
+        try
+        {
+            nlohmann::json settingsJson;
+            ifs >> settingsJson;
+            ifs.close();
+
+            if(!settingsJson.contains("storage") || !settingsJson["storage"].is_object())
+            {
+                Save(profile, settingsPath);
+                return profile;
+            }
+
+            const auto& storage = settingsJson["storage"];
+            profile.journalMode = Validated(
+                storage.value("journal_mode", profile.journalMode),
+                kJournalModes,
+                profile.journalMode
+            );
+            profile.synchronous = Validated(
+                storage.value("synchronous", profile.synchronous),
+                kSynchronousModes,
+                profile.synchronous
+            );
+            profile.mmapSize = std::max<int64_t>(0, storage.value("mmap_size", profile.mmapSize));
+            profile.cacheSizeKiB
+                = std::max<int64_t>(0, storage.value("cache_size_kib", profile.cacheSizeKiB));
+            profile.tempStoreMemory = storage.value("temp_store_memory", profile.tempStoreMemory);
+            profile.foreignKeys = storage.value("foreign_keys", profile.foreignKeys);
+            profile.busyTimeoutMs
+                = std::max(0, storage.value("busy_timeout_ms", profile.busyTimeoutMs));
+        }
+        catch(const nlohmann::json::exception& e)
+        {
+            GL_ERROR("ConnectionProfile::Load - Failed to parse settings: {}", e.what());
+            return ConnectionProfile{};
+        }
+
+        return profile;
+    }
+
+    void ConnectionProfile::Save(const ConnectionProfile& profile, const fs::path& settingsPath)
+    {
+        // Keep whatever other sections the settings file already has
+        nlohmann::json settingsJson = nlohmann::json::object();
+        {
+            std::ifstream ifs(settingsPath);
+            if(ifs.is_open())
+            {
+                settingsJson = nlohmann::json::parse(ifs, nullptr, false);
+                if(!settingsJson.is_object())
+                    settingsJson = nlohmann::json::object();
+            }
+        }
+
+        settingsJson["storage"] = {
+            { "journal_mode", profile.journalMode },
+            { "synchronous", profile.synchronous },
+            { "mmap_size", profile.mmapSize },
+            { "cache_size_kib", profile.cacheSizeKiB },
+            { "temp_store_memory", profile.tempStoreMemory },
+            { "foreign_keys", profile.foreignKeys },
+            { "busy_timeout_ms", profile.busyTimeoutMs },
+        };
+
+        std::ofstream file(settingsPath);
+        if(!file.is_open())
+        {
+            GL_ERROR(
+                "ConnectionProfile::Save - Failed to write settings to \"{}\"",
+                settingsPath.generic_string()
+            );
+            return;
+        }
+#ifdef GL_DEBUG
+        file << settingsJson.dump(4);
+#else
+        file << settingsJson;
+#endif
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+struct sqlite3;
+
+namespace Storage
+{
+    namespace fs = std::filesystem;
+
+    /**
+     * @brief SQLite connection settings applied every time the database is opened.
+     *
+     * The defaults trade a little durability for responsiveness: WAL journaling with
+     * synchronous=NORMAL only fsyncs at checkpoints, so commits no longer stall the UI thread.
+     * Foreign keys are enabled so the cascades declared in Storage.h take effect.
+     *
+     * The profile lives in the "storage" section of settings.json and is written back with
+     * defaults when missing, so it can be tuned without rebuilding.
+     */
+    struct ConnectionProfile
+    {
+        std::string journalMode = "WAL";    // DELETE, TRUNCATE, PERSIST, MEMORY, WAL, OFF
+        std::string synchronous = "NORMAL"; // OFF, NORMAL, FULL, EXTRA
+        int64_t mmapSize = 256ll * 1024 * 1024;
+        int64_t cacheSizeKiB = 64 * 1024;
+        bool tempStoreMemory = true;
+        bool foreignKeys = true;
+        int busyTimeoutMs = 5000;
+
+        // Runs the PRAGMAs on a freshly opened connection
+        void Apply(sqlite3* db) const;
+
+        static ConnectionProfile Load(const fs::path& settingsPath);
+        static void Save(const ConnectionProfile& profile, const fs::path& settingsPath);
+    };
+}
@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "PersistenceWorker.h"
+#include "storage/StorageManager.h"
+#include "Log.h"
+
+namespace
+{
+    PersistenceWorker::Completion Chain(
+        PersistenceWorker::Completion first,
+        PersistenceWorker::Completion second
+    )
+    {
+        if(!first)
+            return second;
+        if(!second)
+            return first;
+        return [first = std::move(first), second = std::move(second)](bool committed) {
+            first(committed);
+            second(committed);
+        };
+    }
+
+    void Complete(const PersistenceWorker::Completion& done, bool committed)
+    {
+        if(done)
+            done(committed);
+    }
+}
+
+PersistenceWorker::PersistenceWorker() : mThread([this] { ThreadMain(); }) {}
+
+size_t PersistenceWorker::PendingCount()
+{
+    PersistenceWorker& instance = Get();
+    std::lock_guard<std::mutex> lock(instance.mMutex);
+    return instance.mLiveCount;
+}
+
+PersistenceWorker::Group::Group()
+{
+    PersistenceWorker& instance = Get();
+    std::lock_guard<std::mutex> lock(instance.mMutex);
+    ++instance.mOpenGroups;
+}
+
+PersistenceWorker::Group::~Group()
+{
+    PersistenceWorker& instance = Get();
+    {
+        std::lock_guard<std::mutex> lock(instance.mMutex);
+        --instance.mOpenGroups;
+    }
+    instance.mCondition.notify_one();
+}
+
+void PersistenceWorker::SubmitInternal(
+    const std::string& key,
+    std::function<void()> command,
+    Completion done
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mStop)
+        {
+            if(mLiveCount == 0)
+                mFirstPendingAt = std::chrono::steady_clock::now();
+
+            // Supersede the earlier command in its slot: a key keeps its first submission order,
+            // so a list renamed after a card was queued into it is still written before the card
+            auto it = mPendingByKey.find(key);
+            if(it != mPendingByKey.end())
+            {
+                Command& pending = mPending[it->second];
+                pending.write = std::move(command);
+                pending.done = Chain(std::move(pending.done), std::move(done));
+            }
+            else
+            {
+                mPendingByKey[key] = mPending.size();
+                mPending.push_back({ key, std::move(command), std::move(done) });
+                ++mLiveCount;
+            }
+            command = nullptr;
+        }
+    }
+
+    if(!command)
+    {
+        mCondition.notify_one();
+        return;
+    }
+
+    // Thread already gone (late shutdown path): write inline rather than drop the change
+    try
+    {
+        command();
+        Complete(done, true);
+    }
+    catch(const std::exception& e)
+    {
+        GL_ERROR("Dropping write for '{}': {}", key, e.what());
+        Complete(done, false);
+    }
+}
+
+void PersistenceWorker::EnqueueJob(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mStop)
+        {
+            mJobs.push_back(std::move(job));
+            job = nullptr;
+        }
+    }
+
+    if(job)
+        job();
+    else
+        mCondition.notify_one();
+}
+
+void PersistenceWorker::ShutdownInternal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(mStop)
+            return;
+        mStop = true;
+    }
+    mCondition.notify_one();
+
+    // ThreadMain drains pending writes and jobs before returning
+    if(mThread.joinable())
+        mThread.join();
+}
+
+void PersistenceWorker::ThreadMain()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for(;;)
+    {
+        // An open Group holds everything back, so its commands are never split across batches
+        mCondition.wait(lock, [this] {
+            return mStop || (mOpenGroups == 0 && (!mJobs.empty() || mLiveCount > 0));
+        });
+
+        // Jobs and shutdown skip the coalescing window; plain writes wait it out
+        if(!mStop && mJobs.empty())
+        {
+            const auto deadline = mFirstPendingAt + kCoalesceWindow;
+            if(mCondition.wait_until(lock, deadline, [this] {
+                   return mStop || !mJobs.empty() || mOpenGroups > 0;
+               }))
+                continue;
+        }
+
+        std::vector<Command> commands;
+        commands.swap(mPending);
+        mPendingByKey.clear();
+        mLiveCount = 0;
+
+        std::vector<std::function<void()>> jobs;
+        jobs.swap(mJobs);
+
+        const bool stopping = mStop;
+        lock.unlock();
+
+        WriteBatch(std::move(commands));
+        for(auto& job : jobs)
+        {
+            job(); // packaged_task stores any exception in the caller's future
+        }
+
+        lock.lock();
+        if(stopping && mJobs.empty() && mLiveCount == 0)
+            return;
+    }
+}
+
+void PersistenceWorker::WriteBatch(std::vector<Command> commands)
+{
+    if(commands.empty())
+        return;
+
+    bool committed = false;
+    try
+    {
+        StorageManager::Batch batch;
+        for(const auto& command : commands)
+        {
+            command.write();
+        }
+        batch.Commit();
+        committed = true;
+    }
+    catch(const std::exception& e)
+    {
+        GL_ERROR("Persistence batch of {} writes failed: {}", commands.size(), e.what());
+    }
+
+    if(committed)
+    {
+        for(const auto& command : commands)
+        {
+            Complete(command.done, true);
+        }
+        return;
+    }
+
+    // Retry one by one so a single bad command cannot sink the rest of the batch
+    size_t failed = 0;
+    for(const auto& command : commands)
+    {
+        try
+        {
+            StorageManager::Batch batch;
+            command.write();
+            batch.Commit();
+        }
+        catch(const std::exception& e)
+        {
+            ++failed;
+            GL_ERROR("Dropping write for '{}': {}", command.key, e.what());
+            Complete(command.done, false);
+            continue;
+        }
+        Complete(command.done, true);
+    }
+    GL_WARN("Recovered {} of {} writes", commands.size() - failed, commands.size());
+}
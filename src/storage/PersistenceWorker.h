@@ -0,0 +1,139 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Dedicated thread that owns the SQLite connection and performs all persistence.
+ *
+ * The UI thread never touches the database directly. Writes are submitted as commands keyed by
+ * the entity they affect ("card:42"); submitting a key that is still pending replaces the
+ * earlier command, so a burst of edits to one card becomes a single row write. Pending commands
+ * are collected for a short coalescing window and then written in one StorageManager::Batch.
+ *
+ * Reads go through Run(), which first flushes every pending write so the caller sees its own
+ * changes, then executes on the worker and blocks for the result.
+ *
+ * A write can carry a completion callback, told whether it committed or was dropped after
+ * failing on its own. A superseded command's callback gets the outcome of the one that
+ * replaced it. Callbacks run on the worker thread, so they only hand the outcome over.
+ *
+ * Usage:
+ * @code
+ * PersistenceWorker::Submit("card:42", [row] { StorageManager::UpsertCard(row); });
+ * auto boards = PersistenceWorker::Run([] { return StorageManager::GetAllBoards(); });
+ * PersistenceWorker::Shutdown(); // On exit: writes everything still pending
+ * @endcode
+ *
+ * @note Commands must capture their data by value; they run after the caller has moved on.
+ * @see StorageManager, BoardStorageAdapter
+ */
+class PersistenceWorker
+{
+  public:
+    static PersistenceWorker& Get()
+    {
+        static PersistenceWorker instance;
+        return instance;
+    }
+
+    // Worker thread: true once the write committed, false if it was dropped
+    using Completion = std::function<void(bool committed)>;
+
+    // Queue a write, superseding any pending command with the same key
+    static void
+    Submit(const std::string& key, std::function<void()> command, Completion done = nullptr)
+    {
+        Get().SubmitInternal(key, std::move(command), std::move(done));
+    }
+
+    // Run fn on the worker after all pending writes and wait for its result
+    template<typename Fn>
+    static auto Run(Fn&& fn) -> std::invoke_result_t<Fn&>
+    {
+        using Result = std::invoke_result_t<Fn&>;
+
+        // Nested calls from a command would otherwise wait on themselves
+        if(Get().IsWorkerThread())
+            return fn();
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        std::future<Result> result = task->get_future();
+        Get().EnqueueJob([task]() { (*task)(); });
+        return result.get();
+    }
+
+    // Block until every write submitted so far has been committed
+    static void Flush()
+    {
+        Run([] {});
+    }
+
+    /**
+     * @brief Keeps the worker from taking pending writes while alive, so every command
+     * submitted meanwhile lands in the same batch (one transaction).
+     */
+    class Group
+    {
+      public:
+        Group();
+        ~Group();
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+    };
+
+    // Flush and stop the thread; safe to call more than once
+    static void Shutdown() { Get().ShutdownInternal(); }
+
+    static size_t PendingCount();
+
+    ~PersistenceWorker() { ShutdownInternal(); }
+
+  private:
+    PersistenceWorker();
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    struct Command
+    {
+        std::string key;
+        std::function<void()> write; // Replaced in place by a later command of the same key
+        Completion done;             // Of every command this one replaced, too
+    };
+
+    // Edits closer together than this are merged into one write
+    static constexpr std::chrono::milliseconds kCoalesceWindow{ 250 };
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStop = false;
+
+    // Pending writes in submission order; mPendingByKey indexes the live entry of each key
+    std::vector<Command> mPending;
+    std::unordered_map<std::string, size_t> mPendingByKey;
+    size_t mLiveCount = 0;
+    int mOpenGroups = 0;
+    std::chrono::steady_clock::time_point mFirstPendingAt;
+
+    std::vector<std::function<void()>> mJobs;
+
+    // Declared last so every member above is constructed before the thread starts
+    std::thread mThread;
+
+    void SubmitInternal(const std::string& key, std::function<void()> command, Completion done);
+    void EnqueueJob(std::function<void()> job);
+    void ShutdownInternal();
+    bool IsWorkerThread() const { return std::this_thread::get_id() == mThread.get_id(); }
+
+    void ThreadMain();
+    void WriteBatch(std::vector<Command> commands);
+};
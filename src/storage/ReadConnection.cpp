@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "ReadConnection.h"
+#include "storage/BoardQueries.h"
+#include "Log.h"
+#include <sqlite3.h>
+#include <mutex>
+#include <stdexcept>
+
+namespace Storage
+{
+    namespace
+    {
+        struct Configuration
+        {
+            std::mutex mutex;
+            std::string path;
+            ConnectionProfile profile;
+        };
+
+        Configuration& GetConfiguration()
+        {
+            static Configuration configuration;
+            return configuration;
+        }
+    }
+
+    ReadConnection::ReadConnection(const std::string& path, const ConnectionProfile& profile)
+        : mStorage(SetupStorageDatabaseModels(path))
+    {
+        mStorage.on_open = [profile](sqlite3* db) {
+            profile.Apply(db);
+            // Refuses writes on this connection, so a stray one fails instead of racing the worker
+            sqlite3_exec(db, "PRAGMA query_only=ON", nullptr, nullptr, nullptr);
+        };
+        mStorage.open_forever();
+    }
+
+    void ReadConnection::Configure(const std::string& path, const ConnectionProfile& profile)
+    {
+        Configuration& configuration = GetConfiguration();
+        std::lock_guard<std::mutex> lock(configuration.mutex);
+        configuration.path = path;
+        configuration.profile = profile;
+    }
+
+    ReadConnection& ReadConnection::ForThisThread()
+    {
+        thread_local ReadConnection connection = [] {
+            Configuration& configuration = GetConfiguration();
+            std::lock_guard<std::mutex> lock(configuration.mutex);
+            if(configuration.path.empty())
+                throw std::runtime_error("ReadConnection used before the database was opened");
+            return ReadConnection(configuration.path, configuration.profile);
+        }();
+        return connection;
+    }
+
+    std::vector<JournalEntryData> ReadConnection::LoadJournalEntries(int boardId)
+    {
+        return JournalEntriesOfBoard(mStorage, boardId);
+    }
+
+    BoardBundle ReadConnection::LoadBoardBundle(int boardId)
+    {
+        mStorage.begin_transaction();
+        try
+        {
+            BoardBundle bundle = Storage::LoadBoardBundle(mStorage, boardId);
+            mStorage.commit();
+            return bundle;
+        }
+        catch(...)
+        {
+            try
+            {
+                mStorage.rollback();
+            }
+            catch(const std::exception& e)
+            {
+                GL_ERROR("Failed to end read transaction: {}", e.what());
+            }
+            throw;
+        }
+    }
+}
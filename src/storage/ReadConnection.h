@@ -0,0 +1,51 @@
+#pragma once
+#include "storage/ConnectionProfile.h"
+#include "storage/Storage.h"
+#include <string>
+#include <vector>
+
+namespace Storage
+{
+    /**
+     * @brief Read-only SQLite connection for loading boards off the persistence worker.
+     *
+     * The PersistenceWorker's connection serializes every query, so hydrating many boards
+     * through it uses one core. In WAL mode any number of readers can run next to the writer,
+     * each on a consistent snapshot, so board loads open a connection per thread instead and
+     * run side by side on the WorkerThread pool.
+     *
+     * The connection gets the same ConnectionProfile PRAGMAs as the writer, followed by
+     * query_only, and never syncs the schema: the StorageManager must have opened (and migrated)
+     * the database first. It hands its path and profile over through Configure(), so readers
+     * never touch settings.json themselves.
+     *
+     * Usage:
+     * @code
+     * PersistenceWorker::Flush(); // Readers only see committed writes
+     * auto bundle = ReadConnection::ForThisThread().LoadBoardBundle(boardId);
+     * @endcode
+     *
+     * @note Not thread-safe: use one instance per thread, as ForThisThread() does.
+     * @see BoardStorageAdapter::LoadAllBoards
+     */
+    class ReadConnection
+    {
+      public:
+        explicit ReadConnection(const std::string& path, const ConnectionProfile& profile = {});
+
+        // Database and profile for ForThisThread(), set by the StorageManager once it is open
+        static void Configure(const std::string& path, const ConnectionProfile& profile);
+
+        // Connection of the calling thread to the configured database, opened on first use
+        static ReadConnection& ForThisThread();
+
+        // Every row of one board, read inside a single transaction so it is one snapshot
+        BoardBundle LoadBoardBundle(int boardId);
+
+        // The board's undo steps, oldest first
+        std::vector<JournalEntryData> LoadJournalEntries(int boardId);
+
+      private:
+        decltype(SetupStorageDatabaseModels("")) mStorage;
+    };
+}
@@ -0,0 +1,124 @@
+#include "pch.h"
+#include "SchemaMigrations.h"
+#include "Log.h"
+#include <sqlite3.h>
+#include <filesystem>
+
+namespace Storage
+{
+    namespace
+    {
+        bool Exec(sqlite3* db, const std::string& sql)
+        {
+            char* error = nullptr;
+            if(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+            {
+                GL_ERROR("MigrateDatabase - \"{}\" failed: {}", sql, error ? error : "unknown");
+                sqlite3_free(error);
+                return false;
+            }
+            return true;
+        }
+
+        // First column of the first row, or empty if the query returned nothing
+        std::string QueryText(sqlite3* db, const std::string& sql, const std::string& param)
+        {
+            std::string result;
+            sqlite3_stmt* stmt = nullptr;
+            if(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+                return result;
+
+            sqlite3_bind_text(stmt, 1, param.c_str(), -1, SQLITE_TRANSIENT);
+            if(sqlite3_step(stmt) == SQLITE_ROW)
+            {
+                if(auto* text = sqlite3_column_text(stmt, 0))
+                    result = reinterpret_cast<const char*>(text);
+            }
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        bool ReplaceOnce(std::string& text, const std::string& from, const std::string& to)
+        {
+            size_t at = text.find(from);
+            if(at == std::string::npos)
+                return false;
+            text.replace(at, from.size(), to);
+            return true;
+        }
+
+        // Rebuild a table with one column re-declared, following SQLite's documented
+        // procedure for schema changes ALTER TABLE cannot express
+        void RetypeColumn(
+            sqlite3* db,
+            const std::string& table,
+            const std::string& column,
+            const std::string& newType
+        )
+        {
+            std::string currentType = QueryText(
+                db,
+                "SELECT type FROM pragma_table_info(?1) WHERE name = '" + column + "'",
+                table
+            );
+            if(currentType.empty() || currentType == newType)
+                return;
+
+            std::string ddl = QueryText(
+                db,
+                "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = ?1",
+                table
+            );
+
+            const std::string tempTable = table + "_migrating";
+            const std::string quoted = "\"" + column + "\" ";
+            if(!ReplaceOnce(ddl, "\"" + table + "\"", "\"" + tempTable + "\"")
+               || !ReplaceOnce(ddl, quoted + currentType, quoted + newType))
+            {
+                GL_ERROR("MigrateDatabase - Unrecognised definition of table '{}'", table);
+                return;
+            }
+
+            // Keep child foreign keys pointing at the table name rather than the renamed copy
+            Exec(db, "PRAGMA foreign_keys=OFF");
+            Exec(db, "PRAGMA legacy_alter_table=ON");
+
+            bool ok = Exec(db, "BEGIN") && Exec(db, ddl)
+                   && Exec(db, "INSERT INTO \"" + tempTable + "\" SELECT * FROM \"" + table + "\"")
+                   && Exec(db, "DROP TABLE \"" + table + "\"")
+                   && Exec(db, "ALTER TABLE \"" + tempTable + "\" RENAME TO \"" + table + "\"")
+                   && Exec(db, "COMMIT");
+            if(!ok)
+                Exec(db, "ROLLBACK");
+
+            Exec(db, "PRAGMA legacy_alter_table=OFF");
+            Exec(db, "PRAGMA foreign_keys=ON");
+
+            if(ok)
+            {
+                GL_INFO("MigrateDatabase - {}.{} is now {}", table, column, newType);
+            }
+        }
+    }
+
+    void MigrateDatabase(const std::string& path)
+    {
+        std::error_code ec;
+        if(!std::filesystem::exists(std::filesystem::u8path(path), ec))
+            return;
+
+        sqlite3* db = nullptr;
+        if(sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK)
+        {
+            GL_ERROR("MigrateDatabase - Cannot open \"{}\": {}", path, sqlite3_errmsg(db));
+            sqlite3_close(db);
+            return;
+        }
+
+        // Positions became fractional ranks (midpoint insertion needs REAL, not INTEGER)
+        RetypeColumn(db, "lists", "position", "REAL");
+        RetypeColumn(db, "cards", "position", "REAL");
+
+        sqlite3_close(db);
+    }
+}
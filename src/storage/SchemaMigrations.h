@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+
+namespace Storage
+{
+    /**
+     * @brief Bring an existing database file up to the schema declared in Storage.h.
+     *
+     * sync_schema() drops and recreates any table whose column types changed, losing its rows.
+     * Such changes are migrated here first, by rebuilding the table under the new definition
+     * and copying the rows across, so sync_schema() then finds nothing to recreate.
+     *
+     * Must run before the storage connection is opened. Missing files are left alone.
+     */
+    void MigrateDatabase(const std::string& path);
+}
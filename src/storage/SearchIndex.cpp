@@ -0,0 +1,394 @@
+#include "pch.h"
+#include "SearchIndex.h"
+#include "Log.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+namespace Storage
+{
+    namespace
+    {
+        constexpr char kHighlightOpen = '\x01';
+        constexpr char kHighlightClose = '\x02';
+        constexpr int kTriggerCount = 10;
+
+        // Tables indexed under their parent card; a null column leaves that field empty
+        struct ChildTable
+        {
+            const char* table;
+            SearchHitKind kind;
+            const char* titleColumn;
+            const char* bodyColumn;
+
+            std::string Fields(const std::string& row) const
+            {
+                return Field(row, titleColumn) + ", " + Field(row, bodyColumn);
+            }
+
+            static std::string Field(const std::string& row, const char* column)
+            {
+                return column ? row + column : "''";
+            }
+        };
+
+        const ChildTable kChildTables[] = {
+            { "checklist_items", SearchHitKind::ChecklistItem, "content", nullptr },
+            { "comments", SearchHitKind::Comment, nullptr, "content" },
+        };
+
+        std::string KindValue(SearchHitKind kind)
+        {
+            return std::to_string(static_cast<int>(kind));
+        }
+
+        // SQL expression for the rowid of an entry, see the layout in SearchIndex.h
+        std::string
+        RowKey(const std::string& boardId, const std::string& entityId, SearchHitKind kind)
+        {
+            return "((" + boardId + " << 33) | (" + entityId + " << 2) | " + KindValue(kind) + ")";
+        }
+
+        int64_t BoardFirstRowid(int boardId) { return static_cast<int64_t>(boardId) << 33; }
+
+        bool Exec(sqlite3* db, const std::string& sql)
+        {
+            char* error = nullptr;
+            if(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+            {
+                GL_ERROR("SearchIndex - \"{}\" failed: {}", sql, error ? error : "unknown");
+                sqlite3_free(error);
+                return false;
+            }
+            return true;
+        }
+
+        int QueryInt(sqlite3* db, const std::string& sql)
+        {
+            int result = 0;
+            sqlite3_stmt* stmt = nullptr;
+            if(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+                return result;
+            if(sqlite3_step(stmt) == SQLITE_ROW)
+                result = sqlite3_column_int(stmt, 0);
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        std::string InsertEntry(const std::string& key, SearchHitKind kind)
+        {
+            return "INSERT OR REPLACE INTO search_index(rowid, kind, card_id, title, body) SELECT "
+                 + key + ", " + KindValue(kind) + ", ";
+        }
+
+        // Entries of a card's checklist items and comments filed under the given board
+        std::string ChildKeysOfCard(const std::string& boardId, const std::string& cardId)
+        {
+            std::string sql;
+            for(const auto& child : kChildTables)
+            {
+                sql += " UNION ALL SELECT " + RowKey(boardId, "id", child.kind) + " FROM "
+                     + child.table + " WHERE card_id = " + cardId;
+            }
+            return sql;
+        }
+
+        std::vector<std::string> TriggerStatements()
+        {
+            const std::string cardKey = RowKey("NEW.board_id", "NEW.id", SearchHitKind::Card);
+            const std::string insertCard = InsertEntry(cardKey, SearchHitKind::Card)
+                                         + "NEW.id, NEW.title, NEW.description;";
+
+            std::vector<std::string> statements = {
+                "CREATE TRIGGER IF NOT EXISTS search_cards_insert AFTER INSERT ON cards BEGIN "
+                    + insertCard + " END",
+
+                "CREATE TRIGGER IF NOT EXISTS search_cards_update "
+                "AFTER UPDATE OF board_id, title, description ON cards BEGIN "
+                "DELETE FROM search_index WHERE rowid = "
+                    + RowKey("OLD.board_id", "OLD.id", SearchHitKind::Card) + "; " + insertCard
+                    + " END",
+
+                // BEFORE, so the cascade has not removed the checklist items and comments yet
+                "CREATE TRIGGER IF NOT EXISTS search_cards_delete BEFORE DELETE ON cards BEGIN "
+                "DELETE FROM search_index WHERE rowid IN (SELECT "
+                    + RowKey("OLD.board_id", "OLD.id", SearchHitKind::Card)
+                    + ChildKeysOfCard("OLD.board_id", "OLD.id") + "); END",
+            };
+
+            std::string moveChildren
+                = "CREATE TRIGGER IF NOT EXISTS search_cards_move "
+                  "AFTER UPDATE OF board_id ON cards WHEN OLD.board_id <> NEW.board_id BEGIN "
+                  "DELETE FROM search_index WHERE rowid IN (SELECT NULL"
+                + ChildKeysOfCard("OLD.board_id", "OLD.id") + "); ";
+
+            for(const auto& child : kChildTables)
+            {
+                const std::string table = child.table;
+                const std::string oldKey = "(SELECT " + RowKey("board_id", "OLD.id", child.kind)
+                                         + " FROM cards WHERE id = OLD.card_id)";
+                const std::string insertChild
+                    = InsertEntry(RowKey("c.board_id", "NEW.id", child.kind), child.kind)
+                    + "NEW.card_id, " + child.Fields("NEW.")
+                    + " FROM cards c WHERE c.id = NEW.card_id;";
+
+                moveChildren += InsertEntry(RowKey("NEW.board_id", "id", child.kind), child.kind)
+                              + "card_id, " + child.Fields("") + " FROM " + table
+                              + " WHERE card_id = NEW.id; ";
+
+                statements.push_back(
+                    "CREATE TRIGGER IF NOT EXISTS search_" + table + "_insert AFTER INSERT ON "
+                    + table + " BEGIN " + insertChild + " END"
+                );
+                statements.push_back(
+                    "CREATE TRIGGER IF NOT EXISTS search_" + table + "_update AFTER UPDATE OF "
+                    "card_id, content ON " + table
+                    + " BEGIN DELETE FROM search_index WHERE rowid = " + oldKey + "; "
+                    + insertChild + " END"
+                );
+                // A no-op when the parent card is already gone: its own trigger cleaned up
+                statements.push_back(
+                    "CREATE TRIGGER IF NOT EXISTS search_" + table + "_delete AFTER DELETE ON "
+                    + table + " BEGIN DELETE FROM search_index WHERE rowid = " + oldKey + "; END"
+                );
+            }
+
+            statements.push_back(moveChildren + "END");
+            return statements;
+        }
+
+        void BindMatch(sqlite3_stmt* stmt, const std::string& match, int64_t first, int64_t last)
+        {
+            sqlite3_bind_text(stmt, 1, match.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int64(stmt, 2, first);
+            sqlite3_bind_int64(stmt, 3, last);
+        }
+
+        // Matches in the rowid range, counting no further than cap; -1 on error
+        int CountMatches(
+            sqlite3* db,
+            const std::string& match,
+            int64_t first,
+            int64_t last,
+            int cap
+        )
+        {
+            sqlite3_stmt* stmt = nullptr;
+            if(sqlite3_prepare_v2(
+                   db,
+                   "SELECT COUNT(*) FROM (SELECT 1 FROM search_index WHERE search_index MATCH ?1 "
+                   "AND rowid BETWEEN ?2 AND ?3 LIMIT ?4)",
+                   -1,
+                   &stmt,
+                   nullptr
+               )
+               != SQLITE_OK)
+            {
+                GL_ERROR("SearchBoard - {}", sqlite3_errmsg(db));
+                return -1;
+            }
+            BindMatch(stmt, match, first, last);
+            sqlite3_bind_int(stmt, 4, cap);
+
+            int matches = -1;
+            if(sqlite3_step(stmt) == SQLITE_ROW)
+                matches = sqlite3_column_int(stmt, 0);
+            sqlite3_finalize(stmt);
+            return matches;
+        }
+
+        // Each whitespace-separated term as an FTS5 string, so input is never parsed as syntax
+        std::vector<std::string> QuoteTerms(const std::string& text)
+        {
+            std::vector<std::string> terms;
+            size_t i = 0;
+            while(i < text.size())
+            {
+                if(std::isspace(static_cast<unsigned char>(text[i])))
+                {
+                    ++i;
+                    continue;
+                }
+
+                std::string term = "\"";
+                for(; i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])); ++i)
+                {
+                    // Quotes are the only special character inside an FTS5 string
+                    if(text[i] == '"')
+                        term += '"';
+                    term += text[i];
+                }
+                terms.push_back(term + '"');
+            }
+            return terms;
+        }
+
+        // Text with the highlight markers removed and their positions recorded
+        SearchField ParseHighlighted(const unsigned char* marked)
+        {
+            SearchField field;
+            if(!marked)
+                return field;
+
+            const char* text = reinterpret_cast<const char*>(marked);
+            field.text.reserve(std::strlen(text));
+            int begin = 0;
+            for(const char* c = text; *c; ++c)
+            {
+                if(*c == kHighlightOpen)
+                    begin = static_cast<int>(field.text.size());
+                else if(*c == kHighlightClose)
+                    field.highlights.push_back({ begin, static_cast<int>(field.text.size()) });
+                else
+                    field.text.push_back(*c);
+            }
+            return field;
+        }
+    }
+
+    void EnsureSearchIndex(sqlite3* db)
+    {
+        const bool tableExists = QueryInt(
+            db,
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'search_index'"
+        );
+        // sync_schema() drops a table's triggers when it recreates the table
+        const int triggers = QueryInt(
+            db,
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name LIKE 'search\\_%' "
+            "ESCAPE '\\'"
+        );
+        if(tableExists && triggers == kTriggerCount)
+            return;
+
+        bool ok = Exec(db, "SAVEPOINT search_index");
+        if(ok && !tableExists)
+        {
+            ok = Exec(
+                     db,
+                     "CREATE VIRTUAL TABLE search_index USING fts5("
+                     "kind UNINDEXED, card_id UNINDEXED, title, body, "
+                     "tokenize = 'unicode61 remove_diacritics 2', prefix = '2 3 4')"
+                 )
+              && Exec(
+                     db,
+                     "INSERT INTO search_index(search_index, rank) "
+                     "VALUES('rank', 'bm25(0.0, 0.0, 10.0, 1.0)')"
+                 );
+        }
+        for(const auto& statement : TriggerStatements())
+        {
+            ok = ok && Exec(db, statement);
+        }
+
+        if(!ok)
+        {
+            Exec(db, "ROLLBACK TO search_index");
+            Exec(db, "RELEASE search_index");
+            return;
+        }
+        Exec(db, "RELEASE search_index");
+
+        RebuildSearchIndex(db);
+    }
+
+    void RebuildSearchIndex(sqlite3* db)
+    {
+        const std::string cardKey = RowKey("board_id", "id", SearchHitKind::Card);
+        std::string sql = "SAVEPOINT search_rebuild; DELETE FROM search_index; "
+                        + InsertEntry(cardKey, SearchHitKind::Card)
+                        + "id, title, description FROM cards; ";
+        for(const auto& child : kChildTables)
+        {
+            sql += InsertEntry(RowKey("c.board_id", "x.id", child.kind), child.kind)
+                 + "x.card_id, " + child.Fields("x.") + " FROM " + child.table
+                 + " x JOIN cards c ON c.id = x.card_id; ";
+        }
+        sql += "INSERT INTO search_index(search_index) VALUES('optimize'); "
+               "RELEASE search_rebuild;";
+
+        if(!Exec(db, sql))
+        {
+            Exec(db, "ROLLBACK TO search_rebuild");
+            Exec(db, "RELEASE search_rebuild");
+            return;
+        }
+        GL_INFO(
+            "SearchIndex - Indexed {} entries",
+            QueryInt(db, "SELECT COUNT(*) FROM search_index")
+        );
+    }
+
+    std::vector<SearchHit>
+    SearchBoard(sqlite3* db, int boardId, const std::string& text, int limit)
+    {
+        std::vector<SearchHit> hits;
+        std::vector<std::string> terms = QuoteTerms(text);
+        if(terms.empty() || limit <= 0)
+            return hits;
+
+        const int64_t first = BoardFirstRowid(boardId);
+        const int64_t last = BoardFirstRowid(boardId + 1) - 1;
+        std::string match = terms[0];
+        for(size_t i = 1; i < terms.size(); ++i)
+        {
+            match += ' ' + terms[i];
+        }
+
+        // A prefix longer than the indexed ones merges the doclists of every word it expands to,
+        // on all boards. When the exact words are already a broad query, searching for them
+        // alone is both much cheaper and hardly different
+        int matches = CountMatches(db, match, first, last, kMaxRankedMatches);
+        if(matches < kMaxRankedMatches && !std::isspace(static_cast<unsigned char>(text.back())))
+        {
+            terms.back() += '*';
+            match += '*';
+            matches = CountMatches(db, match, first, last, kMaxRankedMatches);
+        }
+        if(matches <= 0)
+            return hits;
+
+        // bm25 weighs each term by the number of entries containing it, which FTS5 finds by
+        // reading the term's whole doclist across all boards, however few rows match here
+        bool ranked = matches < kMaxRankedMatches;
+        for(size_t i = 0; ranked && i < terms.size(); ++i)
+        {
+            const int entries = CountMatches(db, terms[i], 0, INT64_MAX, kMaxRankedTermEntries);
+            ranked = entries >= 0 && entries < kMaxRankedTermEntries;
+        }
+
+        const std::string sql
+            = std::string("SELECT s.kind, s.card_id, s.rowid, ") + (ranked ? "s.rank" : "0.0")
+            + ", highlight(search_index, 2, char(1), char(2)), "
+              "highlight(search_index, 3, char(1), char(2)) "
+              "FROM search_index s JOIN cards c ON c.id = s.card_id "
+              "WHERE search_index MATCH ?1 AND s.rowid BETWEEN ?2 AND ?3 AND c.archived = 0 "
+              "ORDER BY "
+            + (ranked ? "s.rank" : "s.rowid DESC") + " LIMIT ?4";
+
+        sqlite3_stmt* stmt = nullptr;
+        if(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            GL_ERROR("SearchBoard - {}", sqlite3_errmsg(db));
+            return hits;
+        }
+        BindMatch(stmt, match, first, last);
+        sqlite3_bind_int(stmt, 4, limit);
+
+        hits.reserve(static_cast<size_t>(std::min(limit, matches)));
+        while(sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            SearchHit& hit = hits.emplace_back();
+            hit.kind = static_cast<SearchHitKind>(sqlite3_column_int(stmt, 0));
+            hit.card_id = sqlite3_column_int(stmt, 1);
+            hit.entity_id = static_cast<int>((sqlite3_column_int64(stmt, 2) >> 2) & 0x7FFFFFFF);
+            hit.score = sqlite3_column_double(stmt, 3);
+            hit.title = ParseHighlighted(sqlite3_column_text(stmt, 4));
+            hit.body = ParseHighlighted(sqlite3_column_text(stmt, 5));
+        }
+        sqlite3_finalize(stmt);
+        return hits;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace Storage
+{
+    enum class SearchHitKind : int
+    {
+        Card = 1,
+        ChecklistItem = 2,
+        Comment = 3
+    };
+
+    // Byte range [begin, end) of a matched term inside SearchField::text (UTF-8)
+    struct SearchHighlight
+    {
+        int begin = 0;
+        int end = 0;
+    };
+
+    struct SearchField
+    {
+        std::string text;
+        std::vector<SearchHighlight> highlights;
+    };
+
+    struct SearchHit
+    {
+        SearchHitKind kind = SearchHitKind::Card;
+        int card_id = 0;    // Card owning the match (the card itself for Card hits)
+        int entity_id = 0;  // Row ID of the matched card, checklist item or comment
+        double score = 0.0; // bm25 rank, lower is better; 0 when ordered by recency
+        SearchField title;  // Card title or checklist item content
+        SearchField body;   // Card description or comment content
+    };
+
+    /**
+     * @brief Full-text index over card titles, descriptions, checklist items and comments.
+     *
+     * The index is an FTS5 table kept in sync by triggers on cards, checklist_items and
+     * comments, so every write path (including cascading deletes) updates it in the same
+     * transaction. Rowids carry the board in their high bits,
+     * (board_id << 33) | (entity_id << 2) | kind, which lets a query seek straight to one board
+     * instead of filtering matches from every board.
+     *
+     * Hits are ranked with bm25 (titles weigh 10x bodies) when the query is selective: fewer
+     * than kMaxRankedMatches matches on the board, and no term in kMaxRankedTermEntries entries
+     * or more. bm25's cost grows with those counts, so broader queries return the newest
+     * matches instead, which keeps every query within a few milliseconds at 100k cards.
+     *
+     * All functions must run on the connection's thread (the PersistenceWorker).
+     */
+    constexpr int kMaxRankedMatches = 1000;
+    constexpr int kMaxRankedTermEntries = 2000;
+
+    // Create the table and triggers if missing; repopulate when the index may have drifted
+    void EnsureSearchIndex(sqlite3* db);
+
+    // Drop every entry and re-index all cards, checklist items and comments
+    void RebuildSearchIndex(sqlite3* db);
+
+    /**
+     * @brief Search one board for cards whose text matches every term of the query.
+     * @param text Free text typed by the user; unless it ends in a space, the last term also
+     *             matches as a prefix
+     * @param limit Maximum number of hits
+     * @return Hits on non-archived cards, best first, with highlight ranges
+     */
+    std::vector<SearchHit>
+    SearchBoard(sqlite3* db, int boardId, const std::string& text, int limit = 50);
+}
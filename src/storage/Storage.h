@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <sqlite_orm.h>
 
 namespace Storage
@@ -20,7 +21,7 @@ namespace Storage
         int id;
         int board_id;
         std::string name;
-        int position;
+        double position; // Fractional rank, see FractionalRank.h
         int64_t created_at;
         int64_t updated_at;
     };
@@ -32,7 +33,7 @@ namespace Storage
         int board_id;
         std::string title;
         std::string description;
-        int position;
+        double position; // Fractional rank, see FractionalRank.h
         int64_t created_at;
         int64_t updated_at;
         int64_t due_date;
@@ -74,6 +75,63 @@ namespace Storage
         int64_t created_at;
     };
 
+    // UNDO HISTORY
+    // One undo step of a board; the payload is the step's command, encoded by UndoJournal.
+    // Rows are ordered by id; undone steps are the board's redo stack.
+    struct JournalEntryData
+    {
+        int id;
+        int board_id;
+        int kind;
+        bool undone;
+        std::vector<char> payload;
+        int64_t created_at;
+    };
+
+    // CHANGE LOG
+    // Append-only record of every row written, filled by triggers (see ChangeLog.h) in the same
+    // transaction as the write. seq only grows, so "everything after N" is a range scan.
+    struct ChangeData
+    {
+        int64_t seq;
+        int entity;   // ChangeEntity
+        int entity_id;
+        int board_id; // Owning board, 0 when it could not be resolved
+        int op;       // ChangeOp
+        int fields;   // ChangeField bits an update touched; kAllFields after compaction
+        int64_t created_at;
+    };
+
+    // One compaction of the change log, see CompactChangeLog()
+    struct ChangeCheckpointData
+    {
+        int id;
+        int64_t seq;          // Changes up to here were folded to the latest per entity
+        int64_t rescan_below; // Deletes before this seq were purged: older cursors must rescan
+        int64_t created_at;
+    };
+
+    // BULK LOAD RESULT
+    // Every row belonging to one board, fetched with a fixed number of set-based queries.
+    struct BoardBundle
+    {
+        BoardData board;
+        std::vector<ListData> lists;
+        std::vector<CardData> cards;
+        std::vector<ChecklistItemData> checklist;
+        std::vector<BadgeData> badges;
+        std::vector<CardBadgeData> cardBadges;
+    };
+
+    // STARTUP RESULT
+    // Board row plus the counts the home view shows, without reading any list or card rows.
+    struct BoardSummary
+    {
+        BoardData board;
+        int list_count = 0;
+        int card_count = 0; // Non-archived cards
+    };
+
 
     // STORAGE FACTORY
     inline auto SetupStorageDatabaseModels(const std::string& path)
@@ -177,8 +235,77 @@ namespace Storage
                 make_column("created_at", &CommentData::created_at),
 
                 foreign_key(&CommentData::card_id).references(&CardData::id).on_delete.cascade()
+            ),
+
+            // UNDO JOURNAL
+            make_table(
+                "undo_journal",
+                make_column("id", &JournalEntryData::id, primary_key().autoincrement()),
+                make_column("board_id", &JournalEntryData::board_id),
+                make_column("kind", &JournalEntryData::kind),
+                make_column("undone", &JournalEntryData::undone),
+                make_column("payload", &JournalEntryData::payload),
+                make_column("created_at", &JournalEntryData::created_at),
+
+                foreign_key(&JournalEntryData::board_id)
+                    .references(&BoardData::id)
+                    .on_delete.cascade()
+            ),
+
+            // CHANGE LOG (written by triggers only)
+            make_table(
+                "changes",
+                make_column("seq", &ChangeData::seq, primary_key().autoincrement()),
+                make_column("entity", &ChangeData::entity),
+                make_column("entity_id", &ChangeData::entity_id),
+                make_column("board_id", &ChangeData::board_id),
+                make_column("op", &ChangeData::op),
+                make_column("fields", &ChangeData::fields),
+                make_column("created_at", &ChangeData::created_at)
+            ),
+
+            make_table(
+                "change_checkpoints",
+                make_column("id", &ChangeCheckpointData::id, primary_key().autoincrement()),
+                make_column("seq", &ChangeCheckpointData::seq),
+                make_column("rescan_below", &ChangeCheckpointData::rescan_below),
+                make_column("created_at", &ChangeCheckpointData::created_at)
+            ),
+
+            // INDEXES
+            // Match the WHERE + ORDER BY of the hot queries so lookups never scan a table.
+            // sync_schema() creates any that are missing on existing databases.
+            make_index("idx_lists_board_position", &ListData::board_id, &ListData::position),
+            make_index(
+                "idx_cards_list_archived_position",
+                &CardData::list_id,
+                &CardData::archived,
+                &CardData::position
+            ),
+            make_index(
+                "idx_cards_board_archived_list_position",
+                &CardData::board_id,
+                &CardData::archived,
+                &CardData::list_id,
+                &CardData::position
+            ),
+            make_index("idx_badges_board", &BadgeData::board_id),
+            make_index("idx_card_badges_badge", &CardBadgeData::badge_id),
+            make_index(
+                "idx_checklist_items_card_position",
+                &ChecklistItemData::card_id,
+                &ChecklistItemData::position
+            ),
+            make_index(
+                "idx_undo_journal_board",
+                &JournalEntryData::board_id,
+                &JournalEntryData::id
+            ),
+            make_index(
+                "idx_comments_card_created",
+                &CommentData::card_id,
+                &CommentData::created_at
             )
         );
     }
-
 }
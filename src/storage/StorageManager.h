@@ -1,10 +1,21 @@
 #pragma once
 #include "storage/Storage.h"
+#include "storage/BoardQueries.h"
+#include "storage/ChangeLog.h"
+#include "storage/ConnectionProfile.h"
+#include "storage/ReadConnection.h"
+#include "storage/SchemaMigrations.h"
+#include "storage/SearchIndex.h"
 #include "PathManager.h"
+#include "Log.h"
 #include <utility>
 #include <vector>
 #include <string>
 #include <ctime>
+#include <stdexcept>
+#include <type_traits>
+#include <atomic>
+#include <memory>
 
 class StorageManager
 {
@@ -12,6 +23,93 @@ class StorageManager
     // =========================================================
     // ✅ STATIC PUBLIC API (USE LIKE: StorageManager::GetBoard(id))
     // =========================================================
+    // The connection belongs to the PersistenceWorker thread: call these from commands passed
+    // to PersistenceWorker::Submit/Run. Only ReserveId() is safe to call from any thread.
+
+    // ---------- TRANSACTIONS ----------
+
+    /**
+     * @brief Scoped transaction guard batching every write into a single commit.
+     *
+     * Batches nest: inner guards join the outermost transaction, which is the only one that
+     * talks to SQLite. A guard destroyed without Commit() (e.g. during stack unwinding) rolls
+     * the whole transaction back, and any later Commit() of an enclosing guard throws.
+     *
+     * @code
+     * StorageManager::Batch batch;
+     * StorageManager::UpdateCard(card);
+     * StorageManager::DeleteChecklistItem(itemId);
+     * batch.Commit();
+     * @endcode
+     */
+    class Batch
+    {
+      public:
+        Batch() { Get().BeginBatchInternal(); }
+        ~Batch()
+        {
+            if(!mFinished)
+                Get().EndBatchInternal(false);
+        }
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+        void Commit()
+        {
+            if(mFinished)
+                return;
+            mFinished = true;
+            Get().EndBatchInternal(true);
+        }
+
+      private:
+        bool mFinished = false;
+    };
+
+    // Runs fn inside a Batch, committing on return and rolling back if it throws
+    template<typename Fn>
+    static auto Transaction(Fn&& fn)
+    {
+        Batch batch;
+        if constexpr(std::is_void_v<std::invoke_result_t<Fn&>>)
+        {
+            fn();
+            batch.Commit();
+        }
+        else
+        {
+            auto result = fn();
+            batch.Commit();
+            return result;
+        }
+    }
+
+    static bool InTransaction() { return Get().mBatchDepth > 0; }
+
+    // Copy every WAL frame into the database file and truncate the WAL (a no-op outside WAL
+    // mode). False if a reader kept part of the WAL in use.
+    static bool Checkpoint()
+    {
+        int rc = sqlite3_wal_checkpoint_v2(
+            Get().mDb,
+            nullptr,
+            SQLITE_CHECKPOINT_TRUNCATE,
+            nullptr,
+            nullptr
+        );
+        return rc == SQLITE_OK;
+    }
+
+    // ---------- ID ALLOCATION ----------
+
+    // Row IDs are handed out in memory (seeded from MAX(id) when the database opens), so the
+    // UI thread can name a new entity immediately and let the persistence worker write it later.
+    template<typename T>
+    static int ReserveId()
+    {
+        return ++Get().LastIdOf<T>();
+    }
 
     // ---------- BOARDS ----------
     static int CreateBoard(Storage::BoardData b) { return Get().CreateBoardInternal(std::move(b)); }
@@ -22,8 +120,23 @@ class StorageManager
 
     static void UpdateBoard(Storage::BoardData b) { Get().UpdateBoardInternal(std::move(b)); }
 
+    static void UpsertBoard(Storage::BoardData b) { Get().UpsertBoardInternal(std::move(b)); }
+
     static void DeleteBoard(int id) { Get().DeleteBoardInternal(id); }
 
+    // Fetch every list, card, checklist item and badge link of a board in a fixed
+    // number of queries, independent of how many cards the board holds.
+    static Storage::BoardBundle LoadBoardBundle(int boardId)
+    {
+        return Get().LoadBoardBundleInternal(boardId);
+    }
+
+    // Every board row with its list and card counts, for startup and the home view
+    static std::vector<Storage::BoardSummary> GetBoardSummaries()
+    {
+        return Get().GetBoardSummariesInternal();
+    }
+
     // ---------- LISTS ----------
     static int CreateList(Storage::ListData l) { return Get().CreateListInternal(std::move(l)); }
 
@@ -36,6 +149,10 @@ class StorageManager
 
     static void UpdateList(Storage::ListData l) { Get().UpdateListInternal(std::move(l)); }
 
+    static void UpsertList(Storage::ListData l) { Get().UpsertListInternal(std::move(l)); }
+
+    static void DeleteList(int id) { Get().DeleteListInternal(id); }
+
     static void ReorderList(int listId, double prevPos, double nextPos)
     {
         Get().ReorderListInternal(listId, prevPos, nextPos);
@@ -51,8 +168,15 @@ class StorageManager
         return Get().GetCardsInListInternal(listId);
     }
 
+    static std::vector<Storage::CardData> GetCardsInBoard(int boardId)
+    {
+        return Get().GetCardsInBoardInternal(boardId);
+    }
+
     static void UpdateCard(Storage::CardData c) { Get().UpdateCardInternal(std::move(c)); }
 
+    static void UpsertCard(Storage::CardData c) { Get().UpsertCardInternal(std::move(c)); }
+
     static void DeleteCard(int id) { Get().DeleteCardInternal(id); }
 
     static void MoveCardToList(int cardId, int newListId, double newPos)
@@ -92,6 +216,11 @@ class StorageManager
         return Get().GetBadgesForCardInternal(cardId);
     }
 
+    static std::vector<Storage::CardBadgeData> GetCardBadgesInBoard(int boardId)
+    {
+        return Get().GetCardBadgesInBoardInternal(boardId);
+    }
+
     // ---------- CHECKLIST ITEMS (FLATTENED) ----------
     static int CreateChecklistItem(const Storage::ChecklistItemData& i)
     {
@@ -103,11 +232,21 @@ class StorageManager
         return Get().GetChecklistItemsForCardInternal(cardId);
     }
 
+    static std::vector<Storage::ChecklistItemData> GetChecklistItemsInBoard(int boardId)
+    {
+        return Get().GetChecklistItemsInBoardInternal(boardId);
+    }
+
     static void UpdateChecklistItem(const Storage::ChecklistItemData& i)
     {
         Get().UpdateChecklistItemInternal(i);
     }
 
+    static void UpsertChecklistItem(const Storage::ChecklistItemData& i)
+    {
+        Get().UpsertInternal(i);
+    }
+
     static void DeleteChecklistItem(int id) { Get().DeleteChecklistItemInternal(id); }
 
     // ---------- COMMENTS ----------
@@ -118,12 +257,45 @@ class StorageManager
         return Get().GetCommentsForCardInternal(cardId);
     }
 
+    // ---------- UNDO JOURNAL ----------
+    static std::vector<Storage::JournalEntryData> GetJournalEntries(int boardId)
+    {
+        return Get().GetJournalEntriesInternal(boardId);
+    }
+
+    static void UpsertJournalEntry(const Storage::JournalEntryData& e) { Get().UpsertInternal(e); }
+
+    static void DeleteJournalEntry(int id) { Get().DeleteJournalEntryInternal(id); }
+
+    // ---------- CHANGE LOG ----------
+    // Changes after `seq`, oldest first; pass the last seq returned to continue. See ChangeLog.h
+    static std::vector<Storage::ChangeData> GetChangesSince(int64_t seq, int limit = 1000)
+    {
+        return Get().GetChangesSinceInternal(seq, limit);
+    }
+
+    static int64_t LatestChangeSeq() { return Storage::LatestChangeSeq(Get().mDb); }
+
+    // Newest compaction; all zero before the first one
+    static Storage::ChangeCheckpointData GetChangeLogCheckpoint()
+    {
+        return Get().GetChangeLogCheckpointInternal();
+    }
+
+    // Runs by itself every kCompactionStep changes; false if there was nothing to fold
+    static bool CompactChangeLog() { return Get().CompactChangeLogInternal(); }
+
     // ---------- SEARCH ----------
-    static std::vector<Storage::CardData> SearchCards(int boardId, const std::string& text)
+    // Ranked full-text search over card titles, descriptions, checklist items and comments.
+    // Reads the connection, so UI code runs it through PersistenceWorker::Run
+    static std::vector<Storage::SearchHit>
+    SearchCards(int boardId, const std::string& text, int limit = 50)
     {
-        return Get().SearchCardsInternal(boardId, text);
+        return Get().SearchCardsInternal(boardId, text, limit);
     }
 
+    static void RebuildSearchIndex() { Storage::RebuildSearchIndex(Get().mDb); }
+
   private:
     // =========================================================
     // ✅ SINGLETON CORE
@@ -131,21 +303,76 @@ class StorageManager
 
     static StorageManager& Get()
     {
-        static StorageManager instance(Stride::PathManager::Get().GetDatabaseFile().generic_u8string());
+        static StorageManager instance(
+            Stride::PathManager::Get().GetDatabaseFile().generic_u8string(),
+            Storage::ConnectionProfile::Load(Stride::PathManager::Get().GetSettingsFile())
+        );
         return instance;
     }
 
     StorageManager(const StorageManager&) = delete;
     StorageManager& operator=(const StorageManager&) = delete;
 
-    StorageManager(const std::string& path) : mStorage(Storage::SetupStorageDatabaseModels(path))
+    StorageManager(const std::string& path, const Storage::ConnectionProfile& profile)
+        : mStorage(Storage::SetupStorageDatabaseModels(path))
     {
+        // Before anything opens the file: sync_schema() would recreate retyped tables empty
+        Storage::MigrateDatabase(path);
+
+        // Per-connection PRAGMAs are lost when a connection closes, so keep a single one open
+        mStorage.on_open = [this, profile](sqlite3* db) {
+            profile.Apply(db);
+            mDb = db;
+        };
+        mStorage.open_forever();
         mStorage.sync_schema();
+
+        // FTS5 tables and triggers are outside what sqlite_orm can declare
+        Storage::EnsureSearchIndex(mDb);
+        Storage::EnsureChangeLog(mDb);
+        mCompactedChangeSeq = Storage::LastCompactedSeq(mDb);
+
+        // Readers open the same file with the same profile, now that the schema is in place
+        Storage::ReadConnection::Configure(path, profile);
+
+        SeedLastId(mLastBoardId, mStorage.max(&Storage::BoardData::id));
+        SeedLastId(mLastListId, mStorage.max(&Storage::ListData::id));
+        SeedLastId(mLastCardId, mStorage.max(&Storage::CardData::id));
+        SeedLastId(mLastBadgeId, mStorage.max(&Storage::BadgeData::id));
+        SeedLastId(mLastChecklistItemId, mStorage.max(&Storage::ChecklistItemData::id));
+        SeedLastId(mLastCommentId, mStorage.max(&Storage::CommentData::id));
+        SeedLastId(mLastJournalEntryId, mStorage.max(&Storage::JournalEntryData::id));
+
+        GL_INFO(
+            "Opened database \"{}\" (journal_mode={}, synchronous={})",
+            path,
+            profile.journalMode,
+            profile.synchronous
+        );
     }
 
   private:
     decltype(Storage::SetupStorageDatabaseModels("")) mStorage;
 
+    // Raw handle of the connection kept open by open_forever(), for the FTS5 search index
+    sqlite3* mDb = nullptr;
+
+    // Open Batch guards; only the outermost one begins and ends the SQLite transaction
+    int mBatchDepth = 0;
+    bool mBatchRolledBack = false;
+
+    // Seq the change log was last compacted up to (or attempted), see CompactChangeLogIfDue()
+    int64_t mCompactedChangeSeq = 0;
+
+    // Highest row ID handed out per table, see ReserveId()
+    std::atomic<int> mLastBoardId{ 0 };
+    std::atomic<int> mLastListId{ 0 };
+    std::atomic<int> mLastCardId{ 0 };
+    std::atomic<int> mLastBadgeId{ 0 };
+    std::atomic<int> mLastChecklistItemId{ 0 };
+    std::atomic<int> mLastCommentId{ 0 };
+    std::atomic<int> mLastJournalEntryId{ 0 };
+
     double Mid(double a, double b) { return (a + b) * 0.5; }
     int64_t Now() { return static_cast<int64_t>(time(nullptr)); }
 
@@ -153,12 +380,121 @@ class StorageManager
     // ✅ INTERNAL IMPLEMENTATION
     // =========================================================
 
+    // ----- ID ALLOCATION -----
+    template<typename T>
+    std::atomic<int>& LastIdOf()
+    {
+        if constexpr(std::is_same_v<T, Storage::BoardData>)
+            return mLastBoardId;
+        else if constexpr(std::is_same_v<T, Storage::ListData>)
+            return mLastListId;
+        else if constexpr(std::is_same_v<T, Storage::CardData>)
+            return mLastCardId;
+        else if constexpr(std::is_same_v<T, Storage::BadgeData>)
+            return mLastBadgeId;
+        else if constexpr(std::is_same_v<T, Storage::ChecklistItemData>)
+            return mLastChecklistItemId;
+        else if constexpr(std::is_same_v<T, Storage::CommentData>)
+            return mLastCommentId;
+        else if constexpr(std::is_same_v<T, Storage::JournalEntryData>)
+            return mLastJournalEntryId;
+        else
+            static_assert(sizeof(T) == 0, "Table has no reserved ID counter");
+    }
+
+    static void SeedLastId(std::atomic<int>& lastId, const std::unique_ptr<int>& maxId)
+    {
+        lastId = maxId ? *maxId : 0;
+    }
+
+    // Inserts always carry a reserved ID so rows created here never collide with reservations
+    template<typename T>
+    int InsertInternal(T row)
+    {
+        row.id = ++LastIdOf<T>();
+        mStorage.replace(row);
+        return row.id;
+    }
+
+    // The model does not keep creation times: an update must not overwrite the stored one
+    template<typename T>
+    int64_t StoredCreatedAt(int id, int64_t fallback)
+    {
+        using namespace sqlite_orm;
+        auto stored = mStorage.select(&T::created_at, where(c(&T::id) == id));
+        return stored.empty() ? fallback : stored.front();
+    }
+
+    // REPLACE on an existing row would fire its ON DELETE CASCADEs, so update in place first
+    template<typename T>
+    void UpsertInternal(const T& row)
+    {
+        mStorage.update(row);
+        if(mStorage.changes() == 0)
+            mStorage.replace(row);
+    }
+
+    // ----- TRANSACTIONS -----
+    void BeginBatchInternal()
+    {
+        if(mBatchDepth == 0)
+        {
+            mStorage.begin_transaction();
+            mBatchRolledBack = false;
+
+            // Checked at commit, so the order of writes within a batch does not matter (e.g. a
+            // card queued earlier and since moved into a list created after it). Resets there.
+            sqlite3_exec(mDb, "PRAGMA defer_foreign_keys = ON", nullptr, nullptr, nullptr);
+        }
+        ++mBatchDepth;
+    }
+
+    // Called from ~Batch with commit == false, so the rollback path must not throw
+    void EndBatchInternal(bool commit)
+    {
+        if(!commit)
+            mBatchRolledBack = true;
+
+        if(--mBatchDepth > 0)
+            return;
+
+        if(!mBatchRolledBack)
+        {
+            // A failed COMMIT (e.g. a deferred foreign key) leaves the transaction open, and
+            // every later BEGIN would fail with it
+            try
+            {
+                mStorage.commit();
+            }
+            catch(...)
+            {
+                mStorage.rollback();
+                mBatchRolledBack = false;
+                throw;
+            }
+            CompactChangeLogIfDue();
+            return;
+        }
+
+        try
+        {
+            mStorage.rollback();
+        }
+        catch(const std::exception& e)
+        {
+            GL_ERROR("Failed to roll back transaction: {}", e.what());
+        }
+
+        if(commit)
+            throw std::runtime_error("Transaction was rolled back by a nested batch");
+    }
+
     // ----- BOARDS -----
     int CreateBoardInternal(Storage::BoardData b)
     {
         b.created_at = Now();
         b.updated_at = Now();
-        return mStorage.insert(b);
+        return InsertInternal(std::move(b));
     }
 
     std::vector<Storage::BoardData> GetAllBoardsInternal()
@@ -175,23 +511,37 @@ class StorageManager
         mStorage.update(b);
     }
 
+    void UpsertBoardInternal(Storage::BoardData b)
+    {
+        if(b.created_at == 0)
+            b.created_at = Now();
+        b.updated_at = Now();
+        UpsertInternal(b);
+    }
+
     void DeleteBoardInternal(int id) { mStorage.remove<Storage::BoardData>(id); }
 
+    Storage::BoardBundle LoadBoardBundleInternal(int boardId)
+    {
+        return Storage::LoadBoardBundle(mStorage, boardId);
+    }
+
+    std::vector<Storage::BoardSummary> GetBoardSummariesInternal()
+    {
+        return Storage::LoadBoardSummaries(mStorage);
+    }
+
     // ----- LISTS -----
     int CreateListInternal(Storage::ListData l)
     {
         l.created_at = Now();
         l.updated_at = Now();
-        return mStorage.insert(l);
+        return InsertInternal(std::move(l));
     }
 
     std::vector<Storage::ListData> GetListsInBoardInternal(int boardId)
     {
-        using namespace sqlite_orm;
-        return mStorage.get_all<Storage::ListData>(
-            where(c(&Storage::ListData::board_id) == boardId),
-            order_by(&Storage::ListData::position)
-        );
+        return Storage::ListsInBoard(mStorage, boardId);
     }
 
     Storage::ListData GetListInternal(int id) { return mStorage.get<Storage::ListData>(id); }
@@ -202,6 +552,16 @@ class StorageManager
         mStorage.update(l);
     }
 
+    void UpsertListInternal(Storage::ListData l)
+    {
+        l.updated_at = Now();
+        if(l.created_at == 0)
+            l.created_at = StoredCreatedAt<Storage::ListData>(l.id, l.updated_at);
+        UpsertInternal(l);
+    }
+
+    void DeleteListInternal(int id) { mStorage.remove<Storage::ListData>(id); }
+
     void ReorderListInternal(int listId, double prevPos, double nextPos)
     {
         auto l = mStorage.get<Storage::ListData>(listId);
@@ -215,7 +575,7 @@ class StorageManager
     {
         c.created_at = Now();
         c.updated_at = Now();
-        return mStorage.insert(c);
+        return InsertInternal(std::move(c));
     }
 
     Storage::CardData GetCardInternal(int id) { return mStorage.get<Storage::CardData>(id); }
@@ -231,12 +591,25 @@ class StorageManager
         );
     }
 
+    std::vector<Storage::CardData> GetCardsInBoardInternal(int boardId)
+    {
+        return Storage::CardsInBoard(mStorage, boardId);
+    }
+
     void UpdateCardInternal(Storage::CardData c)
     {
         c.updated_at = Now();
         mStorage.update(c);
     }
 
+    void UpsertCardInternal(Storage::CardData c)
+    {
+        c.updated_at = Now();
+        if(c.created_at == 0)
+            c.created_at = StoredCreatedAt<Storage::CardData>(c.id, c.updated_at);
+        UpsertInternal(c);
+    }
+
     void DeleteCardInternal(int id) { mStorage.remove<Storage::CardData>(id); }
 
     void MoveCardToListInternal(int cardId, int newListId, double newPos)
@@ -271,14 +644,11 @@ class StorageManager
     }
 
     // ----- BADGES -----
-    int CreateBadgeInternal(const Storage::BadgeData& b) { return mStorage.insert(b); }
+    int CreateBadgeInternal(const Storage::BadgeData& b) { return InsertInternal(b); }
 
     std::vector<Storage::BadgeData> GetBadgesInBoardInternal(int boardId)
     {
-        using namespace sqlite_orm;
-        return mStorage.get_all<Storage::BadgeData>(
-            where(c(&Storage::BadgeData::board_id) == boardId)
-        );
+        return Storage::BadgesInBoard(mStorage, boardId);
     }
 
     void AddBadgeToCardInternal(int cardId, int badgeId)
@@ -303,10 +673,15 @@ class StorageManager
         );
     }
 
+    std::vector<Storage::CardBadgeData> GetCardBadgesInBoardInternal(int boardId)
+    {
+        return Storage::CardBadgesInBoard(mStorage, boardId);
+    }
+
     // ----- CHECKLIST ITEMS (FLATTENED) -----
     int CreateChecklistItemInternal(const Storage::ChecklistItemData& i)
     {
-        return mStorage.insert(i);
+        return InsertInternal(i);
     }
 
     std::vector<Storage::ChecklistItemData> GetChecklistItemsForCardInternal(int cardId)
@@ -318,6 +693,11 @@ class StorageManager
         );
     }
 
+    std::vector<Storage::ChecklistItemData> GetChecklistItemsInBoardInternal(int boardId)
+    {
+        return Storage::ChecklistItemsInBoard(mStorage, boardId);
+    }
+
     void UpdateChecklistItemInternal(const Storage::ChecklistItemData& i) { mStorage.update(i); }
 
     void DeleteChecklistItemInternal(int id) { mStorage.remove<Storage::ChecklistItemData>(id); }
@@ -326,7 +706,7 @@ class StorageManager
     int AddCommentInternal(Storage::CommentData c)
     {
         c.created_at = Now();
-        return mStorage.insert(c);
+        return InsertInternal(std::move(c));
     }
 
     std::vector<Storage::CommentData> GetCommentsForCardInternal(int cardId)
@@ -338,15 +718,64 @@ class StorageManager
         );
     }
 
-    // ----- SEARCH -----
-    std::vector<Storage::CardData> SearchCardsInternal(int boardId, const std::string& text)
+    // ----- UNDO JOURNAL -----
+    std::vector<Storage::JournalEntryData> GetJournalEntriesInternal(int boardId)
+    {
+        return Storage::JournalEntriesOfBoard(mStorage, boardId);
+    }
+
+    void DeleteJournalEntryInternal(int id) { mStorage.remove<Storage::JournalEntryData>(id); }
+
+    // ----- CHANGE LOG -----
+    std::vector<Storage::ChangeData> GetChangesSinceInternal(int64_t seq, int maxRows)
     {
         using namespace sqlite_orm;
-        std::string q = "%" + text + "%";
+        return mStorage.get_all<Storage::ChangeData>(
+            where(c(&Storage::ChangeData::seq) > seq),
+            order_by(&Storage::ChangeData::seq),
+            limit(maxRows)
+        );
+    }
 
-        return mStorage.get_all<Storage::CardData>(where(
-            c(&Storage::CardData::board_id) == boardId
-            && (like(&Storage::CardData::title, q) || like(&Storage::CardData::description, q))
-        ));
+    Storage::ChangeCheckpointData GetChangeLogCheckpointInternal()
+    {
+        using namespace sqlite_orm;
+        auto checkpoints = mStorage.get_all<Storage::ChangeCheckpointData>(
+            order_by(&Storage::ChangeCheckpointData::id).desc(),
+            limit(1)
+        );
+        return checkpoints.empty() ? Storage::ChangeCheckpointData{} : checkpoints.front();
+    }
+
+    bool CompactChangeLogInternal()
+    {
+        const bool compacted = Storage::CompactChangeLog(mDb, Now());
+        mCompactedChangeSeq = Storage::LastCompactedSeq(mDb);
+        return compacted;
+    }
+
+    // After each commit, so the log is folded in its own short transaction; never throws
+    void CompactChangeLogIfDue()
+    {
+        const int64_t latest = Storage::LatestChangeSeq(mDb);
+        if(latest - mCompactedChangeSeq < Storage::kRetainedChanges + Storage::kCompactionStep)
+            return;
+
+        if(CompactChangeLogInternal())
+        {
+            GL_INFO("Compacted the change log up to seq {}", mCompactedChangeSeq);
+        }
+        else
+        {
+            // Do not retry on every commit; the next attempt waits another step
+            mCompactedChangeSeq = latest - Storage::kRetainedChanges;
+        }
+    }
+
+    // ----- SEARCH -----
+    std::vector<Storage::SearchHit>
+    SearchCardsInternal(int boardId, const std::string& text, int limit)
+    {
+        return Storage::SearchBoard(mDb, boardId, text, limit);
     }
 };
@@ -4,6 +4,22 @@
 #include "imgui_test_engine/imgui_te_engine.h"
 #include "imgui_test_engine/imgui_te_context.h"
 #include "managers/BoardManager.h"
+#include "managers/CardSelection.h"
+#include "managers/DragDropManager.h"
+#include "managers/UndoJournal.h"
+#include "renderers/CardRenderer.h"
+#include "storage/BoardSnapshot.h"
+#include "utilities/AllocationCounter.h"
+#include "utilities/EdgeAutoScroll.h"
+#include "utilities/FrameArena.h"
+#include "PathManager.h"
+#include "Timer.h"
+#include "utilities/UniqueId.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
 
 ImGuiID FindItemBySubstring(ImGuiTestContext* ctx, const char* substring)
 {
@@ -22,6 +38,170 @@ ImGuiID FindItemBySubstring(ImGuiTestContext* ctx, const char* substring)
     return 0;
 }
 
+namespace
+{
+    constexpr int kListsPerBoard = 50;
+
+    Stride::BoardData BuildBenchmarkBoard(int totalCards, std::vector<Stride::CardId>& cardIds)
+    {
+        Stride::BoardData board("Lookup benchmark");
+        for(int l = 0; l < kListsPerBoard; ++l)
+        {
+            board.AddList("List " + std::to_string(l));
+        }
+        for(int i = 0; i < totalCards; ++i)
+        {
+            Stride::CardList& list = board.lists[i % kListsPerBoard];
+            list.AddCard(Stride::Card("Card " + std::to_string(i)));
+            cardIds.push_back(list.cards.back().id);
+        }
+        return board;
+    }
+
+    // The scan FindCard used to do, kept as the baseline
+    const Stride::Card* LinearFindCard(const Stride::BoardData& board, Stride::CardId cardId)
+    {
+        for(const auto& list : board.lists)
+        {
+            auto it = std::find_if(list.cards.begin(), list.cards.end(), [&](const auto& card) {
+                return card.id == cardId;
+            });
+            if(it != list.cards.end())
+                return &(*it);
+        }
+        return nullptr;
+    }
+
+    // genUID as it was before UniqueId, kept as the construction baseline
+    std::string LegacyGenUid(int length = 16)
+    {
+        static std::string str("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+        std::random_device rd;
+        std::mt19937 generator(rd());
+        std::shuffle(str.begin(), str.end(), generator);
+        return str.substr(0, length);
+    }
+
+    // Zipf-distributed words built from syllables, so titles share prefixes like real text
+    std::string SearchWords(std::mt19937& rng, int count)
+    {
+        static const char* kSyllables[] = { "ka", "lo", "mi", "ne", "ru", "sa",
+                                            "te", "vo", "xi", "za", "bo", "de" };
+        std::string text;
+        for(int i = 0; i < count; ++i)
+        {
+            // Inverse-CDF draw of a rank in [0, 4000) with roughly 1/rank frequency
+            const float u = static_cast<float>(rng() % 1000000) / 1000000.0f;
+            const int rank = static_cast<int>(std::pow(4001.0f, u)) - 1;
+            if(i > 0)
+                text += ' ';
+            for(int n = rank + 144; n > 0; n /= 12)
+            {
+                text += kSyllables[n % 12];
+            }
+        }
+        return text;
+    }
+
+    // Give every entity a row ID and mark it clean, as if the board had just been loaded
+    void MarkSaved(Stride::BoardData& board, int& lastRowId)
+    {
+        board.id = Stride::BoardId::FromRow(++lastRowId);
+        board.changes.MarkClean();
+        for(auto& list : board.lists)
+        {
+            list.id = Stride::ListId::FromRow(++lastRowId);
+            list.changes.MarkClean();
+            for(auto& card : list.cards)
+            {
+                card.id = Stride::CardId::FromRow(++lastRowId);
+                card.changes.MarkClean();
+                for(auto& item : card.checklist)
+                {
+                    item.id = Stride::ChecklistItemId::FromRow(++lastRowId);
+                    item.changes.MarkClean();
+                }
+            }
+        }
+        board.RebuildIndex();
+    }
+
+    // Card list child windows that were submitted in the last frame
+    int RenderedListWindows()
+    {
+        int count = 0;
+        for(ImGuiWindow* window : GImGui->Windows)
+        {
+            if(window->WasActive && strstr(window->Name, "/CardList_"))
+                ++count;
+        }
+        return count;
+    }
+
+    ImGuiWindow* FindBoardContentWindow()
+    {
+        for(ImGuiWindow* window : GImGui->Windows)
+        {
+            if(strstr(window->Name, "/BoardContent_"))
+                return window;
+        }
+        return nullptr;
+    }
+
+    // The scans FindCurrentDropzone used to do, kept as the hit testing baseline
+    const Stride::Dropzone* LinearHitTest(
+        const std::vector<std::pair<Stride::ListId, ImRect>>& lists,
+        const std::vector<Stride::Dropzone>& zones,
+        ImVec2 mouse
+    )
+    {
+        Stride::ListId hovered;
+        for(const auto& [listId, rect] : lists)
+        {
+            if(rect.Contains(mouse))
+            {
+                hovered = listId;
+                break;
+            }
+        }
+
+        float closest_dist = FLT_MAX;
+        const Stride::Dropzone* closest = nullptr;
+        for(const auto& zone : zones)
+        {
+            if(hovered.IsValid() && zone.list_id != hovered)
+                continue;
+            ImVec2 center = (zone.rect.Min + zone.rect.Max) * 0.5f;
+            float dist = (mouse.x - center.x) * (mouse.x - center.x)
+                         + (mouse.y - center.y) * (mouse.y - center.y);
+            if(dist + 10.0f < closest_dist)
+            {
+                closest_dist = dist;
+                closest = &zone;
+            }
+        }
+        return closest;
+    }
+
+    float SquaredDistance(const Stride::Dropzone& zone, ImVec2 point)
+    {
+        ImVec2 center = (zone.rect.Min + zone.rect.Max) * 0.5f;
+        return (point.x - center.x) * (point.x - center.x)
+               + (point.y - center.y) * (point.y - center.y);
+    }
+
+    // Average microseconds per lookup over a fixed random sample of card IDs
+    template<typename Fn>
+    float MicrosPerLookup(const std::vector<Stride::CardId>& sample, int& hits, Fn&& find)
+    {
+        OpenGL::Timer timer;
+        for(Stride::CardId id : sample)
+        {
+            hits += find(id) != nullptr;
+        }
+        return timer.ElapsedMillis() * 1000.0f / static_cast<float>(sample.size());
+    }
+}
 
 void RegisterBoardTests(ImGuiTestEngine* engine)
 {
@@ -36,6 +216,9 @@ void RegisterBoardTests(ImGuiTestEngine* engine)
         
         Stride::BoardData* activeBoard = boardManager.GetActiveBoard();
         IM_CHECK(activeBoard != nullptr);
+
+        // Setup() only reads summaries; the list view needs the board's content
+        IM_CHECK(boardManager.GetRepository().LoadNow(activeBoard->id));
         
         size_t initial_count = activeBoard->lists.size();
 
@@ -65,4 +248,869 @@ void RegisterBoardTests(ImGuiTestEngine* engine)
     //Board\/BoardContent_02388B04/+  Add another list
     //Board\/BoardContent_02388B04/+  Add another list
     //Board\/BoardContent_02388B04/+  Add another list##AddAnotherList
-}
\ No newline at end of file
+
+    // -----------------------------------------------------------------
+    // Benchmark: indexed FindCard vs linear scan at 10k and 100k cards
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "CardLookupIndex");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kLookups = 2000;
+
+        for(int totalCards : { 10000, 100000 })
+        {
+            std::vector<Stride::CardId> cardIds;
+            Stride::BoardData board = BuildBenchmarkBoard(totalCards, cardIds);
+
+            std::mt19937 rng(1234);
+            std::vector<Stride::CardId> sample(kLookups);
+            for(auto& id : sample)
+            {
+                id = cardIds[rng() % cardIds.size()];
+            }
+
+            int indexedHits = 0, linearHits = 0;
+            board.FindCard(sample.front()); // Build the index outside the timed loop
+            float indexed = MicrosPerLookup(sample, indexedHits, [&](Stride::CardId id) {
+                return board.FindCard(id);
+            });
+            float linear = MicrosPerLookup(sample, linearHits, [&](Stride::CardId id) {
+                return LinearFindCard(board, id);
+            });
+
+            ctx->LogInfo(
+                "%6d cards: indexed %.3f us, linear %.3f us per lookup",
+                totalCards,
+                indexed,
+                linear
+            );
+
+            IM_CHECK_EQ(indexedHits, kLookups);
+            IM_CHECK_EQ(linearHits, kLookups);
+            IM_CHECK_LT(indexed, 10.0f); // Generous for unoptimised Debug builds
+            IM_CHECK_LT(indexed, linear);
+        }
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: card construction with the old genUID vs typed IDs
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "CardConstruction");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kCards = 20000;
+        size_t checksum = 0;
+
+        // Old constructor cost: the card itself plus one genUID per card
+        OpenGL::Timer legacyTimer;
+        for(int i = 0; i < kCards; ++i)
+        {
+            Stride::Card card("Card");
+            checksum += LegacyGenUid().size() + card.title.size();
+        }
+        float legacy = legacyTimer.ElapsedMillis() * 1000.0f / kCards;
+
+        OpenGL::Timer currentTimer;
+        for(int i = 0; i < kCards; ++i)
+        {
+            Stride::Card card("Card");
+            checksum += static_cast<size_t>(card.id.Raw() & 1) + card.title.size();
+        }
+        float current = currentTimer.ElapsedMillis() * 1000.0f / kCards;
+
+        OpenGL::Timer uniqueIdTimer;
+        for(int i = 0; i < kCards; ++i)
+        {
+            checksum += Stride::UniqueId::Generate().c_str()[0];
+        }
+        float uniqueId = uniqueIdTimer.ElapsedMillis() * 1000.0f / kCards;
+
+        ctx->LogInfo("Card() with genUID:  %.4f us", legacy);
+        ctx->LogInfo("Card() with CardId:  %.4f us", current);
+        ctx->LogInfo("UniqueId::Generate:  %.4f us (checksum %zu)", uniqueId, checksum);
+
+        IM_CHECK_LT(current * 10.0f, legacy);
+        IM_CHECK_LT(uniqueId * 10.0f, legacy);
+    };
+
+    // -----------------------------------------------------------------
+    // Test + benchmark: in-memory search index, per keystroke at 50k cards
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "InMemorySearch");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        std::vector<Stride::BoardData> boards;
+        boards.emplace_back("Search");
+        Stride::BoardData& board = boards.back();
+        board.AddList("Todo");
+        board.AddList("Done");
+        board.lists[0].AddCard(
+            Stride::Card("Fix login bug", "Users cannot receive emails", { "Bug", "Backend" })
+        );
+        board.lists[0].AddCard(Stride::Card("Payment page", "login required first", { "Feature" }));
+        board.lists[1].AddCard(Stride::Card("Über résumé", "Unicode title", { "bug" }));
+        board.lists[1].cards.back().AddChecklistItem("Write migration script");
+        const Stride::CardId loginCard = board.lists[0].cards[0].id;
+
+        Stride::CardSearchIndex index;
+        Stride::CardSearchQuery query;
+        auto count = [&](const char* text) {
+            query.text = text;
+            return static_cast<int>(index.Search(boards, query).size());
+        };
+
+        IM_CHECK_EQ(count("login"), 2);
+        IM_CHECK(index.Search(boards, query).front().card == loginCard); // Title beats body
+        IM_CHECK_EQ(count("log"), 2);
+        IM_CHECK_EQ(count("login bu"), 1);
+        IM_CHECK_EQ(count("recieve"), 1); // Transposition
+        IM_CHECK_EQ(count("über"), 1);
+        IM_CHECK_EQ(count("migrat"), 1);
+        query.fuzzy = false;
+        IM_CHECK_EQ(count("recieve"), 0);
+        query.fuzzy = true;
+
+        query.badges = { "BUG" };
+        IM_CHECK_EQ(count(""), 2);
+        IM_CHECK_EQ(count("login"), 1);
+        query.badges = { "bug", "backend" };
+        IM_CHECK_EQ(count(""), 1);
+        query.badges = { "missing" };
+        IM_CHECK_EQ(count(""), 0);
+        query.badges.clear();
+
+        // Edits are picked up once the board is marked dirty, removals through the layout
+        Stride::Card& payment = board.lists[0].cards[1];
+        payment.title = "Checkout flow";
+        payment.changes.Touch();
+        index.MarkDirty(board.id);
+        IM_CHECK_EQ(count("checkout"), 1);
+        IM_CHECK_EQ(count("payment"), 0);
+        board.lists[0].RemoveCard(loginCard);
+        IM_CHECK_EQ(count("fix"), 0);
+        IM_CHECK(index.CardCount() == 2);
+
+        // 50k cards over 5 boards, searched one keystroke at a time
+        constexpr int kBoards = 5;
+        constexpr int kCardsPerBoard = 10000;
+        std::mt19937 rng(42);
+        std::vector<Stride::BoardData> large;
+        for(int b = 0; b < kBoards; ++b)
+        {
+            large.emplace_back("Board " + std::to_string(b));
+            for(int l = 0; l < kListsPerBoard; ++l)
+            {
+                large.back().AddList("List " + std::to_string(l));
+            }
+            for(int i = 0; i < kCardsPerBoard; ++i)
+            {
+                large.back().lists[i % kListsPerBoard].AddCard(Stride::Card(
+                    SearchWords(rng, 4), SearchWords(rng, 15), { i % 7 == 0 ? "Bug" : "Feature" }
+                ));
+            }
+        }
+
+        Stride::CardSearchIndex largeIndex;
+        OpenGL::Timer buildTimer;
+        largeIndex.Sync(large);
+        float build = buildTimer.ElapsedMillis();
+        IM_CHECK(largeIndex.CardCount() == kBoards * kCardsPerBoard);
+
+        const std::string typed = large[0].lists[0].cards[0].title;
+        float total = 0.0f, worst = 0.0f;
+        size_t hits = 0;
+        Stride::CardSearchQuery keystroke;
+        for(size_t length = 1; length <= typed.size(); ++length)
+        {
+            keystroke.text = typed.substr(0, length);
+            OpenGL::Timer timer;
+            hits = largeIndex.Search(large, keystroke).size();
+            float ms = timer.ElapsedMillis();
+            total += ms;
+            worst = std::max(worst, ms);
+        }
+        float average = total / static_cast<float>(typed.size());
+
+        // A one-card edit costs one card, not a rebuild
+        Stride::Card& edited = large[0].lists[0].cards[0];
+        edited.title += " zzqx";
+        edited.changes.Touch();
+        largeIndex.MarkDirty(large[0].id);
+        keystroke.text = "zzqx";
+        OpenGL::Timer editTimer;
+        int editHits = static_cast<int>(largeIndex.Search(large, keystroke).size());
+        float edit = editTimer.ElapsedMillis();
+
+        ctx->LogInfo("Index build: %.1f ms for %d cards", build, kBoards * kCardsPerBoard);
+        ctx->LogInfo("Per keystroke: %.3f ms avg, %.3f ms worst", average, worst);
+        ctx->LogInfo("Search after one-card edit: %.3f ms", edit);
+
+        IM_CHECK(hits >= 1);
+        IM_CHECK_EQ(editHits, 1);
+        IM_CHECK_LT(worst, 16.0f); // Within one frame at 60 Hz
+        IM_CHECK_LT(edit, 16.0f);
+    };
+
+    // -----------------------------------------------------------------
+    // Test: memory accounting and unloading back to a summary
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "MemoryAccounting");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kCards = 100000;
+        std::vector<Stride::CardId> cardIds;
+        Stride::BoardData board = BuildBenchmarkBoard(kCards, cardIds);
+        board.lists[0].cards[0].description = std::string(4096, 'x');
+        board.lists[0].cards[0].AddChecklistItem("Checklist items are counted too");
+
+        OpenGL::Timer timer;
+        const size_t loaded = board.ResidentBytes();
+        const float accounting = timer.ElapsedMillis();
+        ctx->LogInfo(
+            "%d cards: %zu KB resident, counted in %.2f ms",
+            kCards,
+            loaded >> 10,
+            accounting
+        );
+
+        // At least the Card objects themselves and the long description
+        IM_CHECK(loaded > kCards * sizeof(Stride::Card) + 4096);
+        IM_CHECK_LT(accounting, 50.0f);
+
+        // Freshly built cards were never saved, so they must not be evicted
+        IM_CHECK(board.HasUnsavedChanges());
+        for(auto& list : board.lists)
+        {
+            list.changes.MarkClean();
+            for(auto& card : list.cards)
+            {
+                card.changes.MarkClean();
+                for(auto& item : card.checklist)
+                {
+                    item.changes.MarkClean();
+                }
+            }
+        }
+        board.changes.MarkClean();
+        IM_CHECK(!board.HasUnsavedChanges());
+        board.lists[0].cards[0].checklist[0].changes.Touch();
+        IM_CHECK(board.HasUnsavedChanges());
+
+        // Queued is not saved: only a committed write makes the board clean again
+        Stride::ChangeTracker& tracker = board.lists[0].cards[0].checklist[0].changes;
+        const uint32_t queued = tracker.revision;
+        tracker.MarkQueued();
+        IM_CHECK(!tracker.NeedsWrite());
+        IM_CHECK(board.HasUnsavedChanges());
+        tracker.MarkDropped(queued);
+        IM_CHECK(tracker.NeedsWrite());
+        tracker.MarkQueued();
+        tracker.MarkCommitted(queued);
+        IM_CHECK(!board.HasUnsavedChanges());
+        board.deletesInFlight = 1;
+        IM_CHECK(board.HasUnsavedChanges());
+        board.deletesInFlight = 0;
+
+        // Unloading keeps what the home view shows and releases the rest
+        board.Unload();
+        IM_CHECK(board.loadState == Stride::BoardLoadState::Summary);
+        IM_CHECK(board.GetTotalCardCount() == kCards);
+        IM_CHECK(board.GetListCount() == kListsPerBoard);
+        IM_CHECK(board.FindCard(cardIds.front()) == nullptr);
+        IM_CHECK(board.ResidentBytes() < 4096);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: startup snapshot round trip at 100k cards, and its validation
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "StartupSnapshot");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        namespace fs = std::filesystem;
+        constexpr int kBoards = 20;
+        constexpr int kCardsPerBoard = 5000; // 100k cards in total
+
+        // Stands in for stride.db: only its size, write time and header are looked at
+        const fs::path dbPath = Stride::PathManager::Get().GetTempDir() / "snapshot_test.db";
+        const fs::path snapshotPath = Stride::PathManager::Get().GetTempDir() / "snapshot_test.bin";
+        std::ofstream(dbPath, std::ios::binary | std::ios::trunc) << std::string(4096, '\0');
+
+        // Boards as they come out of the database; every other one is still a summary
+        std::vector<Stride::BoardData> boards;
+        int lastRowId = 0;
+        for(int b = 0; b < kBoards; ++b)
+        {
+            std::vector<Stride::CardId> cardIds;
+            Stride::BoardData board = BuildBenchmarkBoard(kCardsPerBoard, cardIds);
+            board.title = "Board " + std::to_string(b);
+            board.lists[0].cards[0].AddBadge("Bug");
+            board.lists[0].cards[0].AddChecklistItem("Snapshot round trip");
+            MarkSaved(board, lastRowId);
+            if(b % 2 == 1)
+                board.Unload();
+            boards.push_back(std::move(board));
+        }
+
+        OpenGL::Timer timer;
+        IM_CHECK(Stride::BoardSnapshot::Write(boards, snapshotPath, dbPath));
+        const float write = timer.ElapsedMillis();
+
+        timer.Reset();
+        auto restored = Stride::BoardSnapshot::Read(snapshotPath, dbPath);
+        const float read = timer.ElapsedMillis();
+
+        ctx->LogInfo("Snapshot: %d KB", int(fs::file_size(snapshotPath) >> 10));
+        ctx->LogInfo("Write: %.2f ms", write);
+        ctx->LogInfo("Read:  %.2f ms", read);
+
+        IM_CHECK(restored.has_value());
+        IM_CHECK(restored->size() == boards.size());
+        for(size_t b = 0; b < boards.size(); ++b)
+        {
+            const Stride::BoardData& board = (*restored)[b];
+            IM_CHECK(board.id == boards[b].id);
+            IM_CHECK(board.title == boards[b].title);
+            IM_CHECK(board.loadState == boards[b].loadState);
+            IM_CHECK(board.GetListCount() == boards[b].GetListCount());
+            IM_CHECK(board.GetTotalCardCount() == boards[b].GetTotalCardCount());
+            IM_CHECK(!board.HasUnsavedChanges());
+        }
+
+        const Stride::Card& original = boards[0].lists[0].cards[0];
+        const Stride::Card* card = (*restored)[0].FindCard(original.id);
+        IM_CHECK(card != nullptr);
+        IM_CHECK(card->title == original.title);
+        IM_CHECK(card->badges == original.badges);
+        IM_CHECK(card->checklist.size() == 1);
+        IM_CHECK(card->checklist[0].id == original.checklist[0].id);
+        IM_CHECK_LT(read, 250.0f);
+
+        // Any write to the database invalidates the snapshot
+        std::ofstream(dbPath, std::ios::binary | std::ios::app) << 'x';
+        IM_CHECK(!Stride::BoardSnapshot::Read(snapshotPath, dbPath).has_value());
+
+        // So does damage to the snapshot itself
+        IM_CHECK(Stride::BoardSnapshot::Write(boards, snapshotPath, dbPath));
+        {
+            std::fstream file(snapshotPath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-1, std::ios::end);
+            file.put('?');
+        }
+        IM_CHECK(!Stride::BoardSnapshot::Read(snapshotPath, dbPath).has_value());
+
+        // Unsaved changes are not in the database, so they are never written
+        boards[0].lists[0].cards[0].changes.Touch();
+        IM_CHECK(!Stride::BoardSnapshot::Write(boards, snapshotPath, dbPath));
+
+        std::error_code ec;
+        fs::remove(dbPath, ec);
+        fs::remove(snapshotPath, ec);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: measuring card layouts vs reusing the cached ones
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "CardLayoutCache");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kCards = 5000;
+        std::mt19937 rng(7);
+        std::vector<Stride::Card> cards;
+        cards.reserve(kCards);
+        for(int i = 0; i < kCards; ++i)
+        {
+            Stride::Card card(SearchWords(rng, 12), i % 3 ? "Details" : "", { "Bug", "Feature" });
+            if(i % 4 == 0)
+                card.AddChecklistItem("Item");
+            cards.push_back(std::move(card));
+        }
+
+        Stride::CardRenderer::ClearLayoutCache();
+        float heights = 0.0f;
+        OpenGL::Timer timer;
+        for(const auto& card : cards)
+        {
+            heights += Stride::CardRenderer::CalculateHeight(card);
+        }
+        const float measured = timer.ElapsedMillis();
+
+        timer.Reset();
+        float cachedHeights = 0.0f;
+        for(const auto& card : cards)
+        {
+            cachedHeights += Stride::CardRenderer::CalculateHeight(card);
+        }
+        const float cached = timer.ElapsedMillis();
+
+        ctx->LogInfo("%d cards measured: %.2f ms", kCards, measured);
+        ctx->LogInfo("%d cards cached:   %.2f ms", kCards, cached);
+
+        IM_CHECK(Stride::CardRenderer::CachedLayoutCount() == size_t(kCards));
+        IM_CHECK(cachedHeights == heights);
+        IM_CHECK_LT(cached * 4.0f, measured);
+
+        // An edit re-measures just that card
+        Stride::Card& card = cards.front();
+        const float before = Stride::CardRenderer::CalculateHeight(card);
+        card.title += " " + SearchWords(rng, 40);
+        card.changes.Touch();
+        IM_CHECK(Stride::CardRenderer::CalculateHeight(card) > before);
+        // Two badges plus the checklist
+        IM_CHECK(Stride::CardRenderer::GetLayout(card).badges.size() == 3);
+
+        Stride::CardRenderer::ClearLayoutCache();
+    };
+
+    // -----------------------------------------------------------------
+    // Test: lists scrolled out of view are culled to placeholders
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "ListCulling");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kLists = 60;
+        auto& boardManager = BoardManager::Get();
+        boardManager.Setup();
+
+        Stride::BoardData* activeBoard = boardManager.GetActiveBoard();
+        IM_CHECK(activeBoard != nullptr);
+        IM_CHECK(boardManager.GetRepository().LoadNow(activeBoard->id));
+
+        std::vector<Stride::ListId> addedLists;
+        while(activeBoard->lists.size() < kLists)
+        {
+            auto& list = activeBoard->AddList("Column " + std::to_string(addedLists.size()));
+            list.AddCard(Stride::Card("Card"));
+            addedLists.push_back(list.id);
+        }
+        ctx->Yield(2);
+
+        // Only the lists in view get a window, but every list keeps its drop zone
+        const int rendered = RenderedListWindows();
+        ctx->LogInfo("%d of %d lists rendered", rendered, kLists);
+        IM_CHECK(rendered > 0);
+        IM_CHECK_LT(rendered, kLists / 2);
+        IM_CHECK(Stride::DragDropManager::GetListDropZones().size() == size_t(kLists + 1));
+
+        // Placeholders keep the full width, so the board still scrolls to its last list
+        ImGuiWindow* content = FindBoardContentWindow();
+        IM_CHECK(content != nullptr);
+        IM_CHECK(content->ScrollMax.x > 0.0f);
+        ImGui::SetScrollX(content, content->ScrollMax.x);
+        ctx->Yield(2);
+        IM_CHECK(RenderedListWindows() > 0);
+        IM_CHECK_LT(RenderedListWindows(), kLists / 2);
+        ImGui::SetScrollX(content, 0.0f);
+
+        for(Stride::ListId listId : addedLists)
+        {
+            activeBoard->RemoveList(listId);
+        }
+        ctx->Yield();
+    };
+
+    // -----------------------------------------------------------------
+    // Test: an idle board view renders without heap allocations
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "SteadyStateAllocations");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        if(!Stride::AllocationCounter::kEnabled)
+        {
+            ctx->LogWarning("Allocation counting needs a Debug build, skipped");
+            return;
+        }
+
+        auto& boardManager = BoardManager::Get();
+        boardManager.Setup();
+
+        Stride::BoardData* activeBoard = boardManager.GetActiveBoard();
+        IM_CHECK(activeBoard != nullptr);
+        IM_CHECK(boardManager.GetRepository().LoadNow(activeBoard->id));
+        boardManager.SetActiveBoard(activeBoard->id);
+
+        // Layout caches and drop zone storage fill during the first frames
+        ctx->Yield(Stride::AllocationCounter::kWarmupFrames + 2);
+
+        uint64_t allocations = 0;
+        for(int frame = 0; frame < 30; ++frame)
+        {
+            ctx->Yield();
+            allocations += Stride::AllocationCounter::LastFrame();
+        }
+        ctx->LogInfo("Allocations over 30 idle frames: %llu", (unsigned long long)allocations);
+        IM_CHECK(allocations == 0);
+    };
+
+    // -----------------------------------------------------------------
+    // Test: frame arena storage is emptied by a reset and stops allocating once warm
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "FrameArena");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kZones = 20000;
+        Stride::FrameArena arena;
+        Stride::FrameVector<Stride::Dropzone> zones(arena);
+
+        size_t capacity = 0;
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            arena.Reset();
+            IM_CHECK(zones.empty());
+
+            Stride::AllocationCounter::Scope allocations;
+            for(int i = 0; i < kZones; ++i)
+            {
+                zones.push_back({ ImRect(0.0f, 0.0f, 1.0f, 1.0f), Stride::ListId(), i });
+            }
+            IM_CHECK(zones.size() == size_t(kZones));
+            IM_CHECK_EQ(zones[kZones - 1].insert_index, kZones - 1);
+
+            // The first frame grows the arena, the rest reuse what it kept
+            if(frame > 0)
+            {
+                IM_CHECK(allocations.Count() == 0);
+                IM_CHECK(arena.Capacity() == capacity);
+            }
+            capacity = arena.Capacity();
+        }
+        ctx->LogInfo("%d zones per frame in %zu KB of arena", kZones, capacity >> 10);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: drop zone hit testing over 20k zones, indexed vs linear scan
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "DropZoneHitTest");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kLists = 50;
+        constexpr int kZonesPerList = 400;
+        constexpr int kQueries = 10000;
+        using Stride::DragDropManager;
+
+        // Lists left to right, each followed by its zones top to bottom, as rendering does
+        Stride::FrameArena::Get().Reset();
+        std::vector<std::pair<Stride::ListId, ImRect>> lists;
+        std::vector<Stride::Dropzone> zones;
+        for(int l = 0; l < kLists; ++l)
+        {
+            const Stride::ListId listId = Stride::ListId::FromRow(l + 1);
+            const float x = 20.0f + l * 292.0f;
+            lists.push_back({ listId, ImRect(x, 0.0f, x + 280.0f, 2000.0f) });
+            DragDropManager::RegisterListBounds(listId, lists.back().second);
+            for(int z = 0; z < kZonesPerList; ++z)
+            {
+                const float y = 50.0f + z * 4.5f;
+                zones.push_back({ ImRect(x + 12.0f, y, x + 268.0f, y + 1.0f), listId, z });
+                DragDropManager::RegisterDropZone(zones.back());
+            }
+        }
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> xs(0.0f, 20.0f + kLists * 292.0f);
+        std::uniform_real_distribution<float> ys(0.0f, 2000.0f);
+        std::vector<ImVec2> points;
+        for(int i = 0; i < kQueries; ++i)
+        {
+            points.push_back(ImVec2(xs(rng), ys(rng)));
+        }
+
+        int indexedHits = 0;
+        OpenGL::Timer timer;
+        for(const ImVec2& point : points)
+        {
+            indexedHits += DragDropManager::HitTestDropzones(point) != nullptr;
+        }
+        const float indexed = timer.ElapsedMillis();
+
+        int linearHits = 0;
+        timer.Reset();
+        for(const ImVec2& point : points)
+        {
+            linearHits += LinearHitTest(lists, zones, point) != nullptr;
+        }
+        const float linear = timer.ElapsedMillis();
+
+        ctx->LogInfo("%d hit tests over %d zones", kQueries, kLists * kZonesPerList);
+        ctx->LogInfo("Indexed: %.2f ms, linear: %.2f ms", indexed, linear);
+
+        // Same zone up to the scan's 10 px^2 tie margin
+        IM_CHECK_EQ(indexedHits, linearHits);
+        for(int i = 0; i < 500; ++i)
+        {
+            const Stride::Dropzone* expected = LinearHitTest(lists, zones, points[i]);
+            const Stride::Dropzone* found = DragDropManager::HitTestDropzones(points[i]);
+            IM_CHECK(expected != nullptr && found != nullptr);
+            IM_CHECK(found->list_id == expected->list_id);
+            IM_CHECK(
+                std::abs(SquaredDistance(*found, points[i]) - SquaredDistance(*expected, points[i]))
+                <= 10.0f
+            );
+        }
+        IM_CHECK_LT(indexed * 20.0f, linear);
+
+        Stride::FrameArena::Get().Reset();
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: moving a 40 card selection at once vs card by card
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "BatchMoveCards");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kCards = 20000;
+        constexpr int kSelected = 40;
+        auto build = [] {
+            Stride::BoardData board("Batch move");
+            board.AddList("Inbox");
+            board.AddList("Triaged");
+            for(int i = 0; i < kCards; ++i)
+            {
+                board.lists[i % 2].AddCard(Stride::Card("Card " + std::to_string(i)));
+            }
+            int lastRowId = 0;
+            MarkSaved(board, lastRowId);
+            return board;
+        };
+
+        // Every 250th card of the inbox, picked in reverse to check the board order is kept
+        Stride::BoardData batched = build();
+        Stride::CardSelection::Clear();
+        std::vector<Stride::CardId> expected;
+        for(int i = kSelected - 1; i >= 0; --i)
+        {
+            Stride::CardSelection::Toggle(batched.lists[0].cards[i * 250].id);
+        }
+        for(int i = 0; i < kSelected; ++i)
+        {
+            expected.push_back(batched.lists[0].cards[i * 250].id);
+        }
+        IM_CHECK(Stride::CardSelection::Count() == size_t(kSelected));
+
+        const Stride::ListId triaged = batched.lists[1].id;
+        OpenGL::Timer timer;
+        const size_t moved = batched.MoveCards(Stride::CardSelection::GetSelected(), triaged, 100);
+        const float batch = timer.ElapsedMillis();
+        Stride::CardSelection::Clear();
+
+        IM_CHECK(moved == size_t(kSelected));
+        const auto& target = batched.lists[1].cards;
+        IM_CHECK(batched.lists[0].cards.size() == size_t(kCards / 2 - kSelected));
+        IM_CHECK(target.size() == size_t(kCards / 2 + kSelected));
+        for(int i = 0; i < kSelected; ++i)
+        {
+            IM_CHECK(target[100 + i].id == expected[i]);
+            IM_CHECK(batched.FindCardWithList(expected[i]).first == &batched.lists[1]);
+        }
+
+        // Ranked into the gap between their neighbours, nothing else is rewritten
+        size_t dirty = 0;
+        for(size_t i = 0; i < target.size(); ++i)
+        {
+            if(i > 0)
+                IM_CHECK(target[i - 1].position < target[i].position);
+            dirty += target[i].changes.IsDirty();
+        }
+        IM_CHECK(dirty == size_t(kSelected));
+        IM_CHECK(!batched.lists[0].HasUnsavedChanges());
+
+        Stride::BoardData single = build();
+        std::vector<Stride::CardId> ids;
+        for(int i = 0; i < kSelected; ++i)
+        {
+            ids.push_back(single.lists[0].cards[i * 250].id);
+        }
+        timer.Reset();
+        for(int i = 0; i < kSelected; ++i)
+        {
+            single.MoveCard(ids[i], single.lists[1].id, 100 + i);
+        }
+        const float oneByOne = timer.ElapsedMillis();
+
+        ctx->LogInfo("%d of %d cards: batch %.2f ms, one by one %.2f ms", kSelected, kCards,
+                     batch, oneByOne);
+        IM_CHECK_LT(batch, oneByOne);
+    };
+
+    // -----------------------------------------------------------------
+    // Edge auto-scroll: time based, accelerating, still in the middle
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "EdgeAutoScroll");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        Stride::EdgeAutoScroll scroll;
+        IM_CHECK_EQ(scroll.Update(500.0f, 0.0f, 1000.0f, 1.0f / 60.0f), 0.0f);
+        IM_CHECK_LT(scroll.Update(5.0f, 0.0f, 1000.0f, 1.0f / 60.0f), 0.0f);
+        scroll.Reset();
+
+        // One second near the bottom edge covers about the same distance at any frame rate
+        float distances[3] = {};
+        const float rates[3] = { 30.0f, 60.0f, 144.0f };
+        for(int r = 0; r < 3; ++r)
+        {
+            scroll.Reset();
+            float first = 0.0f, last = 0.0f;
+            for(int frame = 0; frame < (int)rates[r]; ++frame)
+            {
+                last = scroll.Update(990.0f, 0.0f, 1000.0f, 1.0f / rates[r]);
+                if(frame == 0)
+                    first = last;
+                distances[r] += last;
+            }
+            IM_CHECK_LT(first, last); // Accelerates while held
+        }
+        ctx->LogInfo("1 s at the edge: %.1f / %.1f / %.1f px", distances[0], distances[1],
+                     distances[2]);
+        IM_CHECK_LT(std::abs(distances[0] - distances[2]), distances[1] * 0.05f);
+    };
+
+    // -----------------------------------------------------------------
+    // Tracked drop zone: same answer as a fresh hit test, mostly reused
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Board", "DropZoneTracking");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using Stride::DragDropManager;
+        constexpr int kFrames = 20000;
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> step(-6.0f, 6.0f);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        float scrollY = 0.0f;
+        ImVec2 mouse(300.0f, 400.0f);
+        int mismatches = 0;
+        for(int frame = 0; frame < kFrames; ++frame)
+        {
+            // Zones are registered again every frame; now and then the lists scroll
+            Stride::FrameArena::Get().Reset();
+            if(chance(rng) < 0.02f)
+                scrollY += step(rng) * 3.0f;
+            for(int l = 0; l < 6; ++l)
+            {
+                const Stride::ListId listId = Stride::ListId::FromRow(l + 1);
+                const float x = 20.0f + l * 292.0f;
+                DragDropManager::RegisterListBounds(listId, ImRect(x, 0.0f, x + 280.0f, 1000.0f));
+                float y = 60.0f - scrollY;
+                for(int z = 0; z < 60; ++z)
+                {
+                    if(y > -200.0f && y < 1200.0f)
+                    {
+                        DragDropManager::RegisterDropZone(
+                            { ImRect(x + 4.0f, y, x + 276.0f, y + 1.0f), listId, z }
+                        );
+                    }
+                    y += 20.0f + (z * 37 % 50);
+                }
+            }
+
+            mouse.x = std::fmod(std::abs(mouse.x + step(rng)), 1800.0f);
+            mouse.y = std::fmod(std::abs(mouse.y + step(rng)), 1000.0f);
+            const Stride::Dropzone* tracked = DragDropManager::TrackDropzone(mouse);
+            const Stride::Dropzone* fresh = DragDropManager::HitTestDropzones(mouse);
+            mismatches += tracked != fresh;
+        }
+
+        ctx->LogInfo("%d frames, %d mismatches", kFrames, mismatches);
+        IM_CHECK_EQ(mismatches, 0);
+        Stride::FrameArena::Get().Reset();
+    };
+
+    t = IM_REGISTER_TEST(engine, "Board", "UndoJournal");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        constexpr int kCards = 20000;
+        constexpr int kMoved = 500;
+        Stride::BoardData board("Undo");
+        for(int l = 0; l < 4; ++l)
+        {
+            board.AddList("List " + std::to_string(l));
+        }
+        for(int i = 0; i < kCards; ++i)
+        {
+            board.lists[i % 4].AddCard(Stride::Card("Card " + std::to_string(i)));
+        }
+        int lastRowId = 0;
+        MarkSaved(board, lastRowId);
+
+        auto layout = [&board] {
+            std::vector<std::pair<Stride::ListId, Stride::CardId>> order;
+            for(const auto& list : board.lists)
+            {
+                for(const auto& card : list.cards)
+                {
+                    order.emplace_back(list.id, card.id);
+                }
+            }
+            return order;
+        };
+
+        // A journal of its own: nothing here reaches the database
+        Stride::UndoJournal journal;
+        std::vector<Stride::CardId> ids;
+        for(int i = 0; i < kMoved; ++i)
+        {
+            ids.push_back(board.lists[i % 3].cards[i * 10].id);
+        }
+        const auto original = layout();
+        auto before = board.CapturePlacements(ids);
+        board.MoveCards(ids, board.lists[3].id, 42);
+        journal.Record(board, Stride::PlaceCardsCommand{ before, board.CapturePlacements(ids) });
+        const auto moved = layout();
+        IM_CHECK(journal.UndoCount(board.id) == 1);
+
+        OpenGL::Timer timer;
+        IM_CHECK(journal.Undo(board));
+        const float undo = timer.ElapsedMillis();
+        IM_CHECK(layout() == original);
+        IM_CHECK(board.FindCardWithList(ids[1]).first == &board.lists[1]);
+        IM_CHECK(journal.RedoCount(board.id) == 1);
+
+        IM_CHECK(journal.Redo(board));
+        IM_CHECK(layout() == moved);
+        IM_CHECK(!journal.Redo(board));
+        ctx->LogInfo("Undo of a %d card move: %.3f ms", kMoved, undo);
+        IM_CHECK_LT(undo, 16.0f); // Within one frame at 60 Hz
+
+        // A burst of typing is one step, and a rename back to the start is none
+        Stride::CardList& list = board.lists[0];
+        const std::string title = list.title;
+        for(const char* text : { "T", "To", "Todo" })
+        {
+            journal.Record(board, Stride::RenameListCommand{ list.id, list.title, text });
+            list.title = text;
+        }
+        IM_CHECK(journal.UndoCount(board.id) == 2);
+        IM_CHECK(journal.Undo(board));
+        IM_CHECK(list.title == title);
+        IM_CHECK(journal.Redo(board));
+        journal.Record(board, Stride::RenameListCommand{ list.id, list.title, title });
+        list.title = title;
+        IM_CHECK(journal.UndoCount(board.id) == 1);
+
+        // Removing a card and ticking an item undo to the same slot and state
+        Stride::Card& card = board.lists[2].cards[7];
+        card.AddChecklistItem("Review");
+        const Stride::CardId cardId = card.id;
+        const Stride::ChecklistItemId itemId = card.checklist[0].id;
+        card.ToggleChecklistItem(itemId);
+        journal.Record(board, Stride::ToggleChecklistItemCommand{ cardId, itemId });
+        const uint32_t beforeUndo = board.lists[2].LayoutVersion();
+        IM_CHECK(journal.Undo(board));
+        IM_CHECK(!board.FindCard(cardId)->checklist[0].isChecked);
+        IM_CHECK(board.lists[2].LayoutVersion() != beforeUndo); // Card slots are re-measured
+
+        const Stride::Card removed = *board.FindCard(cardId);
+        journal.Record(board, Stride::RemoveCardCommand{ board.lists[2].id, removed });
+        board.lists[2].RemoveCard(cardId);
+        IM_CHECK(board.FindCard(cardId) == nullptr);
+        IM_CHECK(journal.Undo(board));
+        IM_CHECK(board.lists[2].cards[7].id == cardId);
+        IM_CHECK(board.lists[2].removedCardIds.empty());
+        IM_CHECK(journal.Redo(board));
+        IM_CHECK(board.FindCard(cardId) == nullptr);
+
+        // A move that names a card no longer on the board is dropped without touching the rest
+        const Stride::CardId kept = board.lists[0].cards[0].id;
+        const Stride::ListId target = board.lists[1].id;
+        journal.Record(
+            board,
+            Stride::PlaceCardsCommand{ { { kept, target, 0.0 }, { cardId, target, 0.0 } },
+                                       board.CapturePlacements({ kept }) }
+        );
+        const auto beforeStale = layout();
+        IM_CHECK(!journal.Undo(board));
+        IM_CHECK(layout() == beforeStale);
+
+        // Past the memory limit the oldest steps go first
+        const size_t steps = journal.UndoCount(board.id);
+        journal.SetMemoryLimit(journal.HeapBytes() - 1);
+        IM_CHECK(journal.UndoCount(board.id) < steps);
+        IM_CHECK(journal.UndoCount(board.id) > 0);
+        IM_CHECK(journal.HeapBytes() <= journal.MemoryLimit());
+    };
+}
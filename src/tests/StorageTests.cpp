@@ -0,0 +1,644 @@
+#include "pch.h"
+#include "imgui.h"
+#include "imgui_test_engine/imgui_te_engine.h"
+#include "imgui_test_engine/imgui_te_context.h"
+#include "storage/Storage.h"
+#include "storage/BoardQueries.h"
+#include "storage/ChangeLog.h"
+#include "storage/ConnectionProfile.h"
+#include "storage/PersistenceWorker.h"
+#include "storage/ReadConnection.h"
+#include "storage/SearchIndex.h"
+#include "storage/StorageManager.h"
+#include "utilities/WorkerThread.h"
+#include "PathManager.h"
+#include "Timer.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <future>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Scratch database built from the production schema so the user's data is never touched
+    std::filesystem::path BenchmarkDatabasePath(const char* name)
+    {
+        return Stride::PathManager::Get().GetTempDir() / name;
+    }
+
+    void RemoveDatabase(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        std::filesystem::remove(path.generic_u8string() + "-journal", ec);
+        std::filesystem::remove(path.generic_u8string() + "-wal", ec);
+        std::filesystem::remove(path.generic_u8string() + "-shm", ec);
+    }
+
+    // Average wall time of one call, in milliseconds
+    template<typename Fn>
+    float AverageMillis(int iterations, Fn&& fn)
+    {
+        OpenGL::Timer timer;
+        for(int i = 0; i < iterations; ++i)
+        {
+            fn(i);
+        }
+        return timer.ElapsedMillis() / static_cast<float>(iterations);
+    }
+
+    // Synthetic words drawn with Zipf frequencies, so a few are in most cards and most are rare
+    class BenchmarkText
+    {
+      public:
+        static constexpr int kVocabularySize = 4000;
+
+        BenchmarkText() : mRng(42)
+        {
+            static const char* kSyllables[]
+                = { "ka", "lo", "mi", "ne", "ru", "sa", "te", "vo", "xi", "za", "bo", "de" };
+            std::vector<double> weights;
+            for(int rank = 0; rank < kVocabularySize; ++rank)
+            {
+                std::string word;
+                // Offset so every word has at least three syllables
+                for(int n = rank + 12 * 12; n > 0; n /= 12)
+                {
+                    word += kSyllables[n % 12];
+                }
+                mVocabulary.push_back(word);
+                weights.push_back(1.0 / std::pow(rank + 1, 1.07));
+            }
+            mZipf = std::discrete_distribution<int>(weights.begin(), weights.end());
+        }
+
+        // The word with the given frequency rank (0 is the most common)
+        const std::string& Word(int rank) const { return mVocabulary[rank]; }
+
+        std::string Words(int count)
+        {
+            std::string text;
+            for(int i = 0; i < count; ++i)
+            {
+                if(i > 0)
+                    text += ' ';
+                text += mVocabulary[mZipf(mRng)];
+            }
+            return text;
+        }
+
+      private:
+        std::mt19937 mRng;
+        std::discrete_distribution<int> mZipf;
+        std::vector<std::string> mVocabulary;
+    };
+
+    // Every 5th card carries a badge, three checklist items and a comment; every 10th is archived
+    template<typename StorageT>
+    void SeedBenchmarkDatabase(StorageT& storage, int boards, int listsPerBoard, int cardsPerList)
+    {
+        using namespace Storage;
+        constexpr int kBadgesPerBoard = 8;
+        BenchmarkText text;
+
+        int cardId = 0;
+        int itemId = 0;
+        int commentId = 0;
+        for(int b = 1; b <= boards; ++b)
+        {
+            storage.replace(BoardData{ b, "Board " + std::to_string(b), "", "", 0, 0 });
+            for(int badge = 0; badge < kBadgesPerBoard; ++badge)
+            {
+                int badgeId = (b - 1) * kBadgesPerBoard + badge + 1;
+                storage.replace(BadgeData{ badgeId, b, "Badge " + std::to_string(badge), "" });
+            }
+
+            for(int l = 0; l < listsPerBoard; ++l)
+            {
+                int listId = (b - 1) * listsPerBoard + l + 1;
+                storage.replace(ListData{ listId, b, "List", static_cast<double>(l), 0, 0 });
+
+                for(int pos = 0; pos < cardsPerList; ++pos)
+                {
+                    ++cardId;
+                    bool archived = pos % 10 == 0;
+                    double rank = static_cast<double>(pos);
+                    std::string title = "Card " + std::to_string(cardId) + " " + text.Words(3);
+                    std::string body = text.Words(12);
+                    storage.replace(CardData{
+                        cardId, listId, b, title, body, rank, 0, 0, 0, false, "", "", archived });
+                    if(pos % 5 != 0)
+                        continue;
+
+                    int badgeId = (b - 1) * kBadgesPerBoard + (pos % kBadgesPerBoard) + 1;
+                    storage.replace(CardBadgeData{ cardId, badgeId });
+                    for(int item = 0; item < 3; ++item)
+                    {
+                        storage.replace(
+                            ChecklistItemData{ ++itemId, cardId, text.Words(3), item, false }
+                        );
+                    }
+                    storage.replace(CommentData{ ++commentId, cardId, "me", text.Words(8), pos });
+                }
+            }
+        }
+    }
+}
+
+void RegisterStorageTests(ImGuiTestEngine* engine)
+{
+    // -----------------------------------------------------------------
+    // Benchmark: hot lookups stay sub-millisecond at 100k cards
+    // -----------------------------------------------------------------
+    ImGuiTest* t = IM_REGISTER_TEST(engine, "Storage", "IndexedQueries100k");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace sqlite_orm;
+        using namespace Storage;
+
+        constexpr int kBoards = 10;
+        constexpr int kListsPerBoard = 50;
+        constexpr int kCardsPerList = 200; // 100k cards in total
+        constexpr int kIterations = 200;
+
+        const auto dbPath = BenchmarkDatabasePath("index_benchmark.db");
+        RemoveDatabase(dbPath);
+
+        float listsInBoard = 0.0f, cardsInList = 0.0f, checklistForCard = 0.0f;
+        float commentsForCard = 0.0f, cardsWithBadge = 0.0f;
+
+        // Scoped so the connection is closed before the file is removed
+        {
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.open_forever();
+            storage.sync_schema();
+
+            OpenGL::Timer seedTimer;
+            storage.transaction([&] {
+                SeedBenchmarkDatabase(storage, kBoards, kListsPerBoard, kCardsPerList);
+                return true;
+            });
+            IM_CHECK_EQ(storage.count<CardData>(), kBoards * kListsPerBoard * kCardsPerList);
+            ctx->LogInfo("Seeded 100k cards in %.1f ms", seedTimer.ElapsedMillis());
+
+            const int totalLists = kBoards * kListsPerBoard;
+            const int totalCards = totalLists * kCardsPerList;
+
+            listsInBoard = AverageMillis(kIterations, [&](int i) {
+                storage.get_all<ListData>(
+                    where(c(&ListData::board_id) == (i % kBoards) + 1),
+                    order_by(&ListData::position)
+                );
+            });
+            cardsInList = AverageMillis(kIterations, [&](int i) {
+                storage.get_all<CardData>(
+                    where(
+                        c(&CardData::list_id) == (i % totalLists) + 1
+                        && c(&CardData::archived) == false
+                    ),
+                    order_by(&CardData::position)
+                );
+            });
+            checklistForCard = AverageMillis(kIterations, [&](int i) {
+                storage.get_all<ChecklistItemData>(
+                    where(c(&ChecklistItemData::card_id) == ((i * 5) % totalCards) + 1),
+                    order_by(&ChecklistItemData::position)
+                );
+            });
+            commentsForCard = AverageMillis(kIterations, [&](int i) {
+                storage.get_all<CommentData>(
+                    where(c(&CommentData::card_id) == ((i * 5) % totalCards) + 1),
+                    order_by(&CommentData::created_at)
+                );
+            });
+            cardsWithBadge = AverageMillis(kIterations, [&](int i) {
+                storage.get_all<CardBadgeData>(
+                    where(c(&CardBadgeData::badge_id) == (i % (kBoards * 8)) + 1)
+                );
+            });
+        }
+
+        ctx->LogInfo("GetListsInBoard:          %.4f ms", listsInBoard);
+        ctx->LogInfo("GetCardsInList:           %.4f ms", cardsInList);
+        ctx->LogInfo("GetChecklistItemsForCard: %.4f ms", checklistForCard);
+        ctx->LogInfo("GetCommentsForCard:       %.4f ms", commentsForCard);
+        ctx->LogInfo("card_badges by badge_id:  %.4f ms", cardsWithBadge);
+
+        IM_CHECK_LT(listsInBoard, 1.0f);
+        IM_CHECK_LT(cardsInList, 1.0f);
+        IM_CHECK_LT(checklistForCard, 1.0f);
+        IM_CHECK_LT(commentsForCard, 1.0f);
+        IM_CHECK_LT(cardsWithBadge, 1.0f);
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: full-text search stays interactive at 100k cards
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "FullTextSearch100k");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace Storage;
+
+        constexpr int kBoards = 10;
+        constexpr int kListsPerBoard = 50;
+        constexpr int kCardsPerList = 200; // 100k cards in total
+        constexpr int kCardsPerBoard = kListsPerBoard * kCardsPerList;
+
+        const auto dbPath = BenchmarkDatabasePath("search_benchmark.db");
+        RemoveDatabase(dbPath);
+
+        // Scoped so the connection is closed before the file is removed
+        {
+            sqlite3* db = nullptr;
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.on_open = [&db](sqlite3* handle) { db = handle; };
+            storage.open_forever();
+            storage.sync_schema();
+            EnsureSearchIndex(db);
+
+            // The triggers index every row as it is inserted
+            OpenGL::Timer seedTimer;
+            storage.transaction([&] {
+                SeedBenchmarkDatabase(storage, kBoards, kListsPerBoard, kCardsPerList);
+                return true;
+            });
+            ctx->LogInfo("Seeded and indexed 100k cards in %.1f ms", seedTimer.ElapsedMillis());
+
+            // Card 1234 is in board 1 and is the only one with that number in its title
+            auto hits = SearchBoard(db, 1, "1234");
+            IM_CHECK_EQ(int(hits.size()), 1);
+            IM_CHECK(hits[0].kind == SearchHitKind::Card);
+            IM_CHECK_EQ(hits[0].card_id, 1234);
+            IM_CHECK_EQ(int(hits[0].title.highlights.size()), 1);
+            IM_CHECK_EQ(hits[0].title.highlights[0].begin, 5);
+            IM_CHECK_EQ(hits[0].title.highlights[0].end, 9);
+            // Trailing space: a whole word, so board 2's cards 12340-12349 do not match either
+            IM_CHECK(SearchBoard(db, 2, "1234 ").empty());
+
+            // Edits and cascading deletes reach the index through the triggers
+            auto card = storage.get<CardData>(1234);
+            card.title = "Quarterly zyxwv review";
+            storage.update(card);
+            IM_CHECK_EQ(int(SearchBoard(db, 1, "zyxw").size()), 1);
+            IM_CHECK(SearchBoard(db, 1, "1234").empty());
+            storage.remove<CardData>(1234);
+            IM_CHECK(SearchBoard(db, 1, "zyxwv").empty());
+
+            // Archived cards (every 10th) are never returned
+            IM_CHECK(SearchBoard(db, 1, "1231 ").empty());
+
+            // From near-stopwords to rare words, typed whole, as a prefix and with a second term
+            BenchmarkText text;
+            std::vector<std::string> queries;
+            for(int rank : { 0, 5, 20, 100, 500 })
+            {
+                queries.push_back(text.Word(rank));
+                queries.push_back(text.Word(rank).substr(0, 3));
+                queries.push_back(text.Word(rank) + " " + text.Word(rank + 1).substr(0, 4));
+            }
+
+            float slowest = 0.0f;
+            for(const auto& query : queries)
+            {
+                size_t found = 0;
+                float millis = AverageMillis(kBoards, [&](int i) {
+                    found += SearchBoard(db, i + 1, query).size();
+                });
+                ctx->LogInfo("\"%s\": %.3f ms, %d hits", query.c_str(), millis, int(found));
+                slowest = std::max(slowest, millis);
+            }
+            ctx->LogInfo("Slowest query over %d cards per board: %.3f ms", kCardsPerBoard, slowest);
+
+            IM_CHECK_LT(slowest, 5.0f);
+        }
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: startup summaries vs hydrating every board at 100k cards
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "BoardSummaries100k");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace sqlite_orm;
+        using namespace Storage;
+
+        constexpr int kBoards = 10;
+        constexpr int kListsPerBoard = 50;
+        constexpr int kCardsPerList = 200; // 100k cards in total
+
+        const auto dbPath = BenchmarkDatabasePath("summary_benchmark.db");
+        RemoveDatabase(dbPath);
+
+        float summaries = 0.0f, hydration = 0.0f;
+
+        // Scoped so the connection is closed before the file is removed
+        {
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.open_forever();
+            storage.sync_schema();
+            storage.transaction([&] {
+                SeedBenchmarkDatabase(storage, kBoards, kListsPerBoard, kCardsPerList);
+                return true;
+            });
+
+            // Every 10th card is archived and left out of the count
+            std::vector<BoardSummary> loaded;
+            summaries = AverageMillis(5, [&](int) { loaded = LoadBoardSummaries(storage); });
+            IM_CHECK_EQ(int(loaded.size()), kBoards);
+            for(const auto& summary : loaded)
+            {
+                IM_CHECK_EQ(summary.list_count, kListsPerBoard);
+                IM_CHECK_EQ(summary.card_count, kListsPerBoard * kCardsPerList * 9 / 10);
+            }
+
+            // What startup read before: every list and card row of every board
+            size_t rows = 0;
+            hydration = AverageMillis(1, [&](int) {
+                for(int b = 1; b <= kBoards; ++b)
+                {
+                    rows += storage.get_all<ListData>(where(c(&ListData::board_id) == b)).size();
+                    rows += storage
+                                .get_all<CardData>(where(
+                                    c(&CardData::board_id) == b && c(&CardData::archived) == false
+                                ))
+                                .size();
+                }
+            });
+            ctx->LogInfo("Rows read by a full load: %d", int(rows));
+        }
+
+        ctx->LogInfo("Board summaries:   %.2f ms", summaries);
+        ctx->LogInfo("Full list + cards: %.2f ms", hydration);
+
+        IM_CHECK_LT(summaries, 50.0f);
+        IM_CHECK_LT(summaries * 5.0f, hydration);
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // Benchmark: hydrating 200 boards on one connection vs one per pool thread
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "ParallelBoardLoad200");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace Storage;
+
+        constexpr int kBoards = 200;
+        constexpr int kListsPerBoard = 10;
+        constexpr int kCardsPerList = 50; // 100k cards in total
+
+        const auto dbPath = BenchmarkDatabasePath("parallel_load_benchmark.db");
+        RemoveDatabase(dbPath);
+
+        const int workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        float sequential = 0.0f, parallel = 0.0f;
+        size_t sequentialCards = 0, parallelCards = 0;
+
+        // Scoped so every connection is closed before the file is removed
+        {
+            // Seeded through a WAL connection, like the application's writer
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.on_open = [](sqlite3* db) { ConnectionProfile{}.Apply(db); };
+            storage.open_forever();
+            storage.sync_schema();
+            storage.transaction([&] {
+                SeedBenchmarkDatabase(storage, kBoards, kListsPerBoard, kCardsPerList);
+                return true;
+            });
+
+            // What the persistence worker alone can do: one board after another
+            sequential = AverageMillis(1, [&](int) {
+                ReadConnection reader(dbPath.generic_u8string());
+                for(int b = 1; b <= kBoards; ++b)
+                {
+                    sequentialCards += reader.LoadBoardBundle(b).cards.size();
+                }
+            });
+
+            // Boards striped over the pool, each task reading through its own connection
+            parallel = AverageMillis(1, [&](int) {
+                std::vector<std::future<size_t>> loads;
+                for(int w = 0; w < workers; ++w)
+                {
+                    loads.push_back(WorkerThread::Enqueue([&dbPath, w, workers] {
+                        ReadConnection reader(dbPath.generic_u8string());
+                        size_t cards = 0;
+                        for(int b = 1 + w; b <= kBoards; b += workers)
+                        {
+                            cards += reader.LoadBoardBundle(b).cards.size();
+                        }
+                        return cards;
+                    }));
+                }
+                for(auto& load : loads)
+                {
+                    parallelCards += load.get();
+                }
+            });
+        }
+
+        ctx->LogInfo("Cards loaded: %d", int(parallelCards));
+        ctx->LogInfo("Sequential load: %.2f ms", sequential);
+        ctx->LogInfo("Parallel load (%d threads): %.2f ms", workers, parallel);
+        ctx->LogInfo("Speedup: %.2fx", parallel > 0.0f ? sequential / parallel : 0.0f);
+
+        // Every 10th card is archived and left out of a load
+        IM_CHECK(sequentialCards == size_t(kBoards * kListsPerBoard * kCardsPerList * 9 / 10));
+        IM_CHECK(parallelCards == sequentialCards);
+
+        // A single core can only interleave the readers, so there is no speedup to expect
+        if(std::thread::hardware_concurrency() > 1)
+            IM_CHECK_LT(parallel, sequential);
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // Change log: every write appends a row, compaction keeps it bounded
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "ChangeLog100k");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace sqlite_orm;
+        using namespace Storage;
+
+        const auto dbPath = BenchmarkDatabasePath("change_log_benchmark.db");
+        RemoveDatabase(dbPath);
+
+        // Scoped so the connection is closed before the file is removed
+        {
+            sqlite3* db = nullptr;
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.on_open = [&db](sqlite3* handle) { db = handle; };
+            storage.open_forever();
+            storage.sync_schema();
+            EnsureChangeLog(db);
+
+            OpenGL::Timer seedTimer;
+            storage.transaction([&] {
+                SeedBenchmarkDatabase(storage, 10, 50, 200);
+                return true;
+            });
+            ctx->LogInfo("Seeded and logged 100k cards in %.1f ms", seedTimer.ElapsedMillis());
+
+            // One row per inserted row; a badge link is logged as an update of its card
+            const int64_t inserted = storage.count<BoardData>() + storage.count<BadgeData>()
+                                   + storage.count<ListData>() + storage.count<CardData>()
+                                   + storage.count<CardBadgeData>()
+                                   + storage.count<ChecklistItemData>()
+                                   + storage.count<CommentData>();
+            IM_CHECK(LatestChangeSeq(db) == inserted);
+
+            // A save that only bumps updated_at is not a change
+            const int64_t cursor = LatestChangeSeq(db);
+            auto card = storage.get<CardData>(1234);
+            card.updated_at = 42;
+            storage.update(card);
+            IM_CHECK(LatestChangeSeq(db) == cursor);
+
+            card.title = "Renamed";
+            storage.update(card);
+            storage.remove<BoardData>(2);
+
+            // Deleting a board is one row, its lists and cards are implied
+            auto delta = storage.get_all<ChangeData>(where(c(&ChangeData::seq) > cursor));
+            IM_CHECK_EQ(int(delta.size()), 2);
+            IM_CHECK_EQ(delta[0].entity, int(ChangeEntity::Card));
+            IM_CHECK_EQ(delta[0].entity_id, 1234);
+            IM_CHECK_EQ(delta[0].board_id, 1);
+            IM_CHECK_EQ(delta[0].fields, ChangeField::Title);
+            IM_CHECK_EQ(delta[1].entity, int(ChangeEntity::Board));
+            IM_CHECK_EQ(delta[1].op, int(ChangeOp::Delete));
+
+            const auto distinctEntities = [&] {
+                return storage
+                    .select(
+                        columns(&ChangeData::entity, &ChangeData::entity_id),
+                        group_by(&ChangeData::entity, &ChangeData::entity_id)
+                    )
+                    .size();
+            };
+            const auto entitiesBefore = distinctEntities();
+
+            OpenGL::Timer compactTimer;
+            const int64_t now = static_cast<int64_t>(time(nullptr));
+            IM_CHECK(CompactChangeLog(db, now));
+            const float compact = compactTimer.ElapsedMillis();
+            const int rows = storage.count<ChangeData>();
+            ctx->LogInfo("Compacted %d changes to %d in %.1f ms", int(inserted + 2), rows, compact);
+
+            // Every entity keeps a row, and seq carries on where it was
+            IM_CHECK(distinctEntities() == entitiesBefore);
+            IM_CHECK(rows <= kRetainedChanges + int64_t(entitiesBefore));
+            IM_CHECK(LastCompactedSeq(db) == inserted + 2 - kRetainedChanges);
+            IM_CHECK(!CompactChangeLog(db, now));
+            storage.remove<CardData>(1);
+            IM_CHECK(LatestChangeSeq(db) == inserted + 3);
+        }
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // Resubmitting a key keeps its place: a parent renamed after a child was queued into it
+    // is still written first
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "ResubmitKeepsOrder");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        using namespace Storage;
+
+        const auto dbPath = BenchmarkDatabasePath("resubmit_order.db");
+        RemoveDatabase(dbPath);
+
+        // Scoped so the connection is closed before the file is removed
+        {
+            auto storage = SetupStorageDatabaseModels(dbPath.generic_u8string());
+            storage.on_open = [](sqlite3* db) { ConnectionProfile{}.Apply(db); };
+            storage.open_forever();
+            storage.sync_schema();
+            storage.replace(BoardData{ 1, "Board", "", "", 0, 0 });
+
+            // Keys of their own so nothing the application has pending is superseded; the
+            // commands run against this scratch file, the test waits for them below
+            ListData list{ 1, 1, "New list", 0.0, 0, 0 };
+            PersistenceWorker::Submit("test:list:1", [&storage, list] { storage.replace(list); });
+            CardData card{ 1, 1, 1, "Card", "", 0.0, 0, 0, 0, false, "", "", false };
+            PersistenceWorker::Submit("test:card:1", [&storage, card] { storage.replace(card); });
+            list.name = "Renamed";
+            PersistenceWorker::Submit("test:list:1", [&storage, list] { storage.replace(list); });
+            PersistenceWorker::Flush();
+
+            IM_CHECK_EQ(storage.count<ListData>(), 1);
+            IM_CHECK_EQ(storage.count<CardData>(), 1);
+            IM_CHECK(storage.get<ListData>(1).name == "Renamed");
+            ctx->LogInfo("List and card written in submission order");
+        }
+
+        RemoveDatabase(dbPath);
+    };
+
+    // -----------------------------------------------------------------
+    // A batch rejected at COMMIT (deferred foreign keys) is rolled back, so the next one can
+    // still begin. Runs on the application database; the rejected row never lands in it.
+    // -----------------------------------------------------------------
+    t = IM_REGISTER_TEST(engine, "Storage", "FailedCommitRollsBack");
+    t->TestFunc = [](ImGuiTestContext* ctx) {
+        struct Outcome
+        {
+            bool rejected = false;
+            bool cardStored = false;
+            bool nextCommitted = false;
+        };
+
+        // The worker owns the application connection
+        const Outcome outcome = PersistenceWorker::Run([] {
+            Outcome result;
+            const int cardId = StorageManager::ReserveId<Storage::CardData>();
+
+            // Reserved IDs that are never written: list_id and board_id dangle
+            const int listId = StorageManager::ReserveId<Storage::ListData>();
+            const int boardId = StorageManager::ReserveId<Storage::BoardData>();
+            try
+            {
+                StorageManager::Batch batch;
+                StorageManager::UpsertCard(
+                    { cardId, listId, boardId, "Orphan", "", 0.0, 0, 0, 0, false, "", "", false }
+                );
+                batch.Commit();
+            }
+            catch(const std::exception&)
+            {
+                result.rejected = true;
+            }
+
+            try
+            {
+                StorageManager::GetCard(cardId);
+                result.cardStored = true;
+            }
+            catch(const std::exception&)
+            {}
+
+            try
+            {
+                StorageManager::Batch next;
+                next.Commit();
+                result.nextCommitted = !StorageManager::InTransaction();
+            }
+            catch(const std::exception&)
+            {}
+            return result;
+        });
+
+        IM_CHECK(outcome.rejected);
+        IM_CHECK(!outcome.cardStored);
+        IM_CHECK(outcome.nextCommitted);
+        ctx->LogInfo("Rejected batch rolled back, next batch committed");
+    };
+}
@@ -3,8 +3,10 @@
 
 // Forward declarations
 void RegisterBoardTests(ImGuiTestEngine* engine);
+void RegisterStorageTests(ImGuiTestEngine* engine);
 
 void RegisterTests(ImGuiTestEngine* engine)
 {
     RegisterBoardTests(engine);
+    RegisterStorageTests(engine);
 }
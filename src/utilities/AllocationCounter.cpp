@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "AllocationCounter.h"
+#include "imgui.h"
+#include "Log.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local uint64_t tAllocations = 0;
+}
+
+#ifdef STRIDE_COUNT_ALLOCATIONS
+void* operator new(std::size_t size)
+{
+    ++tAllocations;
+    if(size == 0)
+        size = 1;
+
+    while(true)
+    {
+        if(void* ptr = std::malloc(size))
+            return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+        if(!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+namespace Stride
+{
+    uint64_t AllocationCounter::sLastFrame = 0;
+    int AllocationCounter::sIdleAllocatingFrames = 0;
+
+    uint64_t AllocationCounter::ThreadTotal() { return tAllocations; }
+
+    void AllocationCounter::RecordFrame(uint64_t allocations)
+    {
+        sLastFrame = allocations;
+
+        const ImGuiIO& io = ImGui::GetIO();
+        const bool idle = io.MouseDelta.x == 0.0f && io.MouseDelta.y == 0.0f
+                          && io.MouseWheel == 0.0f && io.MouseWheelH == 0.0f
+                          && io.InputQueueCharacters.empty() && !ImGui::IsAnyMouseDown()
+                          && !ImGui::IsAnyItemActive() && !ImGui::GetDragDropPayload();
+
+        if(!idle || allocations == 0)
+        {
+            sIdleAllocatingFrames = 0;
+            return;
+        }
+
+        // Warn once per run of allocating idle frames, not on every one of them
+        if(++sIdleAllocatingFrames == kWarmupFrames)
+        {
+            GL_WARN(
+                "Board view allocated on {} idle frames in a row ({} allocations last frame)",
+                kWarmupFrames,
+                allocations
+            );
+        }
+    }
+}
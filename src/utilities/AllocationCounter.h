@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+namespace Stride
+{
+    /**
+     * @brief Counts heap allocations per thread, to keep the render loop allocation free.
+     *
+     * In Debug builds (STRIDE_COUNT_ALLOCATIONS) AllocationCounter.cpp replaces the global
+     * operator new with one that bumps a thread_local counter, so only the calling thread's
+     * allocations are seen. The array and nothrow forms forward to it; aligned allocations are
+     * not counted. Allocations made through ImGui's own allocator are not operator new calls and
+     * are not counted either.
+     *
+     * The application records what the board view allocates every frame. Frames without input
+     * should allocate nothing once caches are warm, so a run of such frames that does allocate
+     * is logged as a warning.
+     *
+     * Usage:
+     * @code
+     * AllocationCounter::Scope allocations;
+     * BoardManager::Get().Render();
+     * AllocationCounter::RecordFrame(allocations.Count());
+     * @endcode
+     *
+     * @note Release keeps the default operator new, so every count is 0 there.
+     */
+    class AllocationCounter
+    {
+      public:
+#ifdef STRIDE_COUNT_ALLOCATIONS
+        static constexpr bool kEnabled = true;
+#else
+        static constexpr bool kEnabled = false;
+#endif
+        // Idle frames in a row that may allocate (loads merging, caches filling) before warning
+        static constexpr int kWarmupFrames = 3;
+
+        // Allocations made by the calling thread since it started
+        static uint64_t ThreadTotal();
+
+        // Allocations made by the calling thread during the scope's lifetime
+        class Scope
+        {
+          public:
+            Scope() : mStart(ThreadTotal()) {}
+            uint64_t Count() const { return ThreadTotal() - mStart; }
+
+          private:
+            uint64_t mStart;
+        };
+
+        // Called once per frame with what the board view allocated; warns on idle frames
+        static void RecordFrame(uint64_t allocations);
+        static uint64_t LastFrame() { return sLastFrame; }
+
+      private:
+        static uint64_t sLastFrame;
+        static int sIdleAllocatingFrames;
+    };
+}
@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "EdgeAutoScroll.h"
+#include <algorithm>
+
+namespace Stride
+{
+    float EdgeAutoScroll::Update(
+        float cursor,
+        float min,
+        float max,
+        float deltaTime,
+        float dpiScale
+    )
+    {
+        // Regions smaller than both bands together would scroll both ways at once
+        const float edge = std::min(kEdgeSize * dpiScale, (max - min) * 0.25f);
+        if(edge <= 0.0f || deltaTime <= 0.0f)
+        {
+            Reset();
+            return 0.0f;
+        }
+
+        // Depth into the band: 0 at its inner border, 1 at (or beyond) the region's edge
+        float direction = 0.0f;
+        float depth = 0.0f;
+        if(cursor < min + edge)
+        {
+            direction = -1.0f;
+            depth = (min + edge - cursor) / edge;
+        }
+        else if(cursor > max - edge)
+        {
+            direction = 1.0f;
+            depth = (cursor - (max - edge)) / edge;
+        }
+
+        if(direction == 0.0f)
+        {
+            Reset();
+            return 0.0f;
+        }
+
+        holdTime += deltaTime;
+        depth = std::min(depth, 1.0f);
+        const float boost = std::min(1.0f + holdTime * kAcceleration, kMaxBoost);
+        const float speed = kBaseSpeed * dpiScale * (0.25f + 0.75f * depth) * boost;
+        return direction * speed * deltaTime;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Stride
+{
+    /**
+     * @brief Time-based scrolling while a drag hovers near the edge of a scroll region.
+     *
+     * Each frame the caller passes the cursor position along one axis and the visible extent of
+     * the region on that axis; Update() returns how far to scroll this frame. The speed grows
+     * with how deep the cursor sits inside the edge band and with how long it has stayed
+     * there, and is scaled by the frame time so it does not depend on the frame rate.
+     *
+     * Usage:
+     * @code
+     * float delta = uiState.autoScroll.Update(mouse.y, top, bottom, io.DeltaTime, dpiScale);
+     * if(delta != 0.0f)
+     *     ImGui::SetScrollY(ImGui::GetScrollY() + delta);
+     * @endcode
+     */
+    struct EdgeAutoScroll
+    {
+        // Width of the band along each edge that scrolls, in unscaled pixels
+        static constexpr float kEdgeSize = 48.0f;
+        // Speed at the outer edge of the band when the cursor just arrived, pixels per second
+        static constexpr float kBaseSpeed = 500.0f;
+        // Extra speed per second spent in the band, as a multiple of the base speed
+        static constexpr float kAcceleration = 1.5f;
+        static constexpr float kMaxBoost = 4.0f;
+
+        float holdTime = 0.0f; // Seconds the cursor has been inside an edge band
+
+        // Scroll delta for this frame: negative towards `min`, positive towards `max`
+        float Update(float cursor, float min, float max, float deltaTime, float dpiScale = 1.0f);
+        void Reset() { holdTime = 0.0f; }
+    };
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Stride
+{
+    /**
+     * @brief Ordering by fractional rank instead of array index.
+     *
+     * Every ranked item (cards, lists) stores a double `position`. Moving an item gives it the
+     * midpoint of its new neighbours, so a drag changes exactly one row. Repeated bisection of
+     * the same gap eventually runs out of precision; when that happens the whole sequence is
+     * re-spaced (Rebalance), which is the only operation that touches more than one item.
+     */
+    namespace FractionalRank
+    {
+        // Distance between neighbours when appending or rebalancing
+        constexpr double kSpacing = 1024.0;
+
+        // Below this gap the midpoint is no longer reliably distinct from its neighbours
+        constexpr double kMinGap = 1e-9;
+
+        inline double Between(double prev, double next) { return prev + (next - prev) * 0.5; }
+
+        inline bool HasRoomBetween(double prev, double next)
+        {
+            return std::abs(next - prev) > kMinGap * std::max(1.0, std::abs(prev));
+        }
+
+        /**
+         * @brief Re-space every item to kSpacing intervals, touching only items that changed.
+         */
+        template<typename T>
+        void Rebalance(std::vector<T>& items)
+        {
+            for(size_t i = 0; i < items.size(); ++i)
+            {
+                const double rank = static_cast<double>(i + 1) * kSpacing;
+                if(items[i].position != rank)
+                {
+                    items[i].position = rank;
+                    items[i].changes.Touch();
+                }
+            }
+        }
+
+        /**
+         * @brief Give items[index] a rank between its current neighbours.
+         * @return false if the gap was exhausted and the sequence had to be rebalanced
+         */
+        template<typename T>
+        bool Assign(std::vector<T>& items, size_t index)
+        {
+            if(index >= items.size())
+                return true;
+
+            const bool hasPrev = index > 0;
+            const bool hasNext = index + 1 < items.size();
+            const double prev = hasPrev ? items[index - 1].position : 0.0;
+            const double next = hasNext ? items[index + 1].position : 0.0;
+
+            double rank = 0.0;
+            if(hasPrev && hasNext)
+            {
+                if(!HasRoomBetween(prev, next) || prev >= next)
+                {
+                    Rebalance(items);
+                    return false;
+                }
+                rank = Between(prev, next);
+            }
+            else if(hasPrev)
+            {
+                rank = prev + kSpacing;
+            }
+            else if(hasNext)
+            {
+                rank = next - kSpacing;
+            }
+            else
+            {
+                rank = kSpacing;
+            }
+
+            if(items[index].position != rank)
+            {
+                items[index].position = rank;
+                items[index].changes.Touch();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Give items[first, first + count) evenly spaced ranks between their neighbours.
+         * @return false if the gap was too small for them and the sequence had to be rebalanced
+         */
+        template<typename T>
+        bool AssignRange(std::vector<T>& items, size_t first, size_t count)
+        {
+            if(count == 0 || first + count > items.size())
+                return true;
+
+            const bool hasPrev = first > 0;
+            const bool hasNext = first + count < items.size();
+            const double prev = hasPrev ? items[first - 1].position : 0.0;
+            const double next = hasNext ? items[first + count].position : 0.0;
+
+            double start = kSpacing;
+            double step = kSpacing;
+            if(hasPrev && hasNext)
+            {
+                step = (next - prev) / static_cast<double>(count + 1);
+                if(prev >= next || !HasRoomBetween(prev, prev + step))
+                {
+                    Rebalance(items);
+                    return false;
+                }
+                start = prev + step;
+            }
+            else if(hasPrev)
+            {
+                start = prev + kSpacing;
+            }
+            else if(hasNext)
+            {
+                start = next - kSpacing * static_cast<double>(count);
+            }
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                const double rank = start + step * static_cast<double>(i);
+                if(items[first + i].position != rank)
+                {
+                    items[first + i].position = rank;
+                    items[first + i].changes.Touch();
+                }
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace Stride
+{
+    void* FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        while(mBlockIndex < mBlocks.size())
+        {
+            Block& block = mBlocks[mBlockIndex];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uintptr_t aligned = (base + mOffset + alignment - 1) & ~(alignment - 1);
+            const size_t offset = static_cast<size_t>(aligned - base);
+            if(offset + size <= block.size)
+            {
+                mOffset = offset + size;
+                return block.data.get() + offset;
+            }
+
+            // Spilled over: move on to the next block, the remainder of this one stays unused
+            ++mBlockIndex;
+            mOffset = 0;
+        }
+
+        const size_t previous = mBlocks.empty() ? 0 : mBlocks.back().size;
+        Block block;
+        block.size = std::max({ kMinBlockSize, previous * 2, size + alignment });
+        block.data = std::make_unique<std::byte[]>(block.size);
+        mBlocks.push_back(std::move(block));
+        mBlockIndex = mBlocks.size() - 1;
+        mOffset = 0;
+        return Allocate(size, alignment);
+    }
+
+    void FrameArena::Reset()
+    {
+        // A frame that needed several blocks gets them as one from now on
+        if(mBlocks.size() > 1)
+        {
+            const size_t total = Capacity();
+            mBlocks.clear();
+            Block block;
+            block.size = total;
+            block.data = std::make_unique<std::byte[]>(total);
+            mBlocks.push_back(std::move(block));
+        }
+
+        mBlockIndex = 0;
+        mOffset = 0;
+        ++mGeneration;
+    }
+
+    size_t FrameArena::Used() const
+    {
+        size_t used = mOffset;
+        for(size_t i = 0; i < mBlockIndex && i < mBlocks.size(); ++i)
+        {
+            used += mBlocks[i].size;
+        }
+        return used;
+    }
+
+    size_t FrameArena::Capacity() const
+    {
+        size_t capacity = 0;
+        for(const Block& block : mBlocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Stride
+{
+    /**
+     * @brief Bump allocator for data that lives for one UI frame.
+     *
+     * Allocations advance an offset inside a block. Nothing is freed on its own: Reset(),
+     * called once per frame from Application::PreRender, rewinds to the start and bumps the
+     * generation. If the last frame spilled into extra blocks they are merged into one block
+     * that fits them all, so after the first few frames the arena stops touching the heap.
+     *
+     * Containers built on it (FrameVector) remember the generation they allocated in and read
+     * as empty once the arena was reset, so storage from an earlier frame is never used.
+     *
+     * @note Not thread-safe: Get() is the UI thread's arena.
+     */
+    class FrameArena
+    {
+      public:
+        static constexpr size_t kMinBlockSize = 64 * 1024;
+
+        static FrameArena& Get()
+        {
+            static FrameArena instance;
+            return instance;
+        }
+
+        void* Allocate(size_t size, size_t alignment);
+        void Reset();
+
+        uint64_t Generation() const { return mGeneration; }
+        size_t Used() const;
+        size_t Capacity() const;
+
+      private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+
+        std::vector<Block> mBlocks;
+        size_t mBlockIndex = 0;
+        size_t mOffset = 0;
+        uint64_t mGeneration = 1;
+    };
+
+    /**
+     * @brief Append-only array on the FrameArena, emptied by the arena's per-frame reset.
+     *
+     * Holds trivially copyable values only: growing copies them bytewise into a larger
+     * allocation and the old one is reclaimed with the rest of the frame.
+     */
+    template<typename T>
+    class FrameVector
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+
+      public:
+        explicit FrameVector(FrameArena& arena = FrameArena::Get()) : mArena(&arena) {}
+
+        void push_back(const T& value)
+        {
+            Sync();
+            if(mSize == mCapacity)
+                Grow();
+            new(mData + mSize) T(value);
+            ++mSize;
+        }
+
+        void clear()
+        {
+            Sync();
+            mSize = 0;
+        }
+
+        size_t size() const { return IsCurrent() ? mSize : 0; }
+        bool empty() const { return size() == 0; }
+
+        T* begin() { return IsCurrent() ? mData : nullptr; }
+        T* end() { return begin() + size(); }
+        const T* begin() const { return IsCurrent() ? mData : nullptr; }
+        const T* end() const { return begin() + size(); }
+
+        T& operator[](size_t index) { return mData[index]; }
+        const T& operator[](size_t index) const { return mData[index]; }
+
+      private:
+        FrameArena* mArena;
+        T* mData = nullptr;
+        size_t mSize = 0;
+        size_t mCapacity = 0;
+        uint64_t mGeneration = 0;
+
+        bool IsCurrent() const { return mGeneration == mArena->Generation(); }
+
+        // Drops storage handed out before the arena's last reset
+        void Sync()
+        {
+            if(IsCurrent())
+                return;
+            mData = nullptr;
+            mSize = 0;
+            mCapacity = 0;
+            mGeneration = mArena->Generation();
+        }
+
+        void Grow()
+        {
+            const size_t capacity = mCapacity > 0 ? mCapacity * 2 : 64;
+            T* data = static_cast<T*>(mArena->Allocate(capacity * sizeof(T), alignof(T)));
+            if(mSize > 0)
+                memcpy(static_cast<void*>(data), mData, mSize * sizeof(T));
+            mData = data;
+            mCapacity = capacity;
+        }
+    };
+}
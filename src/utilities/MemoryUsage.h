@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stride
+{
+    /**
+     * @brief Estimates of the heap memory owned by standard containers.
+     *
+     * Used for the board memory budget, where an estimate that tracks growth is enough: strings
+     * count their buffer once it leaves the small-string storage, vectors their capacity, and
+     * hash maps one node per element plus the bucket array. Allocator overhead is ignored.
+     */
+    namespace MemoryUsage
+    {
+        inline size_t HeapBytes(const std::string& text)
+        {
+            static const size_t kInlineCapacity = std::string().capacity();
+            return text.capacity() > kInlineCapacity ? text.capacity() + 1 : 0;
+        }
+
+        template<typename T>
+        size_t HeapBytes(const std::vector<T>& items)
+        {
+            return items.capacity() * sizeof(T);
+        }
+
+        template<typename K, typename V, typename H>
+        size_t HeapBytes(const std::unordered_map<K, V, H>& map)
+        {
+            using Node = std::pair<const K, V>;
+            return map.size() * (sizeof(Node) + sizeof(void*))
+                   + map.bucket_count() * sizeof(void*);
+        }
+
+        // Vector of strings: the array plus every string's own buffer
+        inline size_t HeapBytes(const std::vector<std::string>& items)
+        {
+            size_t bytes = items.capacity() * sizeof(std::string);
+            for(const auto& item : items)
+            {
+                bytes += HeapBytes(item);
+            }
+            return bytes;
+        }
+    }
+}
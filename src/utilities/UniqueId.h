@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace Stride
+{
+    /**
+     * @brief Fixed-size random identifier for widgets and other objects that are never persisted.
+     *
+     * Replaces genUID(), which seeded a fresh std::mt19937 from std::random_device and shuffled
+     * a shared static string on every call (slow, and a data race off the main thread).
+     *
+     * Each thread owns a xoshiro256** generator, seeded once from std::random_device mixed with
+     * a per-thread counter, so generating an ID takes a few nanoseconds, never locks and never
+     * allocates. The 64-bit value is rendered as 11 base-62 characters (62^11 > 2^64) into an
+     * inline buffer.
+     *
+     * Domain entities do not use this: they are keyed by EntityId handles.
+     *
+     * Usage:
+     * @code
+     * UniqueId id = UniqueId::Generate();
+     * ImGui::BeginChild((std::string("CardList_") + id.c_str()).c_str());
+     * @endcode
+     */
+    class UniqueId
+    {
+      public:
+        static constexpr size_t kLength = 11;
+
+        static UniqueId Generate() { return UniqueId(NextRandom()); }
+
+        // Next value of the calling thread's generator
+        static uint64_t NextRandom()
+        {
+            thread_local Xoshiro256 generator(ThreadSeed());
+            return generator.Next();
+        }
+
+        uint64_t Value() const { return mValue; }
+        const char* c_str() const { return mText.data(); }
+
+        bool operator==(const UniqueId& other) const { return mValue == other.mValue; }
+        bool operator!=(const UniqueId& other) const { return mValue != other.mValue; }
+
+      private:
+        uint64_t mValue = 0;
+        std::array<char, kLength + 1> mText{};
+
+        explicit UniqueId(uint64_t value) : mValue(value)
+        {
+            static constexpr char kAlphabet[]
+                = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+            for(size_t i = 0; i < kLength; ++i)
+            {
+                mText[i] = kAlphabet[value % 62];
+                value /= 62;
+            }
+            mText[kLength] = '\0';
+        }
+
+        static uint64_t SplitMix64(uint64_t& state)
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // Runs once per thread; the counter keeps threads apart even if random_device repeats
+        static uint64_t ThreadSeed()
+        {
+            static std::atomic<uint64_t> sThreadCount{ 0 };
+            std::random_device device;
+            uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+            seed ^= static_cast<uint64_t>(
+                std::chrono::steady_clock::now().time_since_epoch().count()
+            );
+            return seed + (++sThreadCount) * 0x9E3779B97F4A7C15ull;
+        }
+
+        struct Xoshiro256
+        {
+            uint64_t state[4];
+
+            explicit Xoshiro256(uint64_t seed)
+            {
+                for(auto& word : state)
+                {
+                    word = SplitMix64(seed);
+                }
+            }
+
+            static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+            uint64_t Next()
+            {
+                const uint64_t result = Rotl(state[1] * 5, 7) * 9;
+                const uint64_t t = state[1] << 17;
+                state[2] ^= state[0];
+                state[3] ^= state[1];
+                state[1] ^= state[2];
+                state[0] ^= state[3];
+                state[2] ^= t;
+                state[3] = Rotl(state[3], 45);
+                return result;
+            }
+        };
+    };
+}